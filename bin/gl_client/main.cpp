@@ -1,16 +1,20 @@
 #include <stdint.h>
 #include <chrono>
 #include <iostream>
+#include <string>
 
 #include <GLFW/glfw3.h>
 
+#include "lib/base/interfaces/from_archive.h"
 #include "lib/base/math/quat.h"
+#include "lib/base/profiling/profiler.h"
 #include "lib/base/reflection/type_db.h"
 #include "lib/bullet_physics/bullet_physics_system.h"
 #include "lib/bullet_physics/config.h"
 #include "lib/engine/components/gameplay/character_controller.h"
 #include "lib/engine/components/gameplay/input.h"
 #include "lib/engine/scene.h"
+#include "lib/engine/scene_file.h"
 #include "lib/engine/system_frame.h"
 #include "lib/engine/systems/animation_system.h"
 #include "lib/engine/systems/change_level_system.h"
@@ -19,6 +23,7 @@
 #include "lib/gl_render/gl_render_system.h"
 #include "lib/gl_window/gl_event_window.h"
 #include "lib/resource/archives/json_archive.h"
+#include "lib/resource/sources/pak_file.h"
 
 static void action_input_response(
     sge::EventChannel& action_event,
@@ -104,6 +109,22 @@ int main(int argc, char* argv[]) {
   assert(loaded_config);
   auto* config_reader = config.read_root();
 
+  // Mount the content archives listed in the config, with later archives taking priority over earlier ones
+  if (config_reader->pull_object_member("paks")) {
+    config_reader->enumerate_array_elements([config_reader](size_t /*i*/) {
+      std::string pak_path;
+      sge::from_archive(pak_path, *config_reader);
+      auto pak = sge::PakSource::open_file(pak_path.c_str());
+      if (!pak) {
+        std::cerr << "Could not open content archive '" << pak_path << "'" << std::endl;
+        return;
+      }
+
+      sge::mount_resource_source(std::move(pak));
+    });
+    config_reader->pop();
+  }
+
   // Initialize GLFW3
   if (!glfwInit()) {
     std::cerr << "Could not initialize GLFW3." << std::endl;
@@ -191,6 +212,12 @@ int main(int argc, char* argv[]) {
   sge::AnimationSystem anim_system;
   anim_system.register_pipeline(pipeline);
 
+  // Load the fixed timestep config
+  float fixed_timestep = pipeline.get_fixed_timestep();
+  if (config_reader->object_member("fixed_timestep", fixed_timestep)) {
+    pipeline.set_fixed_timestep(fixed_timestep);
+  }
+
   // Load the pipeline config
   if (config_reader->pull_object_member("update_pipeline")) {
     pipeline.configure_pipeline(*config_reader);
@@ -202,18 +229,29 @@ int main(int argc, char* argv[]) {
   // Load the scene
   std::string scene_path;
   if (config_reader->object_member("scene", scene_path)) {
-    sge::JsonArchive scene_archive;
-    scene_archive.from_file(scene_path.c_str());
-    scene_archive.deserialize_root(scene);
+    sge::load_scene_file(scene, scene_path.c_str());
   }
 
+  // Enable the profiler, if requested
+  bool profile = false;
+  std::string profile_trace_path;
+  config_reader->object_member("profile", profile);
+  config_reader->object_member("profile_trace_path", profile_trace_path);
+  sge::Profiler::global().set_enabled(profile);
+
   // Store the last time we printed out frame time
   auto last_printout = std::chrono::steady_clock::now();
+  auto last_frame = std::chrono::steady_clock::now();
 
   // Loop until the user closes the window
   while (!glfwWindowShouldClose(window)) {
     const auto start = std::chrono::high_resolution_clock::now();
-    scene.update(pipeline, 0.016);
+
+    // Advance the scene by however much time has actually passed (fixed-rate systems catch up on their own)
+    const auto frame_start = std::chrono::steady_clock::now();
+    const auto dt = std::chrono::duration<float>{frame_start - last_frame}.count();
+    last_frame = frame_start;
+    scene.update(pipeline, dt);
     const auto end = std::chrono::high_resolution_clock::now();
     const auto duration = std::chrono::duration<double, std::milli>{end - start}.count();
 
@@ -221,6 +259,12 @@ int main(int argc, char* argv[]) {
             .count() >= 1) {
       std::cout << "Scene update took " << duration << " milliseconds" << std::endl;
       last_printout = std::chrono::steady_clock::now();
+
+      // Print per-zone timings
+      sge::Profiler::global().enumerate_stats([](const sge::ProfileZoneStats& stats) {
+        std::cout << "    " << stats.name << ": min " << stats.min_ms << "ms, avg " << stats.avg_ms
+                  << "ms, p99 " << stats.p99_ms << "ms" << std::endl;
+      });
     }
 
     if (event_window.quit_requested()) {
@@ -239,14 +283,24 @@ int main(int argc, char* argv[]) {
       change_level_system.reset();
 
       // Load new scene
-      sge::JsonArchive scene_archive;
-      scene_archive.from_file(change_level_target.c_str());
-      scene_archive.deserialize_root(scene);
+      sge::load_scene_file(scene, change_level_target.c_str());
+
+      // Don't count the load time against the next frame
+      last_frame = std::chrono::steady_clock::now();
     }
 
     glfwSwapBuffers(window);
     glfwPollEvents();
   }
 
+  // Export the profiler trace
+  if (profile && !profile_trace_path.empty()) {
+    sge::JsonArchive trace_archive;
+    auto* const trace_writer = trace_archive.write_root();
+    sge::Profiler::global().trace_to_archive(*trace_writer);
+    trace_writer->pop();
+    trace_archive.to_file(profile_trace_path.c_str());
+  }
+
   glfwTerminate();
 }
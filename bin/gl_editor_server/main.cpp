@@ -12,6 +12,7 @@
 #include "lib/engine/components/display/spot_light.h"
 #include "lib/engine/components/display/static_mesh.h"
 #include "lib/engine/scene.h"
+#include "lib/engine/scene_file.h"
 #include "lib/engine/update_pipeline.h"
 #include "lib/gl_render/config.h"
 #include "lib/gl_render/gl_render_system.h"
@@ -114,9 +115,7 @@ int main(int argc, char* argv[]) {
   // Load the scene
   std::string scene_path;
   if (config_reader->object_member("scene", scene_path)) {
-    sge::JsonArchive scene_archive;
-    scene_archive.from_file(scene_path.c_str());
-    scene_archive.deserialize_root(scene);
+    sge::load_scene_file(scene, scene_path.c_str());
   }
 
   // Loop until the user closes the window
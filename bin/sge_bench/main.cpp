@@ -0,0 +1,345 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "lib/base/interfaces/to_archive.h"
+#include "lib/base/profiling/profiler.h"
+#include "lib/base/reflection/type_db.h"
+#include "lib/bullet_physics/bullet_physics_system.h"
+#include "lib/bullet_physics/config.h"
+#include "lib/engine/scene.h"
+#include "lib/engine/scene_file.h"
+#include "lib/engine/system_frame.h"
+#include "lib/engine/systems/animation_system.h"
+#include "lib/engine/update_pipeline.h"
+#include "lib/resource/archives/json_archive.h"
+#include "lib/scene_gen/scene_gen.h"
+
+/* Allocation counters, maintained by the global allocation functions below. */
+static std::atomic<uint64_t> num_allocations{0};
+static std::atomic<uint64_t> num_allocated_bytes{0};
+
+void* operator new(size_t size) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  num_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+  void* const buff = ::malloc(size != 0 ? size : 1);
+  if (!buff) {
+    throw std::bad_alloc{};
+  }
+
+  return buff;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* buff) noexcept {
+  ::free(buff);
+}
+
+void operator delete[](void* buff) noexcept {
+  ::free(buff);
+}
+
+void operator delete(void* buff, size_t /*size*/) noexcept {
+  ::free(buff);
+}
+
+void operator delete[](void* buff, size_t /*size*/) noexcept {
+  ::free(buff);
+}
+
+struct AllocationCounts {
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+
+  static AllocationCounts now() {
+    AllocationCounts result;
+    result.count = num_allocations.load(std::memory_order_relaxed);
+    result.bytes = num_allocated_bytes.load(std::memory_order_relaxed);
+    return result;
+  }
+
+  friend AllocationCounts operator-(const AllocationCounts& lhs, const AllocationCounts& rhs) {
+    AllocationCounts result;
+    result.count = lhs.count - rhs.count;
+    result.bytes = lhs.bytes - rhs.bytes;
+    return result;
+  }
+};
+
+struct BenchOptions {
+  const char* scene_path = nullptr;
+  const char* out_path = nullptr;
+  const char* gen_config_path = nullptr;
+  uint32_t synthetic_nodes = 1000;
+  uint32_t spawns_per_frame = 0;
+  uint32_t despawns_per_frame = 0;
+  uint32_t num_frames = 600;
+  uint32_t num_warmup_frames = 60;
+  float time_delta = 1.f / 60.f;
+};
+
+static void print_usage() {
+  std::cerr << "Usage: sge_bench [--scene <path.json|path.sbin> | --synthetic <num_nodes>] "
+               "[--gen-config <path.json>] [--spawns <n>] [--despawns <n>] [--frames <n>] [--warmup <n>] "
+               "[--dt <seconds>] [--out <path.json>]"
+            << std::endl;
+}
+
+static bool parse_options(int argc, char* argv[], BenchOptions& out_options) {
+  for (int i = 1; i < argc; ++i) {
+    const char* const arg = argv[i];
+    const char* const value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!value) {
+      return false;
+    }
+
+    if (strcmp(arg, "--scene") == 0) {
+      out_options.scene_path = value;
+    } else if (strcmp(arg, "--synthetic") == 0) {
+      out_options.synthetic_nodes = (uint32_t)strtoul(value, nullptr, 10);
+    } else if (strcmp(arg, "--gen-config") == 0) {
+      out_options.gen_config_path = value;
+    } else if (strcmp(arg, "--spawns") == 0) {
+      out_options.spawns_per_frame = (uint32_t)strtoul(value, nullptr, 10);
+    } else if (strcmp(arg, "--despawns") == 0) {
+      out_options.despawns_per_frame = (uint32_t)strtoul(value, nullptr, 10);
+    } else if (strcmp(arg, "--frames") == 0) {
+      out_options.num_frames = (uint32_t)strtoul(value, nullptr, 10);
+    } else if (strcmp(arg, "--warmup") == 0) {
+      out_options.num_warmup_frames = (uint32_t)strtoul(value, nullptr, 10);
+    } else if (strcmp(arg, "--dt") == 0) {
+      out_options.time_delta = strtof(value, nullptr);
+    } else if (strcmp(arg, "--out") == 0) {
+      out_options.out_path = value;
+    } else {
+      return false;
+    }
+
+    i += 1;
+  }
+
+  return true;
+}
+
+static void frame_times_to_archive(std::vector<float> frame_times_ms, sge::ArchiveWriter& writer) {
+  writer.as_object();
+  if (frame_times_ms.empty()) {
+    return;
+  }
+
+  std::sort(frame_times_ms.begin(), frame_times_ms.end());
+  float total = 0.f;
+  for (const auto time : frame_times_ms) {
+    total += time;
+  }
+
+  const auto count = frame_times_ms.size();
+  writer.object_member("min_ms", frame_times_ms.front());
+  writer.object_member("avg_ms", total / count);
+  writer.object_member("p50_ms", frame_times_ms[count / 2]);
+  writer.object_member("p99_ms", frame_times_ms[std::min(count - 1, (size_t)(count * 0.99))]);
+  writer.object_member("max_ms", frame_times_ms.back());
+}
+
+static void allocations_to_archive(
+    const AllocationCounts& counts, uint32_t num_frames, sge::ArchiveWriter& writer
+) {
+  writer.object_member("count", counts.count);
+  writer.object_member("bytes", counts.bytes);
+
+  if (num_frames != 0) {
+    writer.object_member("count_per_frame", (double)counts.count / num_frames);
+    writer.object_member("bytes_per_frame", (double)counts.bytes / num_frames);
+  }
+}
+
+/* Total number of events appended to each event channel of the scene, by channel name. */
+using EventCounts = std::vector<std::pair<std::string, uint64_t>>;
+
+static EventCounts count_events(sge::Scene& scene) {
+  EventCounts counts;
+  counts.emplace_back("node.new", scene.get_raw_scene_data().new_node_channel.num_appended());
+  counts.emplace_back("node.destroyed", scene.get_raw_scene_data().destroyed_node_channel.num_appended());
+  counts.emplace_back("node.root_changed", scene.get_node_root_changed_channel()->num_appended());
+  counts.emplace_back(
+      "node.local_transform_changed", scene.get_node_local_transform_changed_channel()->num_appended()
+  );
+  counts.emplace_back(
+      "node.world_transform_changed", scene.get_node_world_transform_changed_channel()->num_appended()
+  );
+
+  const char* const component_channels[] = {"new", "destroy", "prop_mod"};
+  for (const auto& component_type : scene.get_raw_scene_data().components) {
+    for (const auto* const channel_name : component_channels) {
+      auto* const channel = component_type.second->get_event_channel(channel_name);
+      if (!channel) {
+        continue;
+      }
+
+      counts.emplace_back(component_type.first->name() + "." + channel_name, channel->num_appended());
+    }
+  }
+
+  return counts;
+}
+
+static void event_counts_to_archive(
+    const EventCounts& start_counts, const EventCounts& end_counts, sge::ArchiveWriter& writer
+) {
+  // The scene's component types don't change while it's running, so both have the same channels
+  writer.as_object();
+  for (size_t i = 0; i < end_counts.size() && i < start_counts.size(); ++i) {
+    writer.object_member(end_counts[i].first.c_str(), end_counts[i].second - start_counts[i].second);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  BenchOptions options;
+  if (!parse_options(argc, argv, options)) {
+    print_usage();
+    return EXIT_FAILURE;
+  }
+
+  // Create a type database
+  sge::TypeDB type_db;
+  type_db.new_type<sge::Vec3>();
+  type_db.new_type<sge::Quat>();
+  type_db.new_type<float>();
+
+  // Create a scene
+  sge::Scene scene{type_db};
+  sge::register_builtin_components(scene);
+
+  // Create the pipeline and systems
+  sge::UpdatePipeline pipeline;
+  sge::bullet_physics::Config physics_config;
+  sge::bullet_physics::BulletPhysicsSystem physics_system{physics_config};
+  physics_system.register_pipeline(pipeline);
+  physics_system.initialize_subscriptions(scene);
+
+  sge::AnimationSystem anim_system;
+  anim_system.register_pipeline(pipeline);
+
+  // Load the synthetic scene config (churn applies to loaded scenes as well)
+  sge::scene_gen::Config gen_config;
+  if (options.gen_config_path) {
+    sge::JsonArchive gen_config_archive;
+    if (!gen_config_archive.from_file(options.gen_config_path)) {
+      std::cerr << "Could not load generator config '" << options.gen_config_path << "'" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    gen_config_archive.deserialize_root(gen_config);
+  } else {
+    gen_config.num_nodes = options.synthetic_nodes;
+  }
+  if (options.spawns_per_frame != 0 || options.despawns_per_frame != 0) {
+    gen_config.spawns_per_frame = options.spawns_per_frame;
+    gen_config.despawns_per_frame = options.despawns_per_frame;
+  }
+
+  sge::scene_gen::ChurnSystem churn_system{gen_config};
+  churn_system.register_pipeline(pipeline);
+
+  sge::JsonArchive pipeline_config;
+  pipeline_config.from_string(
+      R"(["scene_gen_churn", "animation_update", "animation_apply", "bullet_physics"])"
+  );
+  auto* const pipeline_reader = pipeline_config.read_root();
+  pipeline.configure_pipeline(*pipeline_reader);
+  pipeline_reader->pop();
+
+  // Load the scene
+  sge::Profiler::global().set_enabled(true);
+  const auto load_allocs_start = AllocationCounts::now();
+  const auto load_start = std::chrono::steady_clock::now();
+  if (options.scene_path) {
+    if (!sge::load_scene_file(scene, options.scene_path)) {
+      std::cerr << "Could not load scene '" << options.scene_path << "'" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } else {
+    sge::scene_gen::generate_scene(scene, gen_config);
+  }
+  const auto load_time_ms =
+      std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - load_start}.count();
+  const auto load_allocs = AllocationCounts::now() - load_allocs_start;
+
+  // Warm up, then reset the profiler so we only measure steady-state frames
+  for (uint32_t i = 0; i < options.num_warmup_frames; ++i) {
+    scene.update(pipeline, options.time_delta);
+  }
+  sge::Profiler::global().clear();
+
+  // Keep every zone sample from the measured frames, so the statistics cover the whole run
+  sge::Profiler::global().set_history_size(0);
+
+  // Run the measured frames
+  std::vector<float> frame_times_ms;
+  frame_times_ms.reserve(options.num_frames);
+  const auto frame_events_start = count_events(scene);
+  const auto frame_allocs_start = AllocationCounts::now();
+  for (uint32_t i = 0; i < options.num_frames; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    scene.update(pipeline, options.time_delta);
+    const auto end = std::chrono::steady_clock::now();
+    frame_times_ms.push_back(std::chrono::duration<float, std::milli>{end - start}.count());
+  }
+  const auto frame_allocs = AllocationCounts::now() - frame_allocs_start;
+  const auto frame_events = count_events(scene);
+
+  // Write the report
+  sge::JsonArchive report;
+  auto* const writer = report.write_root();
+  writer->object_member("scene", std::string{options.scene_path ? options.scene_path : "synthetic"});
+  writer->object_member("num_nodes", (uint64_t)scene.get_raw_scene_data().nodes.size());
+  writer->object_member("frames", options.num_frames);
+  writer->object_member("warmup_frames", options.num_warmup_frames);
+  writer->object_member("dt", options.time_delta);
+  writer->object_member("load_time_ms", load_time_ms);
+
+  writer->push_object_member("frame_time");
+  frame_times_to_archive(std::move(frame_times_ms), *writer);
+  writer->pop();
+
+  writer->push_object_member("zones");
+  sge::Profiler::global().stats_to_archive(*writer);
+  writer->pop();
+
+  writer->push_object_member("allocations");
+  writer->push_object_member("load");
+  allocations_to_archive(load_allocs, 0, *writer);
+  writer->pop();
+  writer->push_object_member("frames");
+  allocations_to_archive(frame_allocs, options.num_frames, *writer);
+  writer->pop();
+  writer->pop();  // "allocations"
+
+  writer->push_object_member("event_channels");
+  event_counts_to_archive(frame_events_start, frame_events, *writer);
+  writer->pop();
+  writer->pop();
+
+  if (options.out_path) {
+    if (!report.to_file(options.out_path)) {
+      std::cerr << "Could not write report to '" << options.out_path << "'" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } else {
+    std::cout << report.to_string() << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
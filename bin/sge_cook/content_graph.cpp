@@ -0,0 +1,279 @@
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+#include "bin/sge_cook/content_graph.h"
+#include "lib/base/concurrency/task_pool.h"
+#include "lib/base/interfaces/from_archive.h"
+#include "lib/base/util/hash_utils.h"
+#include "lib/base/util/string_utils.h"
+#include "lib/resource/archives/binary_archive.h"
+#include "lib/resource/archives/json_archive.h"
+#include "lib/resource/resources/static_mesh.h"
+
+namespace sge {
+namespace cook {
+/* Size of the chunks files are hashed in. This must be a multiple of the word size 'hash_bytes' works on. */
+static constexpr size_t HASH_CHUNK_SIZE = 1 << 20;
+
+/* Extensions of files that may be referenced by other assets. */
+static const char* const REFERENCE_EXTENSIONS[] = {".json", ".sbin", ".qoi", ".exr", ".vert", ".frag"};
+
+const char* asset_type_name(AssetType type) {
+  switch (type) {
+    case AssetType::SCENE:
+      return "scene";
+    case AssetType::MATERIAL:
+      return "material";
+    case AssetType::STATIC_MESH:
+      return "static mesh";
+    case AssetType::TEXTURE:
+      return "texture";
+    case AssetType::SHADER:
+      return "shader";
+    case AssetType::OTHER:
+      break;
+  }
+
+  return "other";
+}
+
+std::string cooked_scene_path(const std::string& scene_path) {
+  return scene_path.substr(0, scene_path.size() - strlen(".json")) + ".sbin";
+}
+
+static bool is_reference(const std::string& value) {
+  for (const auto* const ext : REFERENCE_EXTENSIONS) {
+    if (string_ends_with(value, ext)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool hash_file(const std::string& path, uint64_t& out_hash) {
+  auto* const file = fopen(path.c_str(), "rb");
+  if (!file) {
+    return false;
+  }
+
+  std::vector<uint8_t> chunk(HASH_CHUNK_SIZE);
+  out_hash = HASH_BYTES_SEED;
+  size_t read_size;
+  while ((read_size = fread(chunk.data(), 1, chunk.size(), file)) > 0) {
+    out_hash = hash_bytes(out_hash, chunk.data(), read_size);
+  }
+
+  fclose(file);
+  return true;
+}
+
+/* Collects every string in the current node and its children that looks like a reference to a file. */
+static void collect_references(ArchiveReader& reader, std::vector<std::string>& out_references) {
+  if (reader.is_string()) {
+    std::string value;
+    sge::from_archive(value, reader);
+    if (is_reference(value)) {
+      out_references.push_back(std::move(value));
+    }
+  } else if (reader.is_object()) {
+    reader.enumerate_object_members([&reader, &out_references](const char* /*name*/) {
+      collect_references(reader, out_references);
+    });
+  } else if (reader.is_array()) {
+    reader.enumerate_array_elements([&reader, &out_references](size_t /*i*/) {
+      collect_references(reader, out_references);
+    });
+  }
+}
+
+static void classify_json(Asset& asset, std::vector<std::string>& out_references) {
+  auto* const reader = JsonArchive::read_file_streaming(asset.file_path.c_str(), true);
+  if (!reader) {
+    return;
+  }
+
+  // Scenes and materials are told apart by their members, and every other JSON file is only checked for
+  // references
+  if (reader->is_object()) {
+    reader->enumerate_object_members([&asset, reader, &out_references](const char* name) {
+      if (strcmp(name, "next_node_id") == 0) {
+        asset.type = AssetType::SCENE;
+      } else if (strcmp(name, "vertex_shader") == 0) {
+        asset.type = AssetType::MATERIAL;
+      }
+
+      collect_references(*reader, out_references);
+    });
+  }
+
+  reader->pop();
+}
+
+static void classify_binary(Asset& asset, std::vector<std::string>& out_references) {
+  auto* const reader = BinaryArchive::read_mapped_file(asset.file_path.c_str());
+  if (!reader) {
+    return;
+  }
+
+  bool is_mesh = false;
+  if (reader->pull_object_member("vpos")) {
+    is_mesh = true;
+    reader->pop();
+  } else if (reader->pull_object_member("next_node_id")) {
+    asset.type = AssetType::SCENE;
+    reader->pop();
+  }
+  reader->pop();
+
+  // Meshes reference the materials used by each of their sections
+  StaticMesh mesh;
+  if (is_mesh && mesh.from_file(asset.file_path.c_str())) {
+    asset.type = AssetType::STATIC_MESH;
+    for (size_t i = 0; i < mesh.num_materials(); ++i) {
+      out_references.push_back(mesh.materials()[i].path());
+    }
+  }
+}
+
+static void classify(Asset& asset, std::vector<std::string>& out_references) {
+  if (string_ends_with(asset.path, ".json")) {
+    classify_json(asset, out_references);
+  } else if (string_ends_with(asset.path, ".sbin")) {
+    classify_binary(asset, out_references);
+  } else if (string_ends_with(asset.path, ".qoi") || string_ends_with(asset.path, ".exr")) {
+    asset.type = AssetType::TEXTURE;
+  } else if (string_ends_with(asset.path, ".vert") || string_ends_with(asset.path, ".frag")) {
+    asset.type = AssetType::SHADER;
+  }
+}
+
+bool scan_content(const std::string& content_dir, ContentGraph& out_graph) {
+  out_graph.assets.clear();
+  out_graph.asset_indices.clear();
+
+  // Asset paths are relative to the content directory's parent, however the content directory was given
+  std::error_code error;
+  const auto content_path = std::filesystem::canonical(content_dir, error);
+  if (error) {
+    std::cerr << "Could not find '" << content_dir << "': " << error.message() << std::endl;
+    return false;
+  }
+  const auto root_path = content_path.parent_path();
+  out_graph.root_dir = root_path.generic_string();
+
+  // Find every file
+  std::vector<Asset> assets;
+  for (std::filesystem::recursive_directory_iterator iter{content_path, error}, end; !error && iter != end;
+       iter.increment(error)) {
+    if (!iter->is_regular_file()) {
+      continue;
+    }
+
+    assets.emplace_back();
+    assets.back().path = iter->path().lexically_relative(root_path).generic_string();
+    assets.back().file_path = iter->path().generic_string();
+  }
+
+  if (error) {
+    std::cerr << "Could not scan '" << content_dir << "': " << error.message() << std::endl;
+    return false;
+  }
+
+  // Hash and classify them, which involves reading each one
+  std::vector<std::vector<std::string>> references(assets.size());
+  TaskPool::global().parallel_for(assets.size(), [&assets, &references](size_t i) {
+    if (!hash_file(assets[i].file_path, assets[i].content_hash)) {
+      std::cerr << "WARNING: Could not read '" << assets[i].path << "'" << std::endl;
+    }
+
+    classify(assets[i], references[i]);
+  });
+
+  // Cooked output is written outside of the content directory, so every file found is an asset
+  for (size_t i = 0; i < assets.size(); ++i) {
+    out_graph.asset_indices.insert(std::make_pair(assets[i].path, i));
+  }
+  out_graph.assets = std::move(assets);
+
+  // Resolve references
+  for (size_t i = 0; i < out_graph.assets.size(); ++i) {
+    auto& asset = out_graph.assets[i];
+    for (auto& reference : references[i]) {
+      const auto iter = out_graph.asset_indices.find(reference);
+      if (iter == out_graph.asset_indices.end()) {
+        asset.missing_dependencies.push_back(std::move(reference));
+      } else if (std::find(asset.dependencies.begin(), asset.dependencies.end(), iter->second) ==
+                 asset.dependencies.end()) {
+        asset.dependencies.push_back(iter->second);
+      }
+    }
+  }
+
+  return true;
+}
+
+static void visit_dependencies(
+    const ContentGraph& graph,
+    size_t index,
+    std::vector<bool>& visited,
+    std::vector<size_t>& out_order
+) {
+  visited[index] = true;
+  for (const auto dependency : graph.assets[index].dependencies) {
+    if (!visited[dependency]) {
+      visit_dependencies(graph, dependency, visited, out_order);
+    }
+  }
+
+  out_order.push_back(index);
+}
+
+uint64_t dependency_hash(const ContentGraph& graph, size_t index) {
+  // Find everything the asset references, following reference cycles only once
+  std::vector<bool> visited(graph.assets.size(), false);
+  std::vector<size_t> stack{index};
+  std::vector<size_t> dependencies;
+  visited[index] = true;
+  while (!stack.empty()) {
+    const auto current = stack.back();
+    stack.pop_back();
+    for (const auto dependency : graph.assets[current].dependencies) {
+      if (!visited[dependency]) {
+        visited[dependency] = true;
+        stack.push_back(dependency);
+        dependencies.push_back(dependency);
+      }
+    }
+  }
+
+  // Hash them in order of path, since the order assets are found in isn't stable
+  std::sort(dependencies.begin(), dependencies.end(), [&graph](size_t lhs, size_t rhs) {
+    return graph.assets[lhs].path < graph.assets[rhs].path;
+  });
+
+  auto hash = hash_bytes(HASH_BYTES_SEED, &graph.assets[index].content_hash, sizeof(uint64_t));
+  for (const auto dependency : dependencies) {
+    hash = hash_bytes(hash, &graph.assets[dependency].content_hash, sizeof(uint64_t));
+  }
+
+  return hash;
+}
+
+std::vector<size_t> dependency_order(const ContentGraph& graph) {
+  std::vector<bool> visited(graph.assets.size(), false);
+  std::vector<size_t> order;
+  order.reserve(graph.assets.size());
+  for (size_t i = 0; i < graph.assets.size(); ++i) {
+    if (!visited[i]) {
+      visit_dependencies(graph, i, visited, order);
+    }
+  }
+
+  return order;
+}
+}  // namespace cook
+}  // namespace sge
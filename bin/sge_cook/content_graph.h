@@ -0,0 +1,90 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sge {
+namespace cook {
+enum class AssetType {
+  SCENE,
+  MATERIAL,
+  STATIC_MESH,
+  TEXTURE,
+  SHADER,
+  OTHER,
+};
+
+/**
+ * \brief A file in the content directory.
+ */
+struct Asset {
+  /* Path of the file relative to the graph's root directory, which is the form that other assets and configs
+   * reference it by. */
+  std::string path;
+
+  /* Path of the file on disk. */
+  std::string file_path;
+
+  AssetType type = AssetType::OTHER;
+
+  /* Hash of the file's contents. */
+  uint64_t content_hash = 0;
+
+  /* Assets referenced by this asset, as indices into the graph. */
+  std::vector<size_t> dependencies;
+
+  /* Paths referenced by this asset that aren't in the content directory. */
+  std::vector<std::string> missing_dependencies;
+};
+
+/**
+ * \brief Every asset in the content directory, and the references between them.
+ */
+struct ContentGraph {
+  /* Directory that asset paths are relative to, which is the one containing the content directory. */
+  std::string root_dir;
+
+  std::vector<Asset> assets;
+  std::unordered_map<std::string, size_t> asset_indices;
+};
+
+const char* asset_type_name(AssetType type);
+
+/**
+ * \brief Hashes the contents of the file at the given path.
+ * \return Whether the file could be read.
+ */
+bool hash_file(const std::string& path, uint64_t& out_hash);
+
+/**
+ * \brief Returns the path that the given JSON scene's cooked binary scene is stored under, which is the same
+ * path with the extension replaced.
+ */
+std::string cooked_scene_path(const std::string& scene_path);
+
+/**
+ * \brief Scans the given directory for assets, hashing and classifying each in parallel, and resolves the
+ * references between them. Asset paths are made relative to the directory containing the content directory,
+ * regardless of how it's given, so that they match the references.
+ * \param content_dir The content directory to scan.
+ * \param out_graph The graph to fill in. Its existing contents are replaced.
+ * \return Whether the directory could be scanned.
+ */
+bool scan_content(const std::string& content_dir, ContentGraph& out_graph);
+
+/**
+ * \brief Returns a hash of the given asset's contents along with those of every asset it references, directly
+ * or indirectly, which changes whenever anything its cooked output may depend on does.
+ */
+uint64_t dependency_hash(const ContentGraph& graph, size_t index);
+
+/**
+ * \brief Returns the indices of every asset in the graph, with each asset ordered after the assets it
+ * references. Reference cycles are broken arbitrarily.
+ */
+std::vector<size_t> dependency_order(const ContentGraph& graph);
+}  // namespace cook
+}  // namespace sge
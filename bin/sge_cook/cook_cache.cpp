@@ -0,0 +1,62 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bin/sge_cook/cook_cache.h"
+#include "lib/base/interfaces/from_archive.h"
+#include "lib/base/interfaces/to_archive.h"
+#include "lib/resource/archives/json_archive.h"
+
+namespace sge {
+namespace cook {
+/* Incremented whenever the cook's output changes, so that everything is cooked again. */
+static constexpr uint32_t COOK_VERSION = 4;
+
+void CookCache::load(const std::string& path) {
+  dependency_hashes.clear();
+
+  JsonArchive archive;
+  if (!archive.from_file(path.c_str())) {
+    return;
+  }
+
+  auto* const reader = archive.read_root();
+  uint32_t version = 0;
+  if (reader->object_member("version", version) && version == COOK_VERSION &&
+      reader->pull_object_member("dependency_hashes")) {
+    // Hashes are stored as hex strings, since they don't fit in a double
+    reader->enumerate_object_members([this, reader](const char* asset_path) {
+      std::string hash;
+      sge::from_archive(hash, *reader);
+      dependency_hashes[asset_path] = strtoull(hash.c_str(), nullptr, 16);
+    });
+    reader->pop();
+  }
+
+  reader->pop();
+}
+
+bool CookCache::save(const std::string& path) const {
+  JsonArchive archive;
+  auto* const writer = archive.write_root();
+  writer->object_member("version", COOK_VERSION);
+
+  writer->push_object_member("dependency_hashes");
+  writer->as_object();
+  for (const auto& entry : dependency_hashes) {
+    char hash[17];
+    snprintf(hash, sizeof(hash), "%016" PRIx64, entry.second);
+    writer->object_member(entry.first.c_str(), std::string{hash});
+  }
+  writer->pop();
+
+  writer->pop();
+  return archive.to_file(path.c_str());
+}
+
+bool CookCache::is_up_to_date(const std::string& asset_path, uint64_t dependency_hash) const {
+  const auto iter = dependency_hashes.find(asset_path);
+  return iter != dependency_hashes.end() && iter->second == dependency_hash;
+}
+}  // namespace cook
+}  // namespace sge
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+
+namespace sge {
+namespace cook {
+/* Name of the cache file, which is kept at the root of the cook's output directory. */
+static constexpr char COOK_CACHE_FILE_NAME[] = ".sge_cook_cache.json";
+
+/**
+ * \brief The dependency hash of each asset as of the last time it was cooked successfully, so that assets may
+ * be skipped if neither they nor anything they reference have changed.
+ */
+struct CookCache {
+  /**
+   * \brief Loads the cache from the given file. A missing cache, or one written by a different version of the
+   * cook, leaves this empty, so that everything is cooked again.
+   */
+  void load(const std::string& path);
+
+  /**
+   * \brief Saves the cache to the given file.
+   * \return Whether the file was written.
+   */
+  bool save(const std::string& path) const;
+
+  /**
+   * \brief Returns whether the given asset was last cooked with the given dependency hash.
+   */
+  bool is_up_to_date(const std::string& asset_path, uint64_t dependency_hash) const;
+
+  std::unordered_map<std::string, uint64_t> dependency_hashes;
+};
+}  // namespace cook
+}  // namespace sge
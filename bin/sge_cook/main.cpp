@@ -0,0 +1,234 @@
+#include <stdlib.h>
+#include <string.h>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#include "bin/sge_cook/content_graph.h"
+#include "bin/sge_cook/cook_cache.h"
+#include "lib/base/concurrency/task_pool.h"
+#include "lib/base/reflection/type_db.h"
+#include "lib/base/util/string_utils.h"
+#include "lib/bullet_physics/cook.h"
+#include "lib/engine/scene.h"
+#include "lib/engine/scene_file.h"
+#include "lib/resource/archives/binary_archive.h"
+#include "lib/resource/misc/mesh_clusters.h"
+#include "lib/resource/misc/mesh_optimizer.h"
+#include "lib/resource/misc/mesh_simplifier.h"
+#include "lib/resource/resources/static_mesh.h"
+#include "lib/resource/sources/pak_file.h"
+
+/* Something to be written for an asset. */
+struct CookJob {
+  size_t asset;
+  std::string output_path;
+  bool succeeded = false;
+
+  /* Hash of the asset and everything it references, which is recorded in the cook cache once cooked. */
+  uint64_t dependency_hash = 0;
+  sge::mesh_optimizer::Stats mesh_stats{};
+  size_t num_mesh_lods = 0;
+  size_t num_mesh_clusters = 0;
+};
+
+static void print_usage() {
+  std::cerr << "Usage: sge_cook [--content <dir>] [--output <dir>] [--force] [--pak <path>]" << std::endl;
+}
+
+/* Returns the file that cooked output stored under the given path is written to, which mirrors that path
+ * under the output directory. */
+static std::string cooked_output_path(const std::string& output_dir, const std::string& path) {
+  return output_dir + "/" + path;
+}
+
+static bool create_parent_directories(const std::string& path) {
+  std::error_code error;
+  std::filesystem::create_directories(std::filesystem::path{path}.parent_path(), error);
+  return !error;
+}
+
+/* Optimizes a copy of the mesh and generates its clusters and LODs, and then builds its collider BVH next to
+ * the copy. The original mesh is left as is. */
+static bool cook_static_mesh(const sge::cook::Asset& asset, CookJob& job) {
+  sge::StaticMesh mesh;
+  if (!mesh.from_file(asset.file_path.c_str()) ||
+      !sge::mesh_optimizer::optimize_static_mesh(mesh, job.mesh_stats) ||
+      !sge::mesh_clusters::build_static_mesh_clusters(mesh) ||
+      !sge::mesh_simplifier::generate_static_mesh_lods(mesh)) {
+    return false;
+  }
+  job.num_mesh_lods = mesh.num_lods();
+  job.num_mesh_clusters = mesh.num_clusters();
+
+  // Clustering reorders the triangles again
+  job.mesh_stats.acmr_after = sge::mesh_optimizer::compute_acmr(
+      mesh.triangle_elements(),
+      mesh.num_triangle_elements(),
+      mesh.num_verts(),
+      sge::mesh_optimizer::VERTEX_CACHE_SIZE
+  );
+
+  if (!create_parent_directories(job.output_path)) {
+    return false;
+  }
+
+  const bool written = sge::BinaryArchive::write_file(
+      job.output_path.c_str(), [&mesh](sge::ArchiveWriter& writer) { mesh.to_archive(writer); }
+  );
+  return written && sge::bullet_physics::cook_static_mesh_bvh(job.output_path.c_str());
+}
+
+static bool cook_scene(const sge::cook::Asset& asset, const std::string& output_path) {
+  sge::TypeDB type_db;
+  type_db.new_type<sge::Vec3>();
+  type_db.new_type<sge::Quat>();
+  type_db.new_type<float>();
+  sge::Scene scene{type_db};
+  sge::register_builtin_components(scene);
+
+  return sge::load_scene_file(scene, asset.file_path.c_str()) && create_parent_directories(output_path) &&
+         sge::save_scene_file(scene, output_path.c_str());
+}
+
+int main(int argc, char* argv[]) {
+  std::string content_dir = "Content";
+  std::string output_dir = "Cooked";
+  std::string pak_path;
+  bool force = false;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--content") == 0 && i + 1 < argc) {
+      content_dir = argv[++i];
+    } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+      output_dir = argv[++i];
+    } else if (strcmp(argv[i], "--force") == 0) {
+      force = true;
+    } else if (strcmp(argv[i], "--pak") == 0 && i + 1 < argc) {
+      pak_path = argv[++i];
+    } else {
+      print_usage();
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Find every asset, and what it references
+  sge::cook::ContentGraph graph;
+  if (!sge::cook::scan_content(content_dir, graph)) {
+    return EXIT_FAILURE;
+  }
+
+  for (const auto& asset : graph.assets) {
+    for (const auto& missing : asset.missing_dependencies) {
+      std::cerr << "WARNING: " << sge::cook::asset_type_name(asset.type) << " '" << asset.path
+                << "' references missing file '" << missing << "'" << std::endl;
+    }
+  }
+
+  const auto cache_path = cooked_output_path(output_dir, sge::cook::COOK_CACHE_FILE_NAME);
+  sge::cook::CookCache cache;
+  if (!force) {
+    cache.load(cache_path);
+  }
+
+  // Figure out what needs to be cooked, skipping assets that haven't changed since they were last cooked
+  std::vector<CookJob> mesh_jobs;
+  std::vector<CookJob> scene_jobs;
+  sge::cook::CookCache new_cache;
+  size_t num_up_to_date = 0;
+  for (const auto index : sge::cook::dependency_order(graph)) {
+    const auto& asset = graph.assets[index];
+    std::string output_path;
+    std::vector<CookJob>* jobs = nullptr;
+    if (asset.type == sge::cook::AssetType::STATIC_MESH) {
+      output_path = cooked_output_path(output_dir, asset.path);
+      jobs = &mesh_jobs;
+    } else if (asset.type == sge::cook::AssetType::SCENE && sge::string_ends_with(asset.path, ".json")) {
+      output_path = cooked_output_path(output_dir, sge::cook::cooked_scene_path(asset.path));
+      jobs = &scene_jobs;
+    } else {
+      continue;
+    }
+
+    // Assets are cooked again if anything they reference has changed, as well as if they have
+    const auto dependency_hash = sge::cook::dependency_hash(graph, index);
+    if (cache.is_up_to_date(asset.path, dependency_hash) && std::filesystem::exists(output_path)) {
+      new_cache.dependency_hashes[asset.path] = dependency_hash;
+      num_up_to_date += 1;
+      continue;
+    }
+
+    CookJob job;
+    job.asset = index;
+    job.output_path = std::move(output_path);
+    job.dependency_hash = dependency_hash;
+    jobs->push_back(std::move(job));
+  }
+
+  // Meshes are independent of each other, so cook them in parallel
+  sge::TaskPool::global().parallel_for(mesh_jobs.size(), [&graph, &mesh_jobs](size_t i) {
+    mesh_jobs[i].succeeded = cook_static_mesh(graph.assets[mesh_jobs[i].asset], mesh_jobs[i]);
+  });
+
+  // Saving a scene already spreads its components across the task pool, so scenes are cooked in turn
+  for (auto& job : scene_jobs) {
+    job.succeeded = cook_scene(graph.assets[job.asset], job.output_path);
+  }
+
+  size_t num_cooked = 0;
+  size_t num_failed = 0;
+  for (const auto* const jobs : {&mesh_jobs, &scene_jobs}) {
+    for (const auto& job : *jobs) {
+      const auto& asset = graph.assets[job.asset];
+      if (job.succeeded) {
+        std::cout << "Cooked " << sge::cook::asset_type_name(asset.type) << " '" << asset.path << "' to '"
+                  << job.output_path << "'";
+        if (asset.type == sge::cook::AssetType::STATIC_MESH) {
+          std::cout << " (ACMR " << job.mesh_stats.acmr_before << " -> " << job.mesh_stats.acmr_after << ", "
+                    << job.num_mesh_lods << " LODs, " << job.num_mesh_clusters << " clusters)";
+        }
+        std::cout << std::endl;
+
+        new_cache.dependency_hashes[asset.path] = job.dependency_hash;
+        num_cooked += 1;
+      } else {
+        std::cerr << "Could not cook " << sge::cook::asset_type_name(asset.type) << " '" << asset.path << "'"
+                  << std::endl;
+        num_failed += 1;
+      }
+    }
+  }
+
+  if (!create_parent_directories(cache_path) || !new_cache.save(cache_path)) {
+    std::cerr << "WARNING: Could not write cook cache '" << cache_path << "'" << std::endl;
+  }
+
+  std::cout << graph.assets.size() << " assets: " << num_cooked << " cooked, " << num_up_to_date
+            << " up to date, " << num_failed << " failed" << std::endl;
+  if (num_failed != 0) {
+    return EXIT_FAILURE;
+  }
+
+  // Pack every asset along with its cooked output, so the game can read them all from one archive. Cooked
+  // output is read from the output directory in preference to the content, so cooked meshes and their BVHs
+  // are packed in place of the original meshes, and binary scenes alongside their JSON scenes.
+  if (!pak_path.empty()) {
+    std::vector<std::string> pak_contents;
+    for (const auto& asset : graph.assets) {
+      pak_contents.push_back(asset.path);
+      if (asset.type == sge::cook::AssetType::STATIC_MESH) {
+        pak_contents.push_back(asset.path + ".bvh");
+      } else if (asset.type == sge::cook::AssetType::SCENE && sge::string_ends_with(asset.path, ".json")) {
+        pak_contents.push_back(sge::cook::cooked_scene_path(asset.path));
+      }
+    }
+
+    if (!sge::write_pak_file(pak_path.c_str(), pak_contents, {output_dir, graph.root_dir})) {
+      std::cerr << "Could not write content archive '" << pak_path << "'" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "Packed " << pak_contents.size() << " files into '" << pak_path << "'" << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
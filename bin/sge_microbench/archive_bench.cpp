@@ -0,0 +1,150 @@
+#include <stdio.h>
+
+#include "bin/sge_microbench/bench.h"
+#include "lib/base/interfaces/from_archive.h"
+#include "lib/base/interfaces/to_archive.h"
+#include "lib/base/io/archive_reader.h"
+#include "lib/base/io/archive_writer.h"
+#include "lib/resource/archives/binary_archive.h"
+#include "lib/resource/archives/json_archive.h"
+
+namespace sge {
+namespace microbench {
+/* Number of members in the object used by the member lookup benchmarks, comparable to a serialized node. */
+static constexpr size_t NUM_MEMBERS = 16;
+
+/* Number of elements in the array used by the typed array benchmarks, comparable to a small mesh. */
+static constexpr size_t NUM_ARRAY_ELEMS = 4096;
+
+static void member_name(size_t index, char (&out_name)[16]) {
+  snprintf(out_name, sizeof(out_name), "member_%zu", index);
+}
+
+static void write_test_archive(Archive& archive) {
+  std::vector<float> array(NUM_ARRAY_ELEMS);
+  for (size_t i = 0; i < NUM_ARRAY_ELEMS; ++i) {
+    array[i] = (float)i * 0.5f;
+  }
+
+  auto* const writer = archive.write_root();
+  writer->push_object_member("members");
+  for (size_t i = 0; i < NUM_MEMBERS; ++i) {
+    char name[16];
+    member_name(i, name);
+    writer->object_member(name, (float)i);
+  }
+  writer->pop();
+
+  writer->push_object_member("array");
+  writer->typed_array(array.data(), array.size());
+  writer->pop();
+  writer->pop();
+}
+
+static void bench_member_lookup(BenchState& state, Archive& archive) {
+  write_test_archive(archive);
+
+  char names[NUM_MEMBERS][16];
+  for (size_t i = 0; i < NUM_MEMBERS; ++i) {
+    member_name(i, names[i]);
+  }
+
+  auto* const reader = archive.read_root();
+  reader->pull_object_member("members");
+
+  // Look up every member once per iteration, as deserializing an object does
+  state.items_per_iteration = NUM_MEMBERS;
+  state.start_timing();
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    float total = 0.f;
+    for (size_t member_i = 0; member_i < NUM_MEMBERS; ++member_i) {
+      float value = 0.f;
+      reader->object_member(names[member_i], value);
+      total += value;
+    }
+    do_not_optimize(total);
+  }
+  state.stop_timing();
+
+  reader->pop();  // "members"
+  reader->pop();
+}
+
+static void bench_typed_array(BenchState& state, Archive& archive) {
+  write_test_archive(archive);
+  std::vector<float> array(NUM_ARRAY_ELEMS);
+
+  auto* const reader = archive.read_root();
+  reader->pull_object_member("array");
+
+  state.items_per_iteration = NUM_ARRAY_ELEMS;
+  state.start_timing();
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    size_t size = 0;
+    reader->array_size(size);
+    reader->typed_array(array.data(), size);
+    do_not_optimize(array.data());
+  }
+  state.stop_timing();
+
+  reader->pop();  // "array"
+  reader->pop();
+}
+
+/**
+ * \brief Like 'bench_typed_array', but borrows the archive's memory rather than copying out of it.
+ */
+static void bench_typed_array_view(BenchState& state, Archive& archive) {
+  write_test_archive(archive);
+
+  auto* const reader = archive.read_root();
+  reader->pull_object_member("array");
+
+  state.items_per_iteration = NUM_ARRAY_ELEMS;
+  state.start_timing();
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    const float* view = nullptr;
+    size_t size = 0;
+    reader->typed_array_view(view, size);
+    do_not_optimize(view);
+  }
+  state.stop_timing();
+
+  reader->pop();  // "array"
+  reader->pop();
+}
+
+static void bench_binary_member_lookup(BenchState& state) {
+  BinaryArchive archive;
+  bench_member_lookup(state, archive);
+}
+
+static void bench_binary_typed_array(BenchState& state) {
+  BinaryArchive archive;
+  bench_typed_array(state, archive);
+}
+
+static void bench_binary_typed_array_view(BenchState& state) {
+  BinaryArchive archive;
+  bench_typed_array_view(state, archive);
+}
+
+static void bench_json_member_lookup(BenchState& state) {
+  JsonArchive archive;
+  bench_member_lookup(state, archive);
+}
+
+static void bench_json_typed_array(BenchState& state) {
+  JsonArchive archive;
+  bench_typed_array(state, archive);
+}
+
+void register_archive_benchmarks(std::vector<Benchmark>& out_benchmarks) {
+  out_benchmarks.push_back({"binary_archive.member_lookup", &bench_binary_member_lookup});
+  out_benchmarks.push_back({"binary_archive.typed_array", &bench_binary_typed_array});
+  out_benchmarks.push_back({"binary_archive.typed_array_view", &bench_binary_typed_array_view});
+  out_benchmarks.push_back({"json_archive.member_lookup", &bench_json_member_lookup});
+  out_benchmarks.push_back({"json_archive.typed_array", &bench_json_typed_array});
+}
+}  // namespace microbench
+}  // namespace sge
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace sge {
+namespace microbench {
+/**
+ * \brief State passed to each benchmark function. The benchmark performs any setup it needs, then runs its
+ * operation 'num_iterations' times between calls to 'start_timing' and 'stop_timing'.
+ */
+struct BenchState {
+  explicit BenchState(uint64_t num_iterations) : num_iterations(num_iterations) {}
+
+  void start_timing() { _start = std::chrono::steady_clock::now(); }
+
+  void stop_timing() { elapsed += std::chrono::steady_clock::now() - _start; }
+
+  /* The number of times the benchmark should run its operation. */
+  const uint64_t num_iterations;
+
+  /* The number of items processed by each iteration, used to report per-item timings. Defaults to 1. */
+  uint64_t items_per_iteration = 1;
+
+  /* Total time spent between calls to 'start_timing' and 'stop_timing'. */
+  std::chrono::steady_clock::duration elapsed{};
+
+ private:
+  std::chrono::steady_clock::time_point _start;
+};
+
+using BenchFn = void(BenchState& state);
+
+struct Benchmark {
+  std::string name;
+  BenchFn* fn;
+};
+
+/**
+ * \brief Prevents the compiler from optimizing away the computation of the given value.
+ */
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined __clang__ || defined __GNUC__
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static const void* volatile sink;
+  sink = &value;
+#endif
+}
+
+/**
+ * \brief Prevents the compiler from assuming anything about memory across this point.
+ */
+inline void clobber_memory() {
+#if defined __clang__ || defined __GNUC__
+  asm volatile("" : : : "memory");
+#endif
+}
+
+void register_math_benchmarks(std::vector<Benchmark>& out_benchmarks);
+
+void register_container_benchmarks(std::vector<Benchmark>& out_benchmarks);
+
+void register_archive_benchmarks(std::vector<Benchmark>& out_benchmarks);
+
+void register_scene_benchmarks(std::vector<Benchmark>& out_benchmarks);
+}  // namespace microbench
+}  // namespace sge
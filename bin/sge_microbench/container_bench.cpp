@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <random>
+
+#include "bin/sge_microbench/bench.h"
+#include "bin/sge_microbench/scene_fixture.h"
+#include "lib/base/memory/buffers/multi_stack_buffer.h"
+#include "lib/engine/components/physics/box_collider.h"
+#include "lib/engine/event_channel.h"
+
+namespace sge {
+namespace microbench {
+/* Number of events appended per iteration in the event channel benchmarks. */
+static constexpr int32_t EVENT_BATCH_SIZE = 32;
+
+/* Number of component instances in the component container benchmarks. */
+static constexpr size_t NUM_COMPONENTS = 4096;
+
+static void bench_event_channel_append_consume(BenchState& state) {
+  // The capacity is not a multiple of the batch size, so the steady state wraps around the end of the buffer
+  EventChannel channel{sizeof(ENewComponent), EVENT_BATCH_SIZE * 2 + EVENT_BATCH_SIZE / 2};
+  const auto subscriber_a = channel.subscribe();
+  const auto subscriber_b = channel.subscribe();
+
+  ENewComponent events[EVENT_BATCH_SIZE];
+  for (int32_t i = 0; i < EVENT_BATCH_SIZE; ++i) {
+    events[i].node = NodeId{(uint64_t)i + 1};
+  }
+
+  ENewComponent out_events[EVENT_BATCH_SIZE];
+  int32_t num_out_events;
+  state.items_per_iteration = EVENT_BATCH_SIZE;
+  state.start_timing();
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    channel.append(events, EVENT_BATCH_SIZE);
+    channel.consume(subscriber_a, out_events, &num_out_events);
+    do_not_optimize(out_events);
+    channel.consume(subscriber_b, out_events, &num_out_events);
+    do_not_optimize(out_events);
+
+    // Keep the channel indices from overflowing on long runs (both subscribers are caught up here)
+    if ((i & 0xFFFF) == 0xFFFF) {
+      channel.clear();
+    }
+  }
+  state.stop_timing();
+}
+
+static void bench_event_channel_append_growth(BenchState& state) {
+  ENewComponent event;
+  event.node = NodeId{1};
+
+  // Appends to a fresh channel one event at a time, so that the buffer grows from its minimum capacity
+  state.items_per_iteration = 1024;
+  state.start_timing();
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    EventChannel channel{sizeof(ENewComponent), 1};
+    channel.subscribe();
+    for (uint64_t event_i = 0; event_i < state.items_per_iteration; ++event_i) {
+      channel.append(&event, 1);
+    }
+    clobber_memory();
+  }
+  state.stop_timing();
+}
+
+static void bench_event_channel_append_unsubscribed(BenchState& state) {
+  EventChannel channel{sizeof(ENewComponent), 8};
+  ENewComponent events[EVENT_BATCH_SIZE];
+
+  state.items_per_iteration = EVENT_BATCH_SIZE;
+  state.start_timing();
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    channel.append(events, EVENT_BATCH_SIZE);
+    clobber_memory();
+  }
+  state.stop_timing();
+}
+
+static void bench_multi_stack_buffer_alloc(BenchState& state) {
+  state.items_per_iteration = NUM_COMPONENTS;
+  state.start_timing();
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    MultiStackBuffer buffer;
+    for (size_t alloc_i = 0; alloc_i < NUM_COMPONENTS; ++alloc_i) {
+      auto* const obj = buffer.alloc(sizeof(CBoxCollider));
+      do_not_optimize(obj);
+    }
+  }
+  state.stop_timing();
+}
+
+static void create_nodes(SceneFixture& fixture, std::vector<Node*>& out_nodes, std::vector<NodeId>& out_ids) {
+  out_nodes.assign(NUM_COMPONENTS, nullptr);
+  fixture.scene.create_nodes(out_nodes.size(), out_nodes.data());
+
+  out_ids.resize(out_nodes.size());
+  for (size_t i = 0; i < out_nodes.size(); ++i) {
+    out_ids[i] = out_nodes[i]->get_id();
+  }
+}
+
+static void bench_component_create(BenchState& state) {
+  SceneFixture fixture;
+  std::vector<Node*> nodes;
+  std::vector<NodeId> node_ids;
+  create_nodes(fixture, nodes, node_ids);
+
+  auto* const container = fixture.scene.get_component_container(CBoxCollider::type_info);
+  std::vector<void*> instances(nodes.size(), nullptr);
+
+  state.items_per_iteration = NUM_COMPONENTS;
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    state.start_timing();
+    container->create_instances(nodes.data(), nodes.size(), instances.data());
+    state.stop_timing();
+
+    container->remove_instances(node_ids.data(), node_ids.size());
+    container->on_end_update_frame();
+  }
+}
+
+static void bench_component_remove(BenchState& state) {
+  SceneFixture fixture;
+  std::vector<Node*> nodes;
+  std::vector<NodeId> node_ids;
+  create_nodes(fixture, nodes, node_ids);
+
+  // Remove instances in a different order than they were created in, as happens when gameplay destroys nodes
+  std::mt19937 rng{1};
+  std::shuffle(node_ids.begin(), node_ids.end(), rng);
+
+  auto* const container = fixture.scene.get_component_container(CBoxCollider::type_info);
+  std::vector<void*> instances(nodes.size(), nullptr);
+
+  state.items_per_iteration = NUM_COMPONENTS;
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    container->create_instances(nodes.data(), nodes.size(), instances.data());
+
+    state.start_timing();
+    container->remove_instances(node_ids.data(), node_ids.size());
+    container->on_end_update_frame();
+    state.stop_timing();
+  }
+}
+
+static void bench_component_get(BenchState& state) {
+  SceneFixture fixture;
+  std::vector<Node*> nodes;
+  std::vector<NodeId> node_ids;
+  create_nodes(fixture, nodes, node_ids);
+
+  auto* const container = fixture.scene.get_component_container(CBoxCollider::type_info);
+  std::vector<void*> instances(nodes.size(), nullptr);
+  container->create_instances(nodes.data(), nodes.size(), instances.data());
+  container->on_end_update_frame();
+
+  // Look up instances in random order, as systems responding to events do
+  std::mt19937 rng{1};
+  std::shuffle(node_ids.begin(), node_ids.end(), rng);
+
+  state.items_per_iteration = NUM_COMPONENTS;
+  state.start_timing();
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    container->get_instances(node_ids.data(), node_ids.size(), instances.data());
+    do_not_optimize(instances.data());
+  }
+  state.stop_timing();
+}
+
+static void bench_component_iterate(BenchState& state) {
+  SceneFixture fixture;
+  std::vector<Node*> nodes;
+  std::vector<NodeId> node_ids;
+  create_nodes(fixture, nodes, node_ids);
+
+  auto* const container = fixture.scene.get_component_container(CBoxCollider::type_info);
+  std::vector<void*> instances(nodes.size(), nullptr);
+  container->create_instances(nodes.data(), nodes.size(), instances.data());
+  container->on_end_update_frame();
+
+  // Iterate the same way the builtin systems do
+  state.items_per_iteration = NUM_COMPONENTS;
+  state.start_timing();
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    NodeId batch_ids[32];
+    size_t start_index = 0;
+    size_t num_instances;
+    float total = 0.f;
+    while (container->get_instance_nodes(start_index, 32, &num_instances, batch_ids)) {
+      start_index += 32;
+      CBoxCollider* batch[32];
+      container->get_instances(batch_ids, num_instances, batch);
+
+      for (size_t instance_i = 0; instance_i < num_instances; ++instance_i) {
+        total += batch[instance_i]->width();
+      }
+    }
+    do_not_optimize(total);
+  }
+  state.stop_timing();
+}
+
+void register_container_benchmarks(std::vector<Benchmark>& out_benchmarks) {
+  out_benchmarks.push_back({"event_channel.append_consume", &bench_event_channel_append_consume});
+  out_benchmarks.push_back({"event_channel.append_growth", &bench_event_channel_append_growth});
+  out_benchmarks.push_back({"event_channel.append_unsubscribed", &bench_event_channel_append_unsubscribed});
+  out_benchmarks.push_back({"multi_stack_buffer.alloc", &bench_multi_stack_buffer_alloc});
+  out_benchmarks.push_back({"component.create", &bench_component_create});
+  out_benchmarks.push_back({"component.remove", &bench_component_remove});
+  out_benchmarks.push_back({"component.get", &bench_component_get});
+  out_benchmarks.push_back({"component.iterate", &bench_component_iterate});
+}
+}  // namespace microbench
+}  // namespace sge
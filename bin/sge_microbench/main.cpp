@@ -0,0 +1,165 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "bin/sge_microbench/bench.h"
+#include "lib/base/interfaces/to_archive.h"
+#include "lib/resource/archives/json_archive.h"
+
+struct MicrobenchOptions {
+  const char* filter = nullptr;
+  const char* out_path = nullptr;
+  double min_time_ms = 100.0;
+  uint32_t num_samples = 5;
+  bool list = false;
+};
+
+static void print_usage() {
+  std::cerr << "Usage: sge_microbench [--filter <substring>] [--min-time <ms>] [--samples <n>] "
+               "[--out <path.json>] [--list]"
+            << std::endl;
+}
+
+static bool parse_options(int argc, char* argv[], MicrobenchOptions& out_options) {
+  for (int i = 1; i < argc; ++i) {
+    const char* const arg = argv[i];
+    if (strcmp(arg, "--list") == 0) {
+      out_options.list = true;
+      continue;
+    }
+
+    if (i + 1 >= argc) {
+      return false;
+    }
+
+    const char* const value = argv[++i];
+    if (strcmp(arg, "--filter") == 0) {
+      out_options.filter = value;
+    } else if (strcmp(arg, "--min-time") == 0) {
+      out_options.min_time_ms = strtod(value, nullptr);
+    } else if (strcmp(arg, "--samples") == 0) {
+      out_options.num_samples = (uint32_t)strtoul(value, nullptr, 10);
+    } else if (strcmp(arg, "--out") == 0) {
+      out_options.out_path = value;
+    } else {
+      return false;
+    }
+  }
+
+  return out_options.num_samples != 0 && out_options.min_time_ms > 0.0;
+}
+
+static double run_benchmark(
+    const sge::microbench::Benchmark& benchmark,
+    uint64_t num_iterations,
+    uint64_t& out_items
+) {
+  sge::microbench::BenchState state{num_iterations};
+  benchmark.fn(state);
+  out_items = state.items_per_iteration;
+  return std::chrono::duration<double, std::nano>{state.elapsed}.count();
+}
+
+/**
+ * \brief Finds the number of iterations needed for a single sample of the benchmark to take at least the
+ * given amount of time.
+ */
+static uint64_t calibrate_iterations(const sge::microbench::Benchmark& benchmark, double min_time_ns) {
+  uint64_t num_iterations = 1;
+  uint64_t num_items;
+  while (true) {
+    const auto elapsed_ns = run_benchmark(benchmark, num_iterations, num_items);
+    if (elapsed_ns >= min_time_ns) {
+      return num_iterations;
+    }
+
+    // Aim slightly past the target, but grow by at most 10x per step in case the first runs were noisy
+    const auto scale = elapsed_ns > 0.0 ? std::min(min_time_ns * 1.2 / elapsed_ns, 10.0) : 10.0;
+    num_iterations = std::max(num_iterations + 1, (uint64_t)(num_iterations * scale));
+  }
+}
+
+int main(int argc, char* argv[]) {
+  MicrobenchOptions options;
+  if (!parse_options(argc, argv, options)) {
+    print_usage();
+    return EXIT_FAILURE;
+  }
+
+  std::vector<sge::microbench::Benchmark> benchmarks;
+  sge::microbench::register_math_benchmarks(benchmarks);
+  sge::microbench::register_container_benchmarks(benchmarks);
+  sge::microbench::register_archive_benchmarks(benchmarks);
+  sge::microbench::register_scene_benchmarks(benchmarks);
+
+  if (options.filter) {
+    const std::string filter = options.filter;
+    benchmarks.erase(
+        std::remove_if(
+            benchmarks.begin(),
+            benchmarks.end(),
+            [&filter](const sge::microbench::Benchmark& benchmark) {
+              return benchmark.name.find(filter) == std::string::npos;
+            }
+        ),
+        benchmarks.end()
+    );
+  }
+
+  if (options.list) {
+    for (const auto& benchmark : benchmarks) {
+      std::cout << benchmark.name << std::endl;
+    }
+    return EXIT_SUCCESS;
+  }
+
+  sge::JsonArchive report;
+  auto* const writer = report.write_root();
+  writer->object_member("min_time_ms", options.min_time_ms);
+  writer->object_member("samples", options.num_samples);
+  writer->push_object_member("benchmarks");
+  writer->as_object();
+
+  const double min_time_ns = options.min_time_ms * 1e6;
+  for (const auto& benchmark : benchmarks) {
+    std::cerr << benchmark.name << "..." << std::endl;
+    const auto num_iterations = calibrate_iterations(benchmark, min_time_ns);
+
+    // Take several samples, and report the spread so that noisy results are easy to spot
+    std::vector<double> sample_ns_per_iter;
+    uint64_t items_per_iteration = 1;
+    for (uint32_t i = 0; i < options.num_samples; ++i) {
+      const auto elapsed_ns = run_benchmark(benchmark, num_iterations, items_per_iteration);
+      sample_ns_per_iter.push_back(elapsed_ns / num_iterations);
+    }
+    std::sort(sample_ns_per_iter.begin(), sample_ns_per_iter.end());
+    const auto median_ns = sample_ns_per_iter[sample_ns_per_iter.size() / 2];
+
+    writer->push_object_member(benchmark.name.c_str());
+    writer->object_member("iterations", num_iterations);
+    writer->object_member("items_per_iteration", items_per_iteration);
+    writer->object_member("min_ns", sample_ns_per_iter.front());
+    writer->object_member("median_ns", median_ns);
+    writer->object_member("max_ns", sample_ns_per_iter.back());
+    writer->object_member("median_ns_per_item", median_ns / (double)items_per_iteration);
+    writer->pop();
+  }
+
+  writer->pop();  // "benchmarks"
+  writer->pop();
+
+  if (options.out_path) {
+    if (!report.to_file(options.out_path)) {
+      std::cerr << "Could not write report to '" << options.out_path << "'" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } else {
+    std::cout << report.to_string() << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
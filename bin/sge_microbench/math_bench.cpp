@@ -0,0 +1,104 @@
+#include "bin/sge_microbench/bench.h"
+#include "lib/base/math/mat4.h"
+
+namespace sge {
+namespace microbench {
+/* Number of distinct operands each math benchmark cycles through, so that results aren't constant-folded. */
+static constexpr size_t NUM_OPERANDS = 64;
+
+static void make_transforms(Mat4* out_matrices, Quat* out_rotations) {
+  for (size_t i = 0; i < NUM_OPERANDS; ++i) {
+    const float f = (float)i;
+    const Quat rot{Vec3{f + 1.f, 2.f, 3.f - f}, Angle{f * 0.1f}};
+    out_rotations[i] = rot;
+    out_matrices[i] = Mat4::translation(Vec3{f, -f, f * 0.5f}) * Mat4::rotate(rot) *
+                      Mat4::scale(Vec3{1.f + f * 0.01f, 1.f, 2.f});
+  }
+}
+
+static void bench_mat4_multiply(BenchState& state) {
+  Mat4 matrices[NUM_OPERANDS];
+  Quat rotations[NUM_OPERANDS];
+  make_transforms(matrices, rotations);
+
+  state.start_timing();
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    const auto result = matrices[i % NUM_OPERANDS] * matrices[(i + 1) % NUM_OPERANDS];
+    do_not_optimize(result);
+  }
+  state.stop_timing();
+}
+
+static void bench_mat4_inverse(BenchState& state) {
+  Mat4 matrices[NUM_OPERANDS];
+  Quat rotations[NUM_OPERANDS];
+  make_transforms(matrices, rotations);
+
+  state.start_timing();
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    const auto result = matrices[i % NUM_OPERANDS].inverse();
+    do_not_optimize(result);
+  }
+  state.stop_timing();
+}
+
+static void bench_mat4_transform_point(BenchState& state) {
+  Mat4 matrices[NUM_OPERANDS];
+  Quat rotations[NUM_OPERANDS];
+  make_transforms(matrices, rotations);
+
+  state.start_timing();
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    const float f = (float)(i % NUM_OPERANDS);
+    const auto result = matrices[i % NUM_OPERANDS] * Vec3{f, 1.f, -f};
+    do_not_optimize(result);
+  }
+  state.stop_timing();
+}
+
+static void bench_quat_multiply(BenchState& state) {
+  Mat4 matrices[NUM_OPERANDS];
+  Quat rotations[NUM_OPERANDS];
+  make_transforms(matrices, rotations);
+
+  state.start_timing();
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    const auto result = rotations[i % NUM_OPERANDS] * rotations[(i + 1) % NUM_OPERANDS];
+    do_not_optimize(result);
+  }
+  state.stop_timing();
+}
+
+static void bench_quat_from_axis_angle(BenchState& state) {
+  state.start_timing();
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    const float f = (float)(i % NUM_OPERANDS);
+    const Quat result{Vec3{f + 1.f, 2.f, 3.f - f}, Angle{f * 0.1f}};
+    do_not_optimize(result);
+  }
+  state.stop_timing();
+}
+
+static void bench_quat_to_mat4(BenchState& state) {
+  Mat4 matrices[NUM_OPERANDS];
+  Quat rotations[NUM_OPERANDS];
+  make_transforms(matrices, rotations);
+
+  state.start_timing();
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    const auto result = Mat4::rotate(rotations[i % NUM_OPERANDS]);
+    do_not_optimize(result);
+  }
+  state.stop_timing();
+}
+
+void register_math_benchmarks(std::vector<Benchmark>& out_benchmarks) {
+  out_benchmarks.push_back({"mat4.multiply", &bench_mat4_multiply});
+  out_benchmarks.push_back({"mat4.inverse", &bench_mat4_inverse});
+  out_benchmarks.push_back({"mat4.transform_point", &bench_mat4_transform_point});
+  out_benchmarks.push_back({"quat.multiply", &bench_quat_multiply});
+  out_benchmarks.push_back({"quat.from_axis_angle", &bench_quat_from_axis_angle});
+  out_benchmarks.push_back({"quat.to_mat4", &bench_quat_to_mat4});
+}
+}  // namespace microbench
+}  // namespace sge
@@ -0,0 +1,76 @@
+#include "bin/sge_microbench/bench.h"
+#include "bin/sge_microbench/scene_fixture.h"
+
+namespace sge {
+namespace microbench {
+/* Number of nodes in each transform propagation benchmark. */
+static constexpr size_t NUM_NODES = 4096;
+
+/**
+ * \brief Runs a frame per iteration, in which every root node is moved so that the transforms of the whole
+ * scene must be propagated.
+ * \param state The benchmark state.
+ * \param chain_length The number of nodes in each hierarchy, where each node is the only child of the
+ * node before it.
+ */
+static void bench_transform_propagation(BenchState& state, size_t chain_length) {
+  SceneFixture fixture;
+  std::vector<Node*> nodes(NUM_NODES, nullptr);
+  fixture.scene.create_nodes(nodes.size(), nodes.data());
+
+  std::vector<Node*> roots;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    if (i % chain_length == 0) {
+      roots.push_back(nodes[i]);
+    } else {
+      nodes[i - 1]->add_child(*nodes[i]);
+    }
+    nodes[i]->set_local_position(Vec3{1.f, 0.f, 0.f});
+  }
+
+  uint64_t frame = 0;
+  fixture.pipeline.register_system_fn(
+      "microbench_move_roots",
+      [&roots, &frame](Scene& /*scene*/, SystemFrame& /*frame*/) {
+        const float offset = (float)(frame % 2);
+        for (size_t i = 0; i < roots.size(); ++i) {
+          roots[i]->set_local_position(Vec3{(float)i, offset, 0.f});
+        }
+      }
+  );
+  fixture.configure_pipeline(R"(["microbench_move_roots"])");
+
+  // Apply the initial state of the scene before timing anything
+  fixture.scene.update(fixture.pipeline, 0.f);
+  frame += 1;
+
+  state.items_per_iteration = NUM_NODES;
+  state.start_timing();
+  for (uint64_t i = 0; i < state.num_iterations; ++i) {
+    fixture.scene.update(fixture.pipeline, 1.f / 60.f);
+    frame += 1;
+  }
+  state.stop_timing();
+
+  do_not_optimize(nodes.back()->get_world_matrix());
+}
+
+static void bench_transform_propagation_flat(BenchState& state) {
+  bench_transform_propagation(state, 1);
+}
+
+static void bench_transform_propagation_shallow(BenchState& state) {
+  bench_transform_propagation(state, 4);
+}
+
+static void bench_transform_propagation_deep(BenchState& state) {
+  bench_transform_propagation(state, 64);
+}
+
+void register_scene_benchmarks(std::vector<Benchmark>& out_benchmarks) {
+  out_benchmarks.push_back({"scene.transform_propagation_flat", &bench_transform_propagation_flat});
+  out_benchmarks.push_back({"scene.transform_propagation_shallow", &bench_transform_propagation_shallow});
+  out_benchmarks.push_back({"scene.transform_propagation_deep", &bench_transform_propagation_deep});
+}
+}  // namespace microbench
+}  // namespace sge
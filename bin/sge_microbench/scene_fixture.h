@@ -0,0 +1,42 @@
+#pragma once
+
+#include "lib/base/reflection/type_db.h"
+#include "lib/engine/scene.h"
+#include "lib/engine/system_frame.h"
+#include "lib/engine/update_pipeline.h"
+#include "lib/resource/archives/json_archive.h"
+
+namespace sge {
+namespace microbench {
+/**
+ * \brief A scene with the builtin components registered, configured the same way as the clients configure it.
+ */
+struct SceneFixture {
+  SceneFixture() : scene(init_type_db(type_db)) { register_builtin_components(scene); }
+
+  /**
+   * \brief Configures 'pipeline' to run the given systems, in order.
+   * \param pipeline_json A JSON array of system names.
+   */
+  void configure_pipeline(const char* pipeline_json) {
+    JsonArchive pipeline_config;
+    pipeline_config.from_string(pipeline_json);
+    auto* const reader = pipeline_config.read_root();
+    pipeline.configure_pipeline(*reader);
+    reader->pop();
+  }
+
+  TypeDB type_db;
+  Scene scene;
+  UpdatePipeline pipeline;
+
+ private:
+  static TypeDB& init_type_db(TypeDB& type_db) {
+    type_db.new_type<Vec3>();
+    type_db.new_type<Quat>();
+    type_db.new_type<float>();
+    return type_db;
+  }
+};
+}  // namespace microbench
+}  // namespace sge
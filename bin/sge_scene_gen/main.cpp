@@ -0,0 +1,99 @@
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+
+#include "lib/base/reflection/type_db.h"
+#include "lib/engine/scene.h"
+#include "lib/engine/scene_file.h"
+#include "lib/engine/update_pipeline.h"
+#include "lib/resource/archives/json_archive.h"
+#include "lib/scene_gen/scene_gen.h"
+
+static void print_usage() {
+  std::cerr << "Usage: sge_scene_gen --out <scene.json|scene.sbin> [--config <config.json>] [--nodes <n>] "
+               "[--depth <n>] [--fan-out <n>] [--seed <n>]"
+            << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  const char* out_path = nullptr;
+  const char* config_path = nullptr;
+  sge::scene_gen::Config config;
+
+  // Load the config file first, so that command line options override it
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--config") == 0) {
+      config_path = argv[i + 1];
+    }
+  }
+
+  if (config_path) {
+    sge::JsonArchive config_archive;
+    if (!config_archive.from_file(config_path)) {
+      std::cerr << "Could not load config '" << config_path << "'" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    config_archive.deserialize_root(config);
+  }
+
+  for (int i = 1; i < argc; i += 2) {
+    const char* const arg = argv[i];
+    if (i + 1 >= argc) {
+      print_usage();
+      return EXIT_FAILURE;
+    }
+
+    const char* const value = argv[i + 1];
+    if (strcmp(arg, "--out") == 0) {
+      out_path = value;
+    } else if (strcmp(arg, "--nodes") == 0) {
+      config.num_nodes = (uint32_t)strtoul(value, nullptr, 10);
+    } else if (strcmp(arg, "--depth") == 0) {
+      config.hierarchy_depth = (uint32_t)strtoul(value, nullptr, 10);
+    } else if (strcmp(arg, "--fan-out") == 0) {
+      config.fan_out = (uint32_t)strtoul(value, nullptr, 10);
+    } else if (strcmp(arg, "--seed") == 0) {
+      config.seed = (uint32_t)strtoul(value, nullptr, 10);
+    } else if (strcmp(arg, "--config") != 0) {
+      print_usage();
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (!out_path || !config.validate()) {
+    print_usage();
+    return EXIT_FAILURE;
+  }
+
+  // Create a scene
+  sge::TypeDB type_db;
+  type_db.new_type<sge::Vec3>();
+  type_db.new_type<sge::Quat>();
+  type_db.new_type<float>();
+  sge::Scene scene{type_db};
+  sge::register_builtin_components(scene);
+
+  // Generate the scene, and run a single empty frame so that the pending node state is applied
+  sge::scene_gen::generate_scene(scene, config);
+
+  sge::UpdatePipeline pipeline;
+  pipeline.register_system_fn("scene_gen_apply", [](sge::Scene& /*scene*/, sge::SystemFrame& /*frame*/) {});
+
+  sge::JsonArchive pipeline_config;
+  pipeline_config.from_string(R"(["scene_gen_apply"])");
+  auto* const pipeline_reader = pipeline_config.read_root();
+  pipeline.configure_pipeline(*pipeline_reader);
+  pipeline_reader->pop();
+  scene.update(pipeline, 0.f);
+
+  // Write it out
+  if (!sge::save_scene_file(scene, out_path)) {
+    std::cerr << "Could not write scene to '" << out_path << "'" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Generated " << scene.get_raw_scene_data().nodes.size() << " nodes to '" << out_path << "'"
+            << std::endl;
+  return EXIT_SUCCESS;
+}
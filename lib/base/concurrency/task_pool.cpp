@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <atomic>
+
+#include "lib/base/concurrency/task_pool.h"
+
+namespace sge {
+struct TaskPool::Batch {
+  FunctionView<void(size_t i)> fn;
+  size_t count;
+
+  /* The next index to be claimed. Indices at or past 'count' mean the batch has been fully claimed. */
+  std::atomic<size_t> next_index;
+
+  /* Number of workers currently running tasks from this batch. Guarded by the pool's mutex. */
+  size_t num_workers;
+};
+
+TaskPool::TaskPool(size_t num_workers) : _stopping(false) {
+  _workers.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; ++i) {
+    _workers.emplace_back([this]() { run_worker(); });
+  }
+}
+
+TaskPool::~TaskPool() {
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _stopping = true;
+  }
+  _batch_ready.notify_all();
+
+  for (auto& worker : _workers) {
+    worker.join();
+  }
+}
+
+TaskPool& TaskPool::global() {
+  static TaskPool pool{std::max(std::thread::hardware_concurrency(), 2u) - 1};
+  return pool;
+}
+
+void TaskPool::parallel_for(size_t count, FunctionView<void(size_t i)> fn) {
+  // Don't bother waking workers for a single task
+  if (count <= 1 || _workers.empty()) {
+    for (size_t i = 0; i < count; ++i) {
+      fn(i);
+    }
+    return;
+  }
+
+  Batch batch{fn, count, {0}, 0};
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _batches.push_back(&batch);
+  }
+  _batch_ready.notify_all();
+
+  // Help out, so that the batch still completes if every worker is busy
+  run_batch(batch);
+
+  // Every index has been claimed, so wait for the workers still running tasks from it
+  std::unique_lock<std::mutex> lock{_mutex};
+  const auto iter = std::find(_batches.begin(), _batches.end(), &batch);
+  if (iter != _batches.end()) {
+    _batches.erase(iter);
+  }
+  _batch_released.wait(lock, [&batch]() { return batch.num_workers == 0; });
+}
+
+void TaskPool::run_worker() {
+  std::unique_lock<std::mutex> lock{_mutex};
+  while (true) {
+    _batch_ready.wait(lock, [this]() { return _stopping || !_batches.empty(); });
+    if (_stopping) {
+      return;
+    }
+
+    // Join the oldest batch
+    auto* const batch = _batches.front();
+    batch->num_workers += 1;
+    lock.unlock();
+    run_batch(*batch);
+    lock.lock();
+
+    // The batch has been fully claimed, so nobody else should join it
+    if (!_batches.empty() && _batches.front() == batch) {
+      _batches.pop_front();
+    }
+
+    batch->num_workers -= 1;
+    if (batch->num_workers == 0) {
+      _batch_released.notify_all();
+    }
+  }
+}
+
+void TaskPool::run_batch(Batch& batch) {
+  while (true) {
+    const auto index = batch.next_index.fetch_add(1, std::memory_order_relaxed);
+    if (index >= batch.count) {
+      return;
+    }
+
+    batch.fn(index);
+  }
+}
+}  // namespace sge
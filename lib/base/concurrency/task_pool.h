@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stddef.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "lib/base/build.h"
+#include "lib/base/functional/function_view.h"
+
+namespace sge {
+/**
+ * \brief A fixed set of worker threads, which help callers run batches of independent tasks in parallel.
+ */
+struct SGE_BASE_EXPORT TaskPool {
+  /**
+   * \brief Starts the given number of worker threads. A pool with no workers runs everything on the caller.
+   */
+  explicit TaskPool(size_t num_workers);
+  ~TaskPool();
+  TaskPool(const TaskPool& copy) = delete;
+  TaskPool& operator=(const TaskPool& copy) = delete;
+
+  /**
+   * \brief Returns the process-wide pool, which has one worker for each hardware thread besides the caller's.
+   */
+  static TaskPool& global();
+
+  size_t num_workers() const { return _workers.size(); }
+
+  /**
+   * \brief Calls the given function once for each index in [0, count), spread across the calling thread and
+   * any idle workers, and returns once all calls have completed. This may be called from within a task.
+   * \param count The number of indices to call the function with.
+   * \param fn The function to call. Calls may run concurrently, in any order.
+   */
+  void parallel_for(size_t count, FunctionView<void(size_t i)> fn);
+
+ private:
+  struct Batch;
+
+  void run_worker();
+
+  static void run_batch(Batch& batch);
+
+  std::vector<std::thread> _workers;
+  std::mutex _mutex;
+  std::condition_variable _batch_ready;
+  std::condition_variable _batch_released;
+  std::deque<Batch*> _batches;
+  bool _stopping;
+};
+}  // namespace sge
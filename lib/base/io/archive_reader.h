@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <memory>
 
 #include "lib/base/build.h"
 #include "lib/base/functional/function_view.h"
@@ -18,6 +19,15 @@ class SGE_BASE_EXPORT ArchiveReader {
    */
   virtual void pop() = 0;
 
+  /**
+   * \brief Creates a separate reader whose root is this node, which may be used on another thread while this
+   * reader (and other forks) are in use. The fork is destroyed by popping its root, which must happen before
+   * this node is popped.
+   * \return The new reader, or null if this reader does not support forking, in which case the node must be
+   * read through this reader.
+   */
+  virtual ArchiveReader* fork() const { return nullptr; }
+
   /**
    * \brief Returns whether this node contains 'null'.
    */
@@ -219,6 +229,102 @@ class SGE_BASE_EXPORT ArchiveReader {
    */
   virtual size_t typed_array(double* out, size_t size) const = 0;
 
+  /**
+   * \brief Trys to get a view of the array of all type int8_t in this node, without copying it.
+   * \param out_array Assigned a pointer to the first element of the array, if a view is available.
+   * \param out_size Assigned the number of elements in the array, if a view is available.
+   * \return Whether a view is available. If not, 'typed_array' must be used to copy the array instead.
+   * The view remains valid for as long as the archive, or the object returned by 'view_owner'.
+   */
+  virtual bool typed_array_view(const int8_t*& /*out_array*/, size_t& /*out_size*/) const { return false; }
+
+  /**
+   * \brief Trys to get a view of the array of all type uint8_t in this node, without copying it.
+   * \param out_array Assigned a pointer to the first element of the array, if a view is available.
+   * \param out_size Assigned the number of elements in the array, if a view is available.
+   * \return Whether a view is available. If not, 'typed_array' must be used to copy the array instead.
+   * The view remains valid for as long as the archive, or the object returned by 'view_owner'.
+   */
+  virtual bool typed_array_view(const uint8_t*& /*out_array*/, size_t& /*out_size*/) const { return false; }
+
+  /**
+   * \brief Trys to get a view of the array of all type int16_t in this node, without copying it.
+   * \param out_array Assigned a pointer to the first element of the array, if a view is available.
+   * \param out_size Assigned the number of elements in the array, if a view is available.
+   * \return Whether a view is available. If not, 'typed_array' must be used to copy the array instead.
+   * The view remains valid for as long as the archive, or the object returned by 'view_owner'.
+   */
+  virtual bool typed_array_view(const int16_t*& /*out_array*/, size_t& /*out_size*/) const { return false; }
+
+  /**
+   * \brief Trys to get a view of the array of all type uint16_t in this node, without copying it.
+   * \param out_array Assigned a pointer to the first element of the array, if a view is available.
+   * \param out_size Assigned the number of elements in the array, if a view is available.
+   * \return Whether a view is available. If not, 'typed_array' must be used to copy the array instead.
+   * The view remains valid for as long as the archive, or the object returned by 'view_owner'.
+   */
+  virtual bool typed_array_view(const uint16_t*& /*out_array*/, size_t& /*out_size*/) const { return false; }
+
+  /**
+   * \brief Trys to get a view of the array of all type int32_t in this node, without copying it.
+   * \param out_array Assigned a pointer to the first element of the array, if a view is available.
+   * \param out_size Assigned the number of elements in the array, if a view is available.
+   * \return Whether a view is available. If not, 'typed_array' must be used to copy the array instead.
+   * The view remains valid for as long as the archive, or the object returned by 'view_owner'.
+   */
+  virtual bool typed_array_view(const int32_t*& /*out_array*/, size_t& /*out_size*/) const { return false; }
+
+  /**
+   * \brief Trys to get a view of the array of all type uint32_t in this node, without copying it.
+   * \param out_array Assigned a pointer to the first element of the array, if a view is available.
+   * \param out_size Assigned the number of elements in the array, if a view is available.
+   * \return Whether a view is available. If not, 'typed_array' must be used to copy the array instead.
+   * The view remains valid for as long as the archive, or the object returned by 'view_owner'.
+   */
+  virtual bool typed_array_view(const uint32_t*& /*out_array*/, size_t& /*out_size*/) const { return false; }
+
+  /**
+   * \brief Trys to get a view of the array of all type int64_t in this node, without copying it.
+   * \param out_array Assigned a pointer to the first element of the array, if a view is available.
+   * \param out_size Assigned the number of elements in the array, if a view is available.
+   * \return Whether a view is available. If not, 'typed_array' must be used to copy the array instead.
+   * The view remains valid for as long as the archive, or the object returned by 'view_owner'.
+   */
+  virtual bool typed_array_view(const int64_t*& /*out_array*/, size_t& /*out_size*/) const { return false; }
+
+  /**
+   * \brief Trys to get a view of the array of all type uint64_t in this node, without copying it.
+   * \param out_array Assigned a pointer to the first element of the array, if a view is available.
+   * \param out_size Assigned the number of elements in the array, if a view is available.
+   * \return Whether a view is available. If not, 'typed_array' must be used to copy the array instead.
+   * The view remains valid for as long as the archive, or the object returned by 'view_owner'.
+   */
+  virtual bool typed_array_view(const uint64_t*& /*out_array*/, size_t& /*out_size*/) const { return false; }
+
+  /**
+   * \brief Trys to get a view of the array of all type float in this node, without copying it.
+   * \param out_array Assigned a pointer to the first element of the array, if a view is available.
+   * \param out_size Assigned the number of elements in the array, if a view is available.
+   * \return Whether a view is available. If not, 'typed_array' must be used to copy the array instead.
+   * The view remains valid for as long as the archive, or the object returned by 'view_owner'.
+   */
+  virtual bool typed_array_view(const float*& /*out_array*/, size_t& /*out_size*/) const { return false; }
+
+  /**
+   * \brief Trys to get a view of the array of all type double in this node, without copying it.
+   * \param out_array Assigned a pointer to the first element of the array, if a view is available.
+   * \param out_size Assigned the number of elements in the array, if a view is available.
+   * \return Whether a view is available. If not, 'typed_array' must be used to copy the array instead.
+   * The view remains valid for as long as the archive, or the object returned by 'view_owner'.
+   */
+  virtual bool typed_array_view(const double*& /*out_array*/, size_t& /*out_size*/) const { return false; }
+
+  /**
+   * \brief Returns an object which keeps the memory of views returned by 'typed_array_view' alive, even after
+   * this reader and its archive are destroyed. Returns null if there is no such object.
+   */
+  virtual std::shared_ptr<const void> view_owner() const { return nullptr; }
+
   virtual void enumerate_array_elements(FunctionView<void(size_t i)> enumerator) = 0;
 
   virtual bool pull_array_element(size_t i) = 0;
@@ -19,6 +19,21 @@ class SGE_BASE_EXPORT ArchiveWriter {
    */
   virtual void pop() = 0;
 
+  /**
+   * \brief Creates a separate writer for a node that is not yet part of this archive, which may be used on
+   * another thread while this writer (and other forks) are in use. Once written, the node is added to this
+   * archive by passing the fork to 'join', rather than popping its root.
+   * \return The new writer, or null if this writer does not support forking, in which case the node must be
+   * written through this writer.
+   */
+  virtual ArchiveWriter* fork() const { return nullptr; }
+
+  /**
+   * \brief Sets this node to the root node of a writer returned by 'fork', and destroys that writer.
+   * \param fork The forked writer. Its root node must not have been popped.
+   */
+  virtual void join(ArchiveWriter& /*fork*/) {}
+
   /**
    * \brief Sets this archive node as null.
    */
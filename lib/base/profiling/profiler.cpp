@@ -0,0 +1,321 @@
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "lib/base/interfaces/to_archive.h"
+#include "lib/base/io/archive_writer.h"
+#include "lib/base/profiling/profiler.h"
+
+namespace sge {
+struct OpenZone {
+  uint32_t zone_id;
+  const char* name;
+  uint64_t start_ns;
+};
+
+struct ZoneSample {
+  uint64_t end_ns;
+  float duration_ms;
+};
+
+struct ZoneHistory {
+  std::vector<ZoneSample> samples;
+  uint32_t next = 0;
+};
+
+struct ProfilerThreadBuffer {
+  /* Only contended while the zones are being read. */
+  std::mutex mutex;
+  std::vector<ProfileZone> zones;
+  size_t next_zone = 0;
+  size_t num_zones = 0;
+  std::unordered_map<uint32_t, ZoneHistory> history;
+};
+
+/* Interned zone names. The strings are held by the map's nodes, which never move. */
+struct ZoneNames {
+  std::mutex mutex;
+  std::unordered_map<std::string, uint32_t> ids;
+  std::vector<const char*> names;
+};
+
+/* The ids and interned names of zones which have been opened on this thread. */
+struct InternedName {
+  uint32_t zone_id;
+  const char* name;
+};
+
+static int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()
+  )
+      .count();
+}
+
+static uint32_t current_thread_id() {
+  static std::atomic<uint32_t> next_thread_id{0};
+  thread_local const uint32_t thread_id = next_thread_id.fetch_add(1, std::memory_order_relaxed);
+  return thread_id;
+}
+
+static ZoneNames& zone_names() {
+  // Never destroyed, so that interned names remain valid through static destruction
+  static auto* const names = new ZoneNames();
+  return *names;
+}
+
+static const char* zone_name(uint32_t zone_id) {
+  auto& names = zone_names();
+  std::lock_guard<std::mutex> lock{names.mutex};
+  return names.names[zone_id];
+}
+
+static InternedName intern_zone_name(const char* name) {
+  thread_local std::unordered_map<std::string_view, InternedName> interned;
+  const auto iter = interned.find(name);
+  if (iter != interned.end()) {
+    return iter->second;
+  }
+
+  auto& names = zone_names();
+  std::lock_guard<std::mutex> lock{names.mutex};
+  const auto id = (uint32_t)names.ids.size();
+  const auto [entry, inserted] = names.ids.emplace(name, id);
+  if (inserted) {
+    names.names.push_back(entry->first.c_str());
+  }
+
+  const InternedName result{entry->second, entry->first.c_str()};
+  interned.emplace(entry->first, result);
+  return result;
+}
+
+/* Zones which have been opened but not yet closed on this thread. */
+static thread_local std::vector<OpenZone> open_zones;
+
+/* Unique ids for profiler instances, so that a thread's buffer isn't mistaken for one belonging to a new
+ * profiler at the same address. */
+static std::atomic<uint64_t> next_profiler_id{1};
+
+Profiler::Profiler()
+    : _enabled(false),
+      _history_size(DEFAULT_HISTORY_SIZE),
+      _instance_id(next_profiler_id.fetch_add(1, std::memory_order_relaxed)),
+      _epoch_ns(now_ns()) {}
+
+Profiler& Profiler::global() {
+  static Profiler profiler;
+  return profiler;
+}
+
+void Profiler::set_enabled(bool enabled) {
+  _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::set_history_size(uint32_t history_size) {
+  _history_size.store(history_size, std::memory_order_relaxed);
+}
+
+uint32_t Profiler::zone_id(const char* name) {
+  return intern_zone_name(name).zone_id;
+}
+
+ProfilerThreadBuffer& Profiler::thread_buffer() {
+  thread_local std::vector<std::pair<uint64_t, std::shared_ptr<ProfilerThreadBuffer>>> thread_buffers;
+  for (const auto& entry : thread_buffers) {
+    if (entry.first == _instance_id) {
+      return *entry.second;
+    }
+  }
+
+  // This is the first zone this thread has recorded to this profiler
+  auto buffer = std::make_shared<ProfilerThreadBuffer>();
+  {
+    std::lock_guard<std::mutex> lock{_buffers_mutex};
+    _buffers.push_back(buffer);
+  }
+
+  thread_buffers.emplace_back(_instance_id, buffer);
+  return *buffer;
+}
+
+std::vector<std::shared_ptr<ProfilerThreadBuffer>> Profiler::get_buffers() const {
+  std::lock_guard<std::mutex> lock{_buffers_mutex};
+  return _buffers;
+}
+
+void Profiler::begin_zone(const char* name) {
+  const auto interned = intern_zone_name(name);
+
+  OpenZone zone;
+  zone.zone_id = interned.zone_id;
+  zone.name = interned.name;
+  zone.start_ns = (uint64_t)(now_ns() - _epoch_ns);
+  open_zones.push_back(zone);
+}
+
+void Profiler::end_zone() {
+  const auto end_ns = (uint64_t)(now_ns() - _epoch_ns);
+  if (open_zones.empty()) {
+    return;
+  }
+
+  const auto open_zone = open_zones.back();
+  open_zones.pop_back();
+
+  ProfileZone zone;
+  zone.name = open_zone.name;
+  zone.zone_id = open_zone.zone_id;
+  zone.start_ns = open_zone.start_ns;
+  zone.end_ns = end_ns;
+  zone.thread_id = current_thread_id();
+  zone.depth = (uint32_t)open_zones.size();
+
+  auto& buffer = thread_buffer();
+  std::lock_guard<std::mutex> lock{buffer.mutex};
+
+  // Add it to the ring buffer
+  if (buffer.zones.size() < ZONE_CAPACITY) {
+    buffer.zones.push_back(zone);
+  } else {
+    buffer.zones[buffer.next_zone] = zone;
+  }
+  buffer.next_zone = (buffer.next_zone + 1) % ZONE_CAPACITY;
+  buffer.num_zones = std::min(buffer.num_zones + 1, ZONE_CAPACITY);
+
+  // Add it to the rolling history for its name
+  auto& history = buffer.history[zone.zone_id];
+  const auto history_size = get_history_size();
+  const ZoneSample sample{zone.end_ns, (float)(zone.end_ns - zone.start_ns) / 1000000.f};
+  if (history_size == 0 || history.samples.size() < history_size) {
+    history.samples.push_back(sample);
+  } else {
+    history.samples[history.next % history_size] = sample;
+    history.next = (history.next + 1) % history_size;
+  }
+}
+
+void Profiler::clear() {
+  for (const auto& buffer : get_buffers()) {
+    std::lock_guard<std::mutex> lock{buffer->mutex};
+    buffer->zones.clear();
+    buffer->next_zone = 0;
+    buffer->num_zones = 0;
+    buffer->history.clear();
+  }
+}
+
+size_t Profiler::num_zones() const {
+  size_t num_zones = 0;
+  for (const auto& buffer : get_buffers()) {
+    std::lock_guard<std::mutex> lock{buffer->mutex};
+    num_zones += buffer->num_zones;
+  }
+
+  return num_zones;
+}
+
+void Profiler::enumerate_zones(FunctionView<void(const ProfileZone& zone)> enumerator) const {
+  std::vector<ProfileZone> zones;
+  for (const auto& buffer : get_buffers()) {
+    std::lock_guard<std::mutex> lock{buffer->mutex};
+    zones.insert(zones.end(), buffer->zones.begin(), buffer->zones.end());
+  }
+
+  // Merge the threads' zones in the order they ended
+  std::stable_sort(zones.begin(), zones.end(), [](const ProfileZone& lhs, const ProfileZone& rhs) {
+    return lhs.end_ns < rhs.end_ns;
+  });
+
+  for (const auto& zone : zones) {
+    enumerator(zone);
+  }
+}
+
+void Profiler::enumerate_stats(FunctionView<void(const ProfileZoneStats& stats)> enumerator) const {
+  // Gather the samples of each zone from every thread
+  std::unordered_map<uint32_t, std::vector<ZoneSample>> samples;
+  for (const auto& buffer : get_buffers()) {
+    std::lock_guard<std::mutex> lock{buffer->mutex};
+    for (const auto& entry : buffer->history) {
+      auto& zone_samples = samples[entry.first];
+      zone_samples.insert(zone_samples.end(), entry.second.samples.begin(), entry.second.samples.end());
+    }
+  }
+
+  const auto history_size = get_history_size();
+  std::vector<float> sorted;
+  for (auto& entry : samples) {
+    auto& zone_samples = entry.second;
+    if (zone_samples.empty()) {
+      continue;
+    }
+
+    // Only keep the most recent samples across all threads
+    if (history_size != 0 && zone_samples.size() > history_size) {
+      const auto more_recent = [](const ZoneSample& lhs, const ZoneSample& rhs) {
+        return lhs.end_ns > rhs.end_ns;
+      };
+      std::nth_element(
+          zone_samples.begin(), zone_samples.begin() + history_size, zone_samples.end(), more_recent
+      );
+      zone_samples.resize(history_size);
+    }
+
+    sorted.clear();
+    float total = 0.f;
+    for (const auto& sample : zone_samples) {
+      sorted.push_back(sample.duration_ms);
+      total += sample.duration_ms;
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    const auto count = (uint32_t)sorted.size();
+    ProfileZoneStats stats;
+    stats.name = zone_name(entry.first);
+    stats.num_samples = count;
+    stats.min_ms = sorted[0];
+    stats.avg_ms = total / count;
+    stats.p99_ms = sorted[std::min(count - 1, (uint32_t)(count * 0.99f))];
+    stats.max_ms = sorted[count - 1];
+    enumerator(stats);
+  }
+}
+void Profiler::trace_to_archive(ArchiveWriter& writer) const {
+  writer.as_object();
+  writer.object_member("displayTimeUnit", std::string{"ms"});
+
+  writer.push_object_member("traceEvents");
+  enumerate_zones([&writer](const ProfileZone& zone) {
+    writer.push_array_element();
+    writer.push_object_member("name");
+    writer.string(zone.name, strlen(zone.name));
+    writer.pop();
+    writer.object_member("ph", std::string{"X"});
+    writer.object_member("pid", 0);
+    writer.object_member("tid", zone.thread_id);
+    writer.object_member("ts", (double)zone.start_ns / 1000.0);
+    writer.object_member("dur", (double)(zone.end_ns - zone.start_ns) / 1000.0);
+    writer.pop();
+  });
+  writer.pop();  // "traceEvents"
+}
+
+void Profiler::stats_to_archive(ArchiveWriter& writer) const {
+  writer.as_object();
+
+  enumerate_stats([&writer](const ProfileZoneStats& stats) {
+    writer.push_object_member(stats.name);
+    writer.object_member("samples", stats.num_samples);
+    writer.object_member("min_ms", stats.min_ms);
+    writer.object_member("avg_ms", stats.avg_ms);
+    writer.object_member("p99_ms", stats.p99_ms);
+    writer.object_member("max_ms", stats.max_ms);
+    writer.pop();
+  });
+}
+}  // namespace sge
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "lib/base/build.h"
+#include "lib/base/functional/function_view.h"
+
+namespace sge {
+class ArchiveWriter;
+struct ProfilerThreadBuffer;
+
+/**
+ * \brief A single completed profiling zone.
+ */
+struct ProfileZone {
+  /* Name of the zone, as interned by the profiler. This remains valid for the lifetime of the process. */
+  const char* name;
+
+  /* Id of the zone's name, shared by every zone with an equal name. */
+  uint32_t zone_id;
+
+  /* Start and end time of the zone, in nanoseconds since the profiler was created. */
+  uint64_t start_ns;
+  uint64_t end_ns;
+
+  /* Profiler-assigned id of the thread the zone ran on. */
+  uint32_t thread_id;
+
+  /* Nesting depth of the zone on its thread. */
+  uint32_t depth;
+};
+
+/**
+ * \brief Statistics for all recent zones with the same name, in milliseconds.
+ */
+struct ProfileZoneStats {
+  const char* name;
+  uint32_t num_samples;
+  float min_ms;
+  float avg_ms;
+  float p99_ms;
+  float max_ms;
+};
+
+struct SGE_BASE_EXPORT Profiler {
+  /* Number of completed zones kept in the ring buffer. */
+  static constexpr size_t ZONE_CAPACITY = 1 << 16;
+
+  /* Default number of samples kept per zone name for rolling statistics. */
+  static constexpr uint32_t DEFAULT_HISTORY_SIZE = 256;
+
+  Profiler();
+  Profiler(const Profiler& copy) = delete;
+  Profiler& operator=(const Profiler& copy) = delete;
+
+  /**
+   * \brief Returns the process-wide profiler that profiling zones are recorded to.
+   */
+  static Profiler& global();
+
+  bool is_enabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+  void set_enabled(bool enabled);
+
+  uint32_t get_history_size() const { return _history_size.load(std::memory_order_relaxed); }
+
+  /**
+   * \brief Sets the number of most recent samples per zone name that statistics are computed over.
+   * Zero keeps every sample until the profiler is cleared.
+   */
+  void set_history_size(uint32_t history_size);
+
+  /**
+   * \brief Returns the id shared by every zone with the given name, interning the name if it's new.
+   */
+  static uint32_t zone_id(const char* name);
+
+  /**
+   * \brief Opens a zone on the calling thread. Zones must be closed in the reverse order they were opened.
+   * \param name The name of the zone. This is copied, so it only needs to remain valid for this call.
+   */
+  void begin_zone(const char* name);
+
+  /**
+   * \brief Closes the most recently opened zone on the calling thread.
+   */
+  void end_zone();
+
+  /**
+   * \brief Removes all recorded zones and statistics.
+   */
+  void clear();
+
+  /**
+   * \brief Returns the number of zones currently held in the ring buffer.
+   */
+  size_t num_zones() const;
+
+  /**
+   * \brief Calls the given function for each zone in the ring buffer, oldest first.
+   */
+  void enumerate_zones(FunctionView<void(const ProfileZone& zone)> enumerator) const;
+
+  /**
+   * \brief Calls the given function with the rolling statistics for each zone name.
+   */
+  void enumerate_stats(FunctionView<void(const ProfileZoneStats& stats)> enumerator) const;
+
+  /**
+   * \brief Serializes the ring buffer as Chrome trace-event JSON (viewable in chrome://tracing or Perfetto).
+   */
+  void trace_to_archive(ArchiveWriter& writer) const;
+
+  /**
+   * \brief Serializes the rolling statistics as an object mapping zone names to min/avg/p99/max.
+   */
+  void stats_to_archive(ArchiveWriter& writer) const;
+
+ private:
+  ProfilerThreadBuffer& thread_buffer();
+
+  std::vector<std::shared_ptr<ProfilerThreadBuffer>> get_buffers() const;
+
+  std::atomic<bool> _enabled;
+  std::atomic<uint32_t> _history_size;
+  uint64_t _instance_id;
+  int64_t _epoch_ns;
+
+  /* Zones are recorded to a buffer owned by the thread they ran on, so threads don't contend when closing
+   * them. Buffers are kept after their thread exits. */
+  mutable std::mutex _buffers_mutex;
+  std::vector<std::shared_ptr<ProfilerThreadBuffer>> _buffers;
+};
+
+/**
+ * \brief Opens a zone on the global profiler for the lifetime of this object.
+ */
+struct ProfileScope {
+  explicit ProfileScope(const char* name) : _active(Profiler::global().is_enabled()) {
+    if (_active) {
+      Profiler::global().begin_zone(name);
+    }
+  }
+  ProfileScope(const ProfileScope& copy) = delete;
+  ProfileScope& operator=(const ProfileScope& copy) = delete;
+
+  ~ProfileScope() {
+    if (_active) {
+      Profiler::global().end_zone();
+    }
+  }
+
+ private:
+  bool _active;
+};
+}  // namespace sge
+
+#define SGE_PROFILE_CONCAT_IMPL(A, B) A##B
+#define SGE_PROFILE_CONCAT(A, B) SGE_PROFILE_CONCAT_IMPL(A, B)
+
+/* Profiles the rest of the enclosing scope as a zone with the given name. */
+#define SGE_PROFILE_SCOPE(NAME) ::sge::ProfileScope SGE_PROFILE_CONCAT(sge_profile_scope_, __LINE__){NAME}
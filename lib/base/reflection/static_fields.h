@@ -0,0 +1,254 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "lib/base/io/archive_reader.h"
+#include "lib/base/io/archive_writer.h"
+#include "lib/base/math/angle.h"
+#include "lib/base/math/quat.h"
+#include "lib/base/math/vec3.h"
+
+namespace sge {
+/**
+ * \brief A field that is known at compile time, as a pointer-to-member and the name it's serialized with.
+ * Unlike the fields and properties registered on a TypeInfo, these are serialized without going through
+ * 'Any' or any virtual calls.
+ */
+template <typename T, typename FieldT>
+struct StaticField {
+  using Object_t = T;
+  using Field_t = FieldT;
+
+  const char* name;
+  FieldT T::*member;
+};
+
+/**
+ * \brief Creates a StaticField for the given member.
+ */
+template <typename T, typename FieldT>
+constexpr StaticField<T, FieldT> static_field(const char* name, FieldT T::*member) {
+  return StaticField<T, FieldT>{name, member};
+}
+
+/**
+ * \brief Creates a list of StaticFields, to be passed to the 'fields_*' functions below. Components return
+ * one of these from a static 'archive_fields()' to list the fields their 'to_archive' and 'from_archive'
+ * serialize. Component containers then serialize those fields as columns in packed scenes, rather than per
+ * instance.
+ */
+template <typename... FieldTs>
+constexpr std::tuple<FieldTs...> static_fields(FieldTs... fields) {
+  return std::tuple<FieldTs...>{fields...};
+}
+
+/**
+ * \brief Describes how a field type is stored as a column, which is a typed array holding the field for
+ * every object in turn. Each field is stored as 'ELEMS' consecutive elements of type 'Elem_t'.
+ */
+template <typename FieldT, typename Enable = void>
+struct FieldColumn {
+  static constexpr bool SUPPORTED = false;
+};
+
+template <typename FieldT>
+struct FieldColumn<FieldT, std::enable_if_t<std::is_arithmetic<FieldT>::value>> {
+  static constexpr bool SUPPORTED = true;
+  using Elem_t = std::conditional_t<std::is_same<FieldT, bool>::value, uint8_t, FieldT>;
+  static constexpr size_t ELEMS = 1;
+
+  static void store(const FieldT& value, Elem_t* out) { out[0] = (Elem_t)value; }
+
+  static void load(FieldT& value, const Elem_t* elems) { value = (FieldT)elems[0]; }
+};
+
+template <>
+struct FieldColumn<Angle> {
+  static constexpr bool SUPPORTED = true;
+  using Elem_t = float;
+  static constexpr size_t ELEMS = 1;
+
+  static void store(const Angle& value, float* out) { out[0] = value.radians(); }
+
+  static void load(Angle& value, const float* elems) { value.radians(elems[0]); }
+};
+
+template <>
+struct FieldColumn<Vec3> {
+  static constexpr bool SUPPORTED = true;
+  using Elem_t = float;
+  static constexpr size_t ELEMS = 3;
+
+  static void store(const Vec3& value, float* out) {
+    out[0] = value.x();
+    out[1] = value.y();
+    out[2] = value.z();
+  }
+
+  static void load(Vec3& value, const float* elems) { value = Vec3{elems[0], elems[1], elems[2]}; }
+};
+
+template <>
+struct FieldColumn<Quat> {
+  static constexpr bool SUPPORTED = true;
+  using Elem_t = float;
+  static constexpr size_t ELEMS = 4;
+
+  static void store(const Quat& value, float* out) {
+    out[0] = value.x();
+    out[1] = value.y();
+    out[2] = value.z();
+    out[3] = value.w();
+  }
+
+  static void load(Quat& value, const float* elems) { value = Quat{elems[0], elems[1], elems[2], elems[3]}; }
+};
+
+/**
+ * \brief Whether every field in the given list of StaticFields may be stored as a column.
+ */
+template <typename FieldsT>
+struct FieldsSupportColumns;
+
+template <typename... FieldTs>
+struct FieldsSupportColumns<std::tuple<FieldTs...>>
+    : std::bool_constant<(FieldColumn<typename FieldTs::Field_t>::SUPPORTED && ...)> {};
+
+/**
+ * \brief Serializes the given fields of an object as members of an object.
+ */
+template <typename T, typename... FieldTs>
+void fields_to_archive(const T& object, const std::tuple<FieldTs...>& fields, ArchiveWriter& writer) {
+  writer.as_object();
+  std::apply(
+      [&object, &writer](const auto&... field) {
+        (writer.object_member(field.name, object.*field.member), ...);
+      },
+      fields
+  );
+}
+
+/**
+ * \brief Deserializes the given fields of an object from members of an object. Missing members are left as
+ * they are.
+ */
+template <typename T, typename... FieldTs>
+void fields_from_archive(T& object, const std::tuple<FieldTs...>& fields, ArchiveReader& reader) {
+  std::apply(
+      [&object, &reader](const auto&... field) {
+        (reader.object_member(field.name, object.*field.member), ...);
+      },
+      fields
+  );
+}
+
+/* Writes a single column for 'field_columns_to_archive'. */
+template <typename T, typename FieldT>
+void write_field_column(
+    const T* const* objects,
+    size_t num_objects,
+    const StaticField<T, FieldT>& field,
+    ArchiveWriter& writer
+) {
+  using Column_t = FieldColumn<FieldT>;
+  std::vector<typename Column_t::Elem_t> column(num_objects * Column_t::ELEMS);
+  for (size_t i = 0; i < num_objects; ++i) {
+    Column_t::store(objects[i]->*field.member, column.data() + i * Column_t::ELEMS);
+  }
+
+  writer.push_object_member(field.name);
+  writer.typed_array(column.data(), column.size());
+  writer.pop();
+}
+
+/* Reads a single column for 'field_columns_from_archive', from the reader's current node. */
+template <typename T, typename FieldT>
+void read_field_column(
+    T* const* objects,
+    size_t num_objects,
+    const StaticField<T, FieldT>& field,
+    ArchiveReader& reader
+) {
+  using Column_t = FieldColumn<FieldT>;
+  using Elem_t = typename Column_t::Elem_t;
+
+  // Read the column in place if possible, otherwise copy it out
+  const Elem_t* column = nullptr;
+  size_t size = 0;
+  std::vector<Elem_t> copy;
+  if (!reader.typed_array_view(column, size)) {
+    reader.array_size(size);
+    copy.resize(size);
+    size = reader.typed_array(copy.data(), copy.size());
+    column = copy.data();
+  }
+
+  if (size == num_objects * Column_t::ELEMS) {
+    for (size_t i = 0; i < num_objects; ++i) {
+      if (objects[i]) {
+        Column_t::load(objects[i]->*field.member, column + i * Column_t::ELEMS);
+      }
+    }
+  }
+}
+
+/**
+ * \brief Serializes the given fields of a sequence of objects as columns, with each column written as a
+ * member of an object.
+ * \param objects The objects to serialize.
+ * \param num_objects The number of objects to serialize.
+ * \param fields The fields to serialize.
+ * \param writer The writer to serialize the columns to.
+ */
+template <typename T, typename... FieldTs>
+void field_columns_to_archive(
+    const T* const* objects,
+    size_t num_objects,
+    const std::tuple<FieldTs...>& fields,
+    ArchiveWriter& writer
+) {
+  writer.as_object();
+  std::apply(
+      [objects, num_objects, &writer](const auto&... field) {
+        (write_field_column(objects, num_objects, field, writer), ...);
+      },
+      fields
+  );
+}
+
+/**
+ * \brief Deserializes the given fields of a sequence of objects from columns, with each column read from
+ * a member of an object. Columns that are missing, or that don't match the number of objects, are ignored.
+ * \param objects The objects to deserialize. Null objects are skipped.
+ * \param num_objects The number of objects to deserialize.
+ * \param fields The fields to deserialize.
+ * \param reader The reader to deserialize the columns from.
+ */
+template <typename T, typename... FieldTs>
+void field_columns_from_archive(
+    T* const* objects,
+    size_t num_objects,
+    const std::tuple<FieldTs...>& fields,
+    ArchiveReader& reader
+) {
+  // The columns are enumerated rather than pulled by name, so streaming readers parse one at a time
+  reader.enumerate_object_members([objects, num_objects, &fields, &reader](const char* name) {
+    std::apply(
+        [objects, num_objects, &reader, name](const auto&... field) {
+          const auto read_if_named = [&](const auto& column_field) {
+            if (strcmp(name, column_field.name) == 0) {
+              read_field_column(objects, num_objects, column_field, reader);
+            }
+          };
+          (read_if_named(field), ...);
+        },
+        fields
+    );
+  });
+}
+}  // namespace sge
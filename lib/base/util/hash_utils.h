@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace sge {
+static constexpr uint64_t HASH_BYTES_SEED = 0xcbf29ce484222325;
+
+/**
+ * \brief Hashes the given bytes, continuing from the given hash. This is FNV-1a over whole words, which makes
+ * it cheap enough for checking large files for changes, but it must not be used where collisions matter.
+ * \param hash The hash to continue from, or 'HASH_BYTES_SEED' to start a new one.
+ * \param data The bytes to hash.
+ * \param size The number of bytes to hash.
+ */
+inline uint64_t hash_bytes(uint64_t hash, const void* data, size_t size) {
+  constexpr uint64_t FNV_PRIME = 0x100000001b3;
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), bytes += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes, sizeof(uint64_t));
+    hash = (hash ^ word) * FNV_PRIME;
+  }
+  for (; size > 0; --size, ++bytes) {
+    hash = (hash ^ *bytes) * FNV_PRIME;
+  }
+
+  return hash;
+}
+}  // namespace sge
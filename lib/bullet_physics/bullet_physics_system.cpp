@@ -123,6 +123,7 @@ BulletPhysicsSystem::~BulletPhysicsSystem() {}
 
 void BulletPhysicsSystem::register_pipeline(UpdatePipeline& pipeline) {
   pipeline.register_system_fn("bullet_physics", this, &BulletPhysicsSystem::phys_tick);
+  pipeline.set_system_fixed_rate("bullet_physics", true);
 
   pipeline.register_system_fn("bullet_physics_debug_draw", this, &BulletPhysicsSystem::debug_draw);
 }
@@ -301,8 +302,13 @@ void BulletPhysicsSystem::consume_events(Scene& scene) {
 void BulletPhysicsSystem::phys_tick(Scene& scene, SystemFrame& frame) {
   consume_events(scene);
 
-  // Simulate physics
-  _data->phys_world.dynamics_world().stepSimulation(frame.time_delta(), 3);
+  // Simulate physics. When running at the fixed rate, take exactly one step (the engine interpolates for
+  // rendering), otherwise let bullet substep.
+  if (frame.is_fixed_tick()) {
+    _data->phys_world.dynamics_world().stepSimulation(frame.time_delta(), 0);
+  } else {
+    _data->phys_world.dynamics_world().stepSimulation(frame.time_delta(), 3);
+  }
 
   // Update scene transforms
   const size_t num_transforms = _data->frame_transformed_nodes.size();
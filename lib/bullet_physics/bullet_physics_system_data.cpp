@@ -1,31 +1,25 @@
 #include "lib/bullet_physics/bullet_physics_system_data.h"
 #include "lib/bullet_physics/colliders.h"
 #include "lib/bullet_physics/physics_entity.h"
+#include "lib/bullet_physics/static_mesh_bvh.h"
 #include "lib/bullet_physics/util.h"
+#include "lib/resource/cache/resource_cache.h"
 #include "lib/resource/resources/static_mesh.h"
 
 namespace sge {
 namespace bullet_physics {
 static std::unique_ptr<StaticMeshCollider>
-create_static_mesh_collider_mesh(std::string path, const StaticMesh& mesh) {
-  const auto num_verts = mesh.num_verts();
-  const auto num_triangles = mesh.num_triangles();
-  const auto* const vert_positions = mesh.vertex_positions();
-  const auto* const triangle_elements = mesh.triangle_elements();
-
-  // Build the mesh
+create_static_mesh_collider_mesh(std::string path, std::shared_ptr<const StaticMesh> mesh) {
+  // Point Bullet straight at the mesh's positions and triangle elements, rather than copying them
   auto bt_mesh = std::make_unique<StaticMeshCollider>();
-  bt_mesh->path = std::move(path);
-  bt_mesh->mesh.preallocateVertices((int)num_verts);
-  for (size_t i = 0; i < num_triangles; ++i) {
-    bt_mesh->mesh.addTriangle(
-        to_bullet(vert_positions[triangle_elements[i * 3 + 0]]),
-        to_bullet(vert_positions[triangle_elements[i * 3 + 1]]),
-        to_bullet(vert_positions[triangle_elements[i * 3 + 2]])
-    );
-  }
-  bt_mesh->init_shape();
+  bt_mesh->mesh.addIndexedMesh(static_mesh_indexed_mesh(*mesh), PHY_INTEGER);
 
+  // Use the precooked BVH if it's up to date, otherwise build it
+  auto* const bvh = load_static_mesh_bvh(path, *mesh, bt_mesh->bvh_buffer);
+  bt_mesh->init_shape(bvh);
+
+  bt_mesh->path = std::move(path);
+  bt_mesh->source_mesh = std::move(mesh);
   return bt_mesh;
 }
 
@@ -127,14 +121,14 @@ StaticMeshCollider* BulletPhysicsSystem::Data::get_static_mesh_collider(const st
     return ptr;
   }
 
-  // Load the mesh
-  StaticMesh mesh;
-  if (!mesh.from_file(path.c_str())) {
+  // Get the mesh from the resource cache, which shares it with the renderer
+  auto mesh = ResourceCache::global().get_static_mesh(path);
+  if (!mesh) {
     return nullptr;
   }
 
   // Create the collider
-  auto collider = create_static_mesh_collider_mesh(path, mesh);
+  auto collider = create_static_mesh_collider_mesh(path, std::move(mesh));
   auto* const ptr = collider.get();
 
   // Insert it into the table
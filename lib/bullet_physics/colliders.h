@@ -1,15 +1,26 @@
 #pragma once
 
 #include <stdint.h>
+#include <memory>
 
 #include "lib/bullet_physics/bullet_physics_system_data.h"
+#include "lib/resource/resources/static_mesh.h"
 
 namespace sge {
 namespace bullet_physics {
 struct StaticMeshCollider {
-  ~StaticMeshCollider() { get_mesh_shape()->~btBvhTriangleMeshShape(); }
-
-  void init_shape() { new (_buffer) btBvhTriangleMeshShape{&mesh, true}; }
+  ~StaticMeshCollider() {
+    get_mesh_shape()->~btBvhTriangleMeshShape();
+    btAlignedFree(bvh_buffer);
+  }
+
+  /* Creates the shape, using the given precooked BVH if there is one, or otherwise building it. */
+  void init_shape(btOptimizedBvh* bvh) {
+    auto* const shape = new (_buffer) btBvhTriangleMeshShape{&mesh, true, bvh == nullptr};
+    if (bvh) {
+      shape->setOptimizedBvh(bvh);
+    }
+  }
 
   btBvhTriangleMeshShape* get_mesh_shape() { return reinterpret_cast<btBvhTriangleMeshShape*>(_buffer); }
 
@@ -19,8 +30,14 @@ struct StaticMeshCollider {
   /* The number of uses of this collider. */
   uint64_t num_uses = 0;
 
+  /* The mesh this collider was created from, which is kept alive since 'mesh' points into its data. */
+  std::shared_ptr<const StaticMesh> source_mesh;
+
   /* The shape itself. */
-  btTriangleMesh mesh;
+  btTriangleIndexVertexArray mesh;
+
+  /* Buffer holding the precooked BVH the shape was created with, if any. */
+  void* bvh_buffer = nullptr;
 
  private:
   alignas(alignof(btBvhTriangleMeshShape)) char _buffer[sizeof(btBvhTriangleMeshShape)];
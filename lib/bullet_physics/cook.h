@@ -0,0 +1,15 @@
+#pragma once
+
+#include "lib/bullet_physics/build.h"
+
+namespace sge {
+namespace bullet_physics {
+/**
+ * \brief Builds the collision BVH for the static mesh at the given path, and writes it to a sidecar file next
+ * to the mesh, so that static mesh colliders using it don't need to build it when loaded.
+ * \param mesh_path The path of the static mesh.
+ * \return Whether the mesh was loaded and its BVH was written.
+ */
+SGE_BULLET_PHYSICS_API bool cook_static_mesh_bvh(const char* mesh_path);
+}  // namespace bullet_physics
+}  // namespace sge
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "lib/base/util/hash_utils.h"
+#include "lib/bullet_physics/cook.h"
+#include "lib/bullet_physics/static_mesh_bvh.h"
+#include "lib/resource/cache/resource_cache.h"
+#include "lib/resource/sources/resource_source.h"
+
+namespace sge {
+namespace bullet_physics {
+static constexpr uint8_t STATIC_MESH_BVH_MAGIC[4] = {'S', 'G', 'E', 'B'};
+
+/* Incremented whenever the way BVHs are built or serialized changes, invalidating existing files. */
+static constexpr uint32_t STATIC_MESH_BVH_VERSION = 1;
+
+/* Alignment required by Bullet for BVHs serialized in place. */
+static constexpr size_t STATIC_MESH_BVH_ALIGNMENT = 16;
+
+static uint64_t hash_mesh(const StaticMesh& mesh) {
+  const uint64_t counts[2] = {mesh.num_verts(), mesh.num_triangle_elements()};
+  auto hash = hash_bytes(HASH_BYTES_SEED, counts, sizeof(counts));
+  hash = hash_bytes(hash, mesh.vertex_positions(), mesh.num_verts() * sizeof(Vec3));
+  return hash_bytes(hash, mesh.triangle_elements(), mesh.num_triangle_elements() * sizeof(uint32_t));
+}
+
+btIndexedMesh static_mesh_indexed_mesh(const StaticMesh& mesh) {
+  btIndexedMesh indexed_mesh;
+  indexed_mesh.m_numTriangles = (int)mesh.num_triangles();
+  indexed_mesh.m_triangleIndexBase = reinterpret_cast<const unsigned char*>(mesh.triangle_elements());
+  indexed_mesh.m_triangleIndexStride = 3 * sizeof(uint32_t);
+  indexed_mesh.m_numVertices = (int)mesh.num_verts();
+  indexed_mesh.m_vertexBase = reinterpret_cast<const unsigned char*>(mesh.vertex_positions());
+  indexed_mesh.m_vertexStride = sizeof(Vec3);
+  indexed_mesh.m_indexType = PHY_INTEGER;
+  indexed_mesh.m_vertexType = PHY_FLOAT;
+  return indexed_mesh;
+}
+
+btOptimizedBvh*
+load_static_mesh_bvh(const std::string& mesh_path, const StaticMesh& mesh, void*& out_buffer) {
+  out_buffer = nullptr;
+  const auto bvh_path = mesh_path + STATIC_MESH_BVH_SUFFIX;
+  ResourceData resource;
+  if (!open_resource(bvh_path.c_str(), true, resource)) {
+    return nullptr;
+  }
+
+  // Make sure the BVH was cooked on this platform, from the current version of the mesh
+  StaticMeshBvhHeader header;
+  if (resource.size >= sizeof(header)) {
+    memcpy(&header, resource.data, sizeof(header));
+  }
+
+  const bool valid = resource.size >= sizeof(header) &&
+                     memcmp(header.magic, STATIC_MESH_BVH_MAGIC, sizeof(header.magic)) == 0 &&
+                     header.version == STATIC_MESH_BVH_VERSION && header.pointer_size == sizeof(void*) &&
+                     header.scalar_size == sizeof(btScalar) && header.bvh_size <= UINT32_MAX &&
+                     header.bvh_size <= resource.size - sizeof(header) &&
+                     header.mesh_hash == hash_mesh(mesh);
+  if (!valid) {
+    printf("WARNING, BulletPhysicsSystem: Ignoring out of date BVH '%s'\n", bvh_path.c_str());
+    return nullptr;
+  }
+
+  // Copy the BVH into an aligned buffer, and fix it up in place
+  auto* const buffer = btAlignedAlloc((size_t)header.bvh_size, STATIC_MESH_BVH_ALIGNMENT);
+  memcpy(buffer, resource.data + sizeof(header), (size_t)header.bvh_size);
+  auto* const bvh = btOptimizedBvh::deSerializeInPlace(buffer, (unsigned)header.bvh_size, false);
+  if (!bvh) {
+    btAlignedFree(buffer);
+    return nullptr;
+  }
+
+  out_buffer = buffer;
+  return bvh;
+}
+
+bool save_static_mesh_bvh(const std::string& mesh_path, const StaticMesh& mesh, const btOptimizedBvh& bvh) {
+  // Serialize the BVH into an aligned buffer
+  const auto bvh_size = bvh.calculateSerializeBufferSize();
+  auto* const buffer = btAlignedAlloc(bvh_size, STATIC_MESH_BVH_ALIGNMENT);
+  if (!bvh.serializeInPlace(buffer, bvh_size, false)) {
+    btAlignedFree(buffer);
+    return false;
+  }
+
+  StaticMeshBvhHeader header;
+  memcpy(header.magic, STATIC_MESH_BVH_MAGIC, sizeof(header.magic));
+  header.version = STATIC_MESH_BVH_VERSION;
+  header.pointer_size = sizeof(void*);
+  header.scalar_size = sizeof(btScalar);
+  header.mesh_hash = hash_mesh(mesh);
+  header.bvh_size = bvh_size;
+
+  // Write it out
+  const auto bvh_path = mesh_path + STATIC_MESH_BVH_SUFFIX;
+  auto* const file = fopen(bvh_path.c_str(), "wb");
+  bool written = false;
+  if (file) {
+    written = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(buffer, 1, bvh_size, file) == bvh_size;
+    written = fclose(file) == 0 && written;
+  }
+
+  btAlignedFree(buffer);
+  return written;
+}
+
+bool cook_static_mesh_bvh(const char* mesh_path) {
+  const auto mesh = ResourceCache::global().get_static_mesh(mesh_path);
+  if (!mesh) {
+    return false;
+  }
+
+  // Build the BVH the same way static mesh colliders do
+  btTriangleIndexVertexArray mesh_interface;
+  mesh_interface.addIndexedMesh(static_mesh_indexed_mesh(*mesh), PHY_INTEGER);
+  btBvhTriangleMeshShape shape{&mesh_interface, true};
+
+  return save_static_mesh_bvh(mesh_path, *mesh, *shape.getOptimizedBvh());
+}
+}  // namespace bullet_physics
+}  // namespace sge
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include <btBulletCollisionCommon.h>
+
+#include "lib/resource/resources/static_mesh.h"
+
+namespace sge {
+namespace bullet_physics {
+/* Suffix appended to a static mesh's path to get the path of its precooked BVH. */
+static constexpr char STATIC_MESH_BVH_SUFFIX[] = ".bvh";
+
+/* Header at the start of a precooked BVH file, followed by the BVH as serialized in place by Bullet. Since
+ * that is a memory image of the BVH, the file is only usable on platforms matching the one it was cooked on. */
+struct StaticMeshBvhHeader {
+  uint8_t magic[4];
+  uint32_t version;
+
+  /* Layout of the platform the BVH was cooked on. */
+  uint32_t pointer_size;
+  uint32_t scalar_size;
+
+  /* Hash of the mesh geometry the BVH was built from, to detect BVHs that are out of date. */
+  uint64_t mesh_hash;
+
+  /* Size of the serialized BVH following this header. */
+  uint64_t bvh_size;
+};
+static_assert(sizeof(StaticMeshBvhHeader) % 16 == 0, "Serialized BVHs must stay 16-byte aligned");
+
+/**
+ * \brief Describes the vertex positions and triangle elements of the given mesh to Bullet, without copying
+ * them. The mesh must outlive any use of the result.
+ */
+btIndexedMesh static_mesh_indexed_mesh(const StaticMesh& mesh);
+
+/**
+ * \brief Loads the precooked BVH for the static mesh at the given path, if there is one and it's up to date.
+ * \param mesh_path The path of the static mesh.
+ * \param mesh The static mesh, to check the BVH against.
+ * \param out_buffer Set to the buffer holding the BVH, which must be freed with 'btAlignedFree' once the BVH
+ * is no longer used.
+ * \return The BVH, or null if it's missing, out of date, or was cooked on a different platform.
+ */
+btOptimizedBvh* load_static_mesh_bvh(const std::string& mesh_path, const StaticMesh& mesh, void*& out_buffer);
+
+/**
+ * \brief Writes the precooked BVH for the static mesh at the given path.
+ * \param mesh_path The path of the static mesh.
+ * \param mesh The static mesh the BVH was built from.
+ * \param bvh The BVH to write.
+ * \return Whether the file was written.
+ */
+bool save_static_mesh_bvh(const std::string& mesh_path, const StaticMesh& mesh, const btOptimizedBvh& bvh);
+}  // namespace bullet_physics
+}  // namespace sge
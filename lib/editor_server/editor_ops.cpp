@@ -13,6 +13,7 @@
 #include "lib/base/reflection/type_info.h"
 #include "lib/engine/components/display/static_mesh.h"
 #include "lib/engine/scene.h"
+#include "lib/engine/scene_file.h"
 // #include "lib/lightmapper/lightmapper.h"
 #include "lib/resource/archives/binary_archive.h"
 #include "lib/resource/archives/json_archive.h"
@@ -535,16 +536,12 @@ void save_scene_query(const Scene& scene, ArchiveReader& reader) {
     return;
   }
 
-  // Create an output archive
-  JsonArchive output;
-  auto* writer = output.write_root();
-
-  // Save the scene
-  scene.to_archive(*writer);
-  writer->pop();
+  // Save the scene ('.sbin' scenes are streamed straight to the file, in the packed layout)
+  if (!save_scene_file(scene, path.c_str())) {
+    std::cout << "Could not save scene to '" << path << "'" << std::endl;
+    return;
+  }
 
-  // Save the archive to a file
-  output.to_file(path.c_str());
   std::cout << "Saved scene to '" << path << "'" << std::endl;
 }
 
@@ -1,6 +1,7 @@
 #include <stdint.h>
 
 #include "lib/editor_server/editor_server_system_data.h"
+#include "lib/engine/system_frame.h"
 #include "lib/engine/update_pipeline.h"
 
 namespace sge {
@@ -12,6 +13,8 @@ EditorServerSystem::~EditorServerSystem() {}
 
 void EditorServerSystem::register_pipeline(UpdatePipeline& pipeline) {
   pipeline.register_system_fn("editor_server_serve", this, &EditorServerSystem::serve_fn);
+  _pipeline = &pipeline;
+  _pipeline->set_system_budget("editor_server_serve", (float)_serve_time_ms);
 }
 
 int EditorServerSystem::get_serve_time() const {
@@ -20,12 +23,20 @@ int EditorServerSystem::get_serve_time() const {
 
 void EditorServerSystem::set_serve_time(int milliseconds) {
   _serve_time_ms = milliseconds;
+
+  if (_pipeline) {
+    _pipeline->set_system_budget("editor_server_serve", (float)milliseconds);
+  }
 }
 
 void EditorServerSystem::serve_fn(Scene& scene, SystemFrame& frame) {
   // Run the service
   _data->frame = &frame;
   _data->scene = &scene;
-  _data->io.poll();
+
+  // Run ready handlers until there are none left or the budget is used up. At least one handler is always
+  // run, so that queries still make progress after an overrun.
+  while (_data->io.poll_one() != 0 && !frame.past_deadline()) {
+  }
 }
 }  // namespace sge
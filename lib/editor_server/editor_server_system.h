@@ -19,12 +19,17 @@ struct SGE_EDITORSERVERSYSTEM_API EditorServerSystem {
 
   int get_serve_time() const;
 
+  /**
+   * \brief Sets the time that may be spent serving requests each frame, in milliseconds.
+   * Zero removes the limit, so that every ready request is served before the frame continues.
+   */
   void set_serve_time(int milliseconds);
 
  private:
   void serve_fn(Scene& scene, SystemFrame& frame);
 
   int _serve_time_ms;
+  UpdatePipeline* _pipeline = nullptr;
   std::unique_ptr<Data> _data;
 };
 }  // namespace sge
@@ -72,10 +72,8 @@ void Session::async_receive_message() {
         const auto message_time = std::chrono::system_clock::now();
         std::cout << "Received query at " << std::chrono::system_clock::to_time_t(message_time) << std::endl;
 
-        // Deserialze the query json string
-        JsonArchive query_archive;
-        query_archive.from_string(self->_in_content.c_str());
-        auto* const query_reader = query_archive.read_root();
+        // Deserialze the query json string, in place since the content buffer isn't needed afterwards
+        auto* const query_reader = JsonArchive::read_string_streaming(&self->_in_content[0]);
 
         // Create a global client output archive
         JsonArchive global_response_archive;
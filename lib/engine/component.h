@@ -20,6 +20,12 @@ class SGE_ENGINE_API ComponentContainer {
 
   virtual void to_archive(ArchiveWriter& writer) const = 0;
 
+  /**
+   * \brief Serializes all instances in a compact layout, where instance nodes are stored in a typed array
+   * rather than as member names. 'from_archive' accepts either layout.
+   */
+  virtual void to_packed_archive(ArchiveWriter& writer) const = 0;
+
   virtual void from_archive(ArchiveReader& reader) = 0;
 
   virtual void on_end_system_frame() = 0;
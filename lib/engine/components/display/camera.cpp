@@ -22,15 +22,11 @@ void CPerspectiveCamera::register_type(Scene& scene) {
 }
 
 void CPerspectiveCamera::to_archive(ArchiveWriter& writer) const {
-  writer.object_member("h_fov", _h_fov);
-  writer.object_member("z_min", _z_min);
-  writer.object_member("z_max", _z_max);
+  fields_to_archive(*this, archive_fields(), writer);
 }
 
 void CPerspectiveCamera::from_archive(ArchiveReader& reader) {
-  reader.object_member("h_fov", _h_fov);
-  reader.object_member("z_min", _z_min);
-  reader.object_member("z_max", _z_max);
+  fields_from_archive(*this, archive_fields(), reader);
 }
 
 NodeId CPerspectiveCamera::node() const {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "lib/base/math/mat4.h"
+#include "lib/base/reflection/static_fields.h"
 #include "lib/engine/component.h"
 
 namespace sge {
@@ -12,6 +13,14 @@ struct SGE_ENGINE_API CPerspectiveCamera {
 
   static void register_type(Scene& scene);
 
+  static constexpr auto archive_fields() {
+    return static_fields(
+        static_field("h_fov", &CPerspectiveCamera::_h_fov),
+        static_field("z_min", &CPerspectiveCamera::_z_min),
+        static_field("z_max", &CPerspectiveCamera::_z_max)
+    );
+  }
+
   void to_archive(ArchiveWriter& writer) const;
 
   void from_archive(ArchiveReader& reader);
@@ -30,26 +30,11 @@ void CAnimation::register_type(Scene& scene) {
 }
 
 void CAnimation::to_archive(ArchiveWriter& writer) const {
-  writer.as_object();
-  writer.object_member("index", _index);
-  writer.object_member("duration", _duration);
-  writer.object_member("anim_pos", _animate_position);
-  writer.object_member("anim_rot", _animate_rotation);
-  writer.object_member("init_pos", _init_position);
-  writer.object_member("targ_pos", _target_position);
-  writer.object_member("init_rot", _init_rotation);
-  writer.object_member("targ_rot", _target_rotation);
+  fields_to_archive(*this, archive_fields(), writer);
 }
 
 void CAnimation::from_archive(ArchiveReader& reader) {
-  reader.object_member("index", _index);
-  reader.object_member("duration", _duration);
-  reader.object_member("anim_pos", _animate_position);
-  reader.object_member("anim_rot", _animate_rotation);
-  reader.object_member("init_pos", _init_position);
-  reader.object_member("targ_pos", _target_position);
-  reader.object_member("init_rot", _init_rotation);
-  reader.object_member("targ_rot", _target_rotation);
+  fields_from_archive(*this, archive_fields(), reader);
 }
 
 NodeId CAnimation::node() const {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "lib/base/reflection/static_fields.h"
 #include "lib/engine/component.h"
 
 namespace sge {
@@ -11,6 +12,19 @@ struct SGE_ENGINE_API CAnimation {
 
   static void register_type(Scene& scene);
 
+  static constexpr auto archive_fields() {
+    return static_fields(
+        static_field("index", &CAnimation::_index),
+        static_field("duration", &CAnimation::_duration),
+        static_field("anim_pos", &CAnimation::_animate_position),
+        static_field("anim_rot", &CAnimation::_animate_rotation),
+        static_field("init_pos", &CAnimation::_init_position),
+        static_field("targ_pos", &CAnimation::_target_position),
+        static_field("init_rot", &CAnimation::_init_rotation),
+        static_field("targ_rot", &CAnimation::_target_rotation)
+    );
+  }
+
   void to_archive(ArchiveWriter& writer) const;
 
   void from_archive(ArchiveReader& reader);
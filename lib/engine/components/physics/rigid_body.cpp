@@ -25,23 +25,11 @@ void CRigidBody::register_type(Scene& scene) {
 }
 
 void CRigidBody::to_archive(ArchiveWriter& writer) const {
-  writer.object_member("k", _kinematic);
-  writer.object_member("m", _mass);
-  writer.object_member("f", _friction);
-  writer.object_member("rf", _rolling_friction);
-  writer.object_member("sf", _spinning_friction);
-  writer.object_member("lin", _linear_damping);
-  writer.object_member("ang", _angular_damping);
+  fields_to_archive(*this, archive_fields(), writer);
 }
 
 void CRigidBody::from_archive(ArchiveReader& reader) {
-  reader.object_member("k", _kinematic);
-  reader.object_member("m", _mass);
-  reader.object_member("f", _friction);
-  reader.object_member("rf", _rolling_friction);
-  reader.object_member("sf", _spinning_friction);
-  reader.object_member("lin", _linear_damping);
-  reader.object_member("ang", _angular_damping);
+  fields_from_archive(*this, archive_fields(), reader);
 }
 
 NodeId CRigidBody::node() const {
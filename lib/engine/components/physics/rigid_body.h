@@ -1,5 +1,6 @@
 #pragma once
 
+#include "lib/base/reflection/static_fields.h"
 #include "lib/engine/component.h"
 
 namespace sge {
@@ -11,6 +12,18 @@ struct SGE_ENGINE_API CRigidBody {
 
   static void register_type(Scene& scene);
 
+  static constexpr auto archive_fields() {
+    return static_fields(
+        static_field("k", &CRigidBody::_kinematic),
+        static_field("m", &CRigidBody::_mass),
+        static_field("f", &CRigidBody::_friction),
+        static_field("rf", &CRigidBody::_rolling_friction),
+        static_field("sf", &CRigidBody::_spinning_friction),
+        static_field("lin", &CRigidBody::_linear_damping),
+        static_field("ang", &CRigidBody::_angular_damping)
+    );
+  }
+
   void to_archive(ArchiveWriter& writer) const;
 
   void from_archive(ArchiveReader& reader);
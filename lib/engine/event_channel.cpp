@@ -2,11 +2,13 @@
 #include <string.h>
 #include <algorithm>
 #include <cassert>
+#include <limits>
 
 #include "lib/engine/event_channel.h"
 
 namespace sge {
-EventChannel::EventChannel(size_t event_object_size, int32_t capacity) : _buffer(nullptr), _end_index(0) {
+EventChannel::EventChannel(size_t event_object_size, int32_t capacity)
+    : _buffer(nullptr), _end_index(0), _num_appended(0) {
   capacity = std::max(capacity, 1);
   _buffer = (uint8_t*)malloc(capacity * event_object_size);
   _capacity = capacity;
@@ -41,15 +43,19 @@ void EventChannel::unsubscribe(SubscriberId subscriber) {
 }
 
 void EventChannel::append(const void* events, size_t event_object_size, int32_t num_events) {
+  _num_appended += num_events;
+
   // Cache members
   auto* buffer = _buffer;
   auto capacity = _capacity;
   auto end_index = _end_index;
   auto start_index = std::numeric_limits<int32_t>::max();
 
-  // Get the lowest start index
-  for (auto index : _subscriber_indices) {
-    start_index = std::min(start_index, index);
+  // Get the lowest start index (inactive subscribers have an index of -1, so they must be skipped)
+  for (SubscriberId id = 0; id < MAX_SUBSCRIBERS; ++id) {
+    if (_subscribers_active[id]) {
+      start_index = std::min(start_index, _subscriber_indices[id]);
+    }
   }
 
   // Check start index
@@ -149,6 +155,10 @@ void EventChannel::acknowledge_unconsumed(SubscriberId subscriber) {
   _subscriber_indices[subscriber] = _end_index;
 }
 
+uint64_t EventChannel::num_appended() const {
+  return _num_appended;
+}
+
 void EventChannel::clear() {
   _end_index = 0;
 
@@ -92,10 +92,17 @@ struct SGE_ENGINE_API EventChannel {
    */
   void clear();
 
+  /**
+   * \brief Returns the total number of events that have been appended to this channel, including events
+   * appended while there were no subscribers. This is not reset by 'clear'.
+   */
+  uint64_t num_appended() const;
+
  private:
   uint8_t* _buffer;
   int32_t _capacity;
   int32_t _end_index;
+  uint64_t _num_appended;
   int32_t _subscriber_indices[MAX_SUBSCRIBERS];
   uint8_t _subscribers_active[MAX_SUBSCRIBERS];
 };
@@ -10,13 +10,69 @@ SGE_REFLECT_TYPE(sge::NodeId).flags(TF_RECURSE_TERMINAL).property("is_null", &No
 SGE_REFLECT_TYPE(sge::Node);
 
 namespace sge {
+static void decompose_world_matrix(const Mat4& matrix, Vec3& out_pos, Vec3& out_scale, Quat& out_rot) {
+  out_pos = Vec3{matrix.get(3, 0), matrix.get(3, 1), matrix.get(3, 2)};
+
+  // Extract scale from the length of each basis vector
+  float m[3][3];
+  float scale[3];
+  for (uint32_t col = 0; col < 3; ++col) {
+    scale[col] = Vec3{matrix.get(col, 0), matrix.get(col, 1), matrix.get(col, 2)}.length();
+    const float inv_scale = scale[col] != 0.f ? 1.f / scale[col] : 0.f;
+    for (uint32_t row = 0; row < 3; ++row) {
+      m[row][col] = matrix.get(col, row) * inv_scale;
+    }
+  }
+  out_scale = Vec3{scale[0], scale[1], scale[2]};
+
+  // Convert the remaining rotation matrix to a quaternion
+  const float trace = m[0][0] + m[1][1] + m[2][2];
+  if (trace > 0.f) {
+    const float s = sqrtf(trace + 1.f) * 2.f;
+    out_rot = Quat{(m[2][1] - m[1][2]) / s, (m[0][2] - m[2][0]) / s, (m[1][0] - m[0][1]) / s, 0.25f * s};
+  } else if (m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+    const float s = sqrtf(1.f + m[0][0] - m[1][1] - m[2][2]) * 2.f;
+    out_rot = Quat{0.25f * s, (m[0][1] + m[1][0]) / s, (m[0][2] + m[2][0]) / s, (m[2][1] - m[1][2]) / s};
+  } else if (m[1][1] > m[2][2]) {
+    const float s = sqrtf(1.f + m[1][1] - m[0][0] - m[2][2]) * 2.f;
+    out_rot = Quat{(m[0][1] + m[1][0]) / s, 0.25f * s, (m[1][2] + m[2][1]) / s, (m[0][2] - m[2][0]) / s};
+  } else {
+    const float s = sqrtf(1.f + m[2][2] - m[0][0] - m[1][1]) * 2.f;
+    out_rot = Quat{(m[0][2] + m[2][0]) / s, (m[1][2] + m[2][1]) / s, 0.25f * s, (m[1][0] - m[0][1]) / s};
+  }
+}
+
+static Mat4 interpolate_world_matrix(const Mat4& from, const Mat4& to, float alpha) {
+  Vec3 from_pos, from_scale, to_pos, to_scale;
+  Quat from_rot, to_rot;
+  decompose_world_matrix(from, from_pos, from_scale, from_rot);
+  decompose_world_matrix(to, to_pos, to_scale, to_rot);
+
+  // Take the shortest path between rotations
+  const float dot = from_rot.x() * to_rot.x() + from_rot.y() * to_rot.y() + from_rot.z() * to_rot.z() +
+                    from_rot.w() * to_rot.w();
+  if (dot < 0.f) {
+    to_rot = to_rot * -1.f;
+  }
+
+  // Normalized lerp is fine here, since rotations between ticks are small
+  Quat rot = from_rot * (1.f - alpha) + to_rot * alpha;
+  const float rot_len = sqrtf(rot.x() * rot.x() + rot.y() * rot.y() + rot.z() * rot.z() + rot.w() * rot.w());
+  rot = rot * (1.f / rot_len);
+
+  const Vec3 pos = from_pos + (to_pos - from_pos) * alpha;
+  const Vec3 scale = from_scale + (to_scale - from_scale) * alpha;
+  return Mat4::translation(pos) * Mat4::rotate(rot) * Mat4::scale(scale);
+}
+
 Node::Node()
     : _scene(nullptr),
       _hierarchy_depth(0),
       _mod_state(NONE),
       _transform_mod_index(-1),
       _root_mod_index(-1),
-      _local_scale(1.f, 1.f, 1.f) {}
+      _local_scale(1.f, 1.f, 1.f),
+      _prev_world_tick(0) {}
 
 NodeId Node::get_id() const {
   return _id;
@@ -179,6 +235,14 @@ const Mat4& Node::get_world_matrix() const {
   return _cached_world_matrix;
 }
 
+Mat4 Node::get_interpolated_world_matrix() const {
+  if (_prev_world_tick == 0 || _prev_world_tick != _scene->get_fixed_tick_id()) {
+    return _cached_world_matrix;
+  }
+
+  return interpolate_world_matrix(_prev_world_matrix, _cached_world_matrix, _scene->get_interpolation_alpha());
+}
+
 bool Node::sort_by_hierarchy_depth(const Node* lhs, const Node* rhs) {
   return lhs->_hierarchy_depth < rhs->_hierarchy_depth;
 }
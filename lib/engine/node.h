@@ -226,6 +226,13 @@ struct SGE_ENGINE_API Node {
    */
   const Mat4& get_world_matrix() const;
 
+  /**
+   * \brief Returns the local-to-world matrix for this node, interpolated between where it was before and
+   * after the last fixed tick by the scene's interpolation alpha. If this node did not move during the last
+   * fixed tick, this is the same as 'get_world_matrix'.
+   */
+  Mat4 get_interpolated_world_matrix() const;
+
  private:
   Node();
 
@@ -247,6 +254,8 @@ struct SGE_ENGINE_API Node {
   Vec3 _local_scale;
   Quat _local_rotation;
   Mat4 _cached_world_matrix;
+  Mat4 _prev_world_matrix;
+  uint64_t _prev_world_tick;
   std::string _name;
 };
 
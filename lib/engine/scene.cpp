@@ -1,7 +1,11 @@
 #include <stdint.h>
+#include <string.h>
 #include <algorithm>
+#include <chrono>
 #include <iostream>
 
+#include "lib/base/concurrency/task_pool.h"
+#include "lib/base/profiling/profiler.h"
 #include "lib/base/reflection/reflection_builder.h"
 #include "lib/base/reflection/type_db.h"
 #include "lib/base/util/string_utils.h"
@@ -15,6 +19,17 @@
 SGE_REFLECT_TYPE(sge::Scene).implements<IToArchive>().implements<IFromArchive>();
 
 namespace sge {
+/* Number of floats in each node's transform in the packed layout (local position, scale and rotation). */
+static constexpr size_t PACKED_NODE_TRANSFORM_SIZE = 10;
+
+template <typename T>
+static void read_packed_array(ArchiveReader& reader, std::vector<T>& out) {
+  size_t size = 0;
+  reader.array_size(size);
+  out.resize(size);
+  out.resize(reader.typed_array(out.data(), out.size()));
+}
+
 Scene::Scene(TypeDB& typedb) : _type_db(&typedb), _debug_draw_line_channel(sizeof(DebugLine), 256) {
   _current_time = 0;
 }
@@ -132,6 +147,9 @@ EventChannel* Scene::get_debug_draw_line_channel() {
 
 void Scene::reset_scene() {
   _current_time = 0;
+  _fixed_time_accumulator = 0.f;
+  _interpolation_alpha = 0.f;
+  _interpolated_nodes.clear();
   _debug_draw_line_channel.clear();
   _scene_data.next_node_id.index = 1;
   _scene_data.node_buffer.clear();
@@ -195,70 +213,110 @@ void Scene::to_archive(ArchiveWriter& writer) const {
 
   // Serialize all components
   writer.push_object_member("components");
-  writer.as_object();
-  for (const auto& componentType : _scene_data.components) {
-    // Add the component type name as a field
-    writer.push_object_member(componentType.first->name().c_str());
-    componentType.second->to_archive(writer);
-    writer.pop();
-  }
+  to_archive_components(writer, false);
   writer.pop();  // "components"
 }
 
-void Scene::from_archive(ArchiveReader& reader) {
-  reset_scene();
-
-  // Deserialize lightmap path
-  reader.object_member("lightmap_data_path", _scene_data.lightmap_data_path);
+void Scene::to_packed_archive(ArchiveWriter& writer) const {
+  writer.as_object();
 
-  // Deserialize nodes
-  reader.object_member("next_node_id", _scene_data.next_node_id);
-  reader.pull_object_member("nodes");
+  // Serialize next node id (so later nodes don't overlap)
+  writer.object_member("next_node_id", _scene_data.next_node_id);
 
-  // Get the number of nodes
-  size_t num_nodes = 0;
-  reader.object_size(num_nodes);
+  // Serialize lightmap data
+  writer.object_member("lightmap_data_path", _scene_data.lightmap_data_path);
 
-  // Load all nodes
-  reader.enumerate_object_members([this, &reader, &data = _scene_data](const char* id_str) {
-    // Get the Id
-    NodeId id;
-    id.from_string(id_str);
+  // Gather node data into parallel arrays (in Id order), writing names as we go
+  const auto num_nodes = _scene_data.nodes.size();
+  std::vector<NodeId::Index_t> ids;
+  std::vector<NodeId::Index_t> roots;
+  std::vector<float> transforms;
+  ids.reserve(num_nodes);
+  roots.reserve(num_nodes);
+  transforms.reserve(num_nodes * PACKED_NODE_TRANSFORM_SIZE);
+
+  writer.push_object_member("node_names");
+  for (const auto& node : _scene_data.nodes) {
+    ids.push_back(node.first.index);
+    roots.push_back(node.second->get_root().index);
+
+    const auto lpos = node.second->get_local_position();
+    const auto lscale = node.second->get_local_scale();
+    const auto lrot = node.second->get_local_rotation();
+    const float transform[PACKED_NODE_TRANSFORM_SIZE] = {
+        lpos.x(),   lpos.y(),   lpos.z(), lscale.x(), lscale.y(),
+        lscale.z(), lrot.x(),   lrot.y(), lrot.z(),   lrot.w(),
+    };
+    transforms.insert(transforms.end(), transform, transform + PACKED_NODE_TRANSFORM_SIZE);
+
+    const auto& name = node.second->get_name();
+    writer.push_array_element();
+    writer.string(name.c_str(), name.size());
+    writer.pop();
+  }
+  writer.pop();  // "node_names"
 
-    // Validate the Id
-    if (id.is_null() || id.index >= _scene_data.next_node_id.index) {
-      std::cout << "Error: Invalid node Id" << std::endl;
-      return;
-    }
+  writer.push_object_member("node_ids");
+  writer.typed_array(ids.data(), ids.size());
+  writer.pop();
 
-    // Allocate the node
-    void* buff = data.node_buffer.alloc(sizeof(Node));
-    auto* node = new (buff) Node();
+  writer.push_object_member("node_roots");
+  writer.typed_array(roots.data(), roots.size());
+  writer.pop();
 
-    // Initialize it
-    node->_id = id;
-    node->_scene = this;
-    node->_mod_state = Node::NEW | Node::TRANSFORM_PENDING;
-    node->_transform_mod_index = (int32_t)this->_scene_data.system_node_local_transform_changes.size();
+  writer.push_object_member("node_transforms");
+  writer.typed_array(transforms.data(), transforms.size());
+  writer.pop();
 
-    // Deserialize node data
-    reader.object_member("root", node->_root);
-    reader.object_member("name", node->_name);
+  // Serialize all components
+  writer.push_object_member("components");
+  to_archive_components(writer, true);
+  writer.pop();  // "components"
+}
 
-    // Deserialize transform data
-    NodeLocalTransformMod trans;
-    trans.node = node;
-    reader.object_member("lpos", trans.local_pos);
-    reader.object_member("lscale", trans.local_scale);
-    reader.object_member("lrot", trans.local_rot);
-    this->_scene_data.system_node_local_transform_changes.push_back(trans);
+void Scene::from_archive(ArchiveReader& reader) {
+  reset_scene();
 
-    // Insert it into the scene
-    data.nodes[id] = node;
-    this->_scene_data.system_new_nodes.push_back(node);
-    this->_scene_data.update_modified_nodes.push_back(node);
+  // Visit members in the order they were written, so that streaming readers can deserialize in one pass
+  std::vector<std::string> packed_names;
+  std::vector<NodeId::Index_t> packed_ids;
+  std::vector<NodeId::Index_t> packed_roots;
+  std::vector<float> packed_transforms;
+  bool is_packed = false;
+  reader.enumerate_object_members([&](const char* name) {
+    if (strcmp(name, "next_node_id") == 0) {
+      sge::from_archive(_scene_data.next_node_id, reader);
+    } else if (strcmp(name, "lightmap_data_path") == 0) {
+      sge::from_archive(_scene_data.lightmap_data_path, reader);
+    } else if (strcmp(name, "nodes") == 0) {
+      from_archive_nodes(reader);
+    } else if (strcmp(name, "node_names") == 0) {
+      reader.enumerate_array_elements([&reader, &packed_names](size_t /*i*/) {
+        packed_names.emplace_back();
+        sge::from_archive(packed_names.back(), reader);
+      });
+    } else if (strcmp(name, "node_ids") == 0) {
+      read_packed_array(reader, packed_ids);
+      is_packed = true;
+    } else if (strcmp(name, "node_roots") == 0) {
+      read_packed_array(reader, packed_roots);
+    } else if (strcmp(name, "node_transforms") == 0) {
+      read_packed_array(reader, packed_transforms);
+    } else if (strcmp(name, "components") == 0) {
+      from_archive_components(reader);
+    }
   });
-  reader.pop();  // "nodes"
+
+  if (is_packed) {
+    from_packed_archive_nodes(packed_ids, packed_roots, packed_transforms, packed_names);
+  }
+
+  // Make sure new nodes won't overlap loaded ones ('next_node_id' may have come after them)
+  auto& next_node_id = _scene_data.next_node_id;
+  if (!_scene_data.nodes.empty() && _scene_data.nodes.rbegin()->first.index >= next_node_id.index) {
+    std::cout << "Warning: Node Ids overlap 'next_node_id'" << std::endl;
+    next_node_id.index = _scene_data.nodes.rbegin()->first.index + 1;
+  }
 
   // Fix-up parent-child relationships
   for (auto node : _scene_data.nodes) {
@@ -281,22 +339,6 @@ void Scene::from_archive(ArchiveReader& reader) {
   // Initialize hierarchy depth
   initialize_hierarchy_depths();
 
-  // Deserialize all components
-  reader.pull_object_member("components");
-  reader.enumerate_object_members([&](const char* name) {
-    // Try to get the component type
-    auto type = get_component_type(name);
-    if (!type) {
-      return;
-    }
-
-    // Deserialize the storage object
-    auto storageIter = _scene_data.components.find(type);
-    storageIter->second->from_archive(reader);
-  });
-
-  reader.pop();  // "components"
-
   // Validate components
   for (auto& component_type : _scene_data.components) {
     NodeId component_instances[8];
@@ -352,14 +394,80 @@ void Scene::register_component_type(const TypeInfo& type, std::unique_ptr<Compon
 }
 
 void Scene::update(UpdatePipeline& pipeline, float dt) {
+  SGE_PROFILE_SCOPE("Scene::update");
   const auto& pipeline_steps = pipeline.get_pipeline();
+  const auto num_steps = pipeline_steps.size();
+  const float fixed_timestep = pipeline.get_fixed_timestep();
+  const uint32_t max_fixed_steps = pipeline.get_max_fixed_steps();
+
+  // Figure out how many fixed ticks have elapsed
+  const float prev_accumulator = _fixed_time_accumulator;
+  _fixed_time_accumulator += dt;
+  uint32_t num_ticks = 0;
+  while (_fixed_time_accumulator >= fixed_timestep && num_ticks < max_fixed_steps) {
+    _fixed_time_accumulator -= fixed_timestep;
+    num_ticks += 1;
+  }
 
-  // Execute the pipeline as a job queue
-  execute_job_queue(pipeline_steps.data(), pipeline_steps.size(), pipeline, dt);
+  // If we hit the tick limit, drop the time we couldn't simulate (but keep the phase)
+  _fixed_time_accumulator = fmodf(_fixed_time_accumulator, fixed_timestep);
+  _interpolation_alpha = _fixed_time_accumulator / fixed_timestep;
+
+  // Nodes are only interpolated between the last two ticks
+  const auto first_tick_id = _fixed_tick_id;
+  if (num_ticks != 0) {
+    _first_frame_tick_id = first_tick_id;
+    _interpolated_nodes.clear();
+  }
+
+  // Each tick is given the time at which its step starts, which trails the frame's time by the time left over
+  // in the accumulator from the last frame
+  const float first_tick_time = _current_time - prev_accumulator;
+
+  // Execute the pipeline as a job queue. Each contiguous run of fixed-rate systems is executed once per tick.
+  bool has_fixed_stages = false;
+  size_t step_i = 0;
+  while (step_i < num_steps) {
+    const bool fixed_rate = pipeline_steps[step_i]->fixed_rate;
+    size_t step_end = step_i + 1;
+    while (step_end < num_steps && pipeline_steps[step_end]->fixed_rate == fixed_rate) {
+      step_end += 1;
+    }
+
+    if (fixed_rate) {
+      has_fixed_stages = true;
+      _in_fixed_tick = true;
+      for (uint32_t tick = 1; tick <= num_ticks; ++tick) {
+        _fixed_tick_id = first_tick_id + tick;
+        const float tick_time = first_tick_time + (float)(tick - 1) * fixed_timestep;
+        execute_job_queue(
+            pipeline_steps.data() + step_i, step_end - step_i, pipeline, tick_time, fixed_timestep
+        );
+      }
+      _in_fixed_tick = false;
+    } else {
+      execute_job_queue(pipeline_steps.data() + step_i, step_end - step_i, pipeline, _current_time, dt);
+    }
+
+    _fixed_tick_id = first_tick_id + num_ticks;
+    step_i = step_end;
+  }
+
+  // Events are only cleared (and destroyed nodes and components only freed) once fixed-rate systems have run,
+  // so that they still see the events of frames which ran no ticks
+  if (has_fixed_stages && num_ticks == 0) {
+    _current_time += dt;
+    _frame_id += 1;
+    return;
+  }
 
   // End the frame for all components
-  for (auto& component_type : _scene_data.components) {
-    component_type.second->on_end_update_frame();
+  {
+    SGE_PROFILE_SCOPE("on_end_update_frame");
+    for (auto& component_type : _scene_data.components) {
+      SGE_PROFILE_SCOPE(component_type.first->name().c_str());
+      component_type.second->on_end_update_frame();
+    }
   }
 
   // Reset node modification states
@@ -396,6 +504,213 @@ void Scene::update(UpdatePipeline& pipeline, float dt) {
   _frame_id += 1;
 }
 
+float Scene::get_interpolation_alpha() const {
+  return _interpolation_alpha;
+}
+
+uint64_t Scene::get_fixed_tick_id() const {
+  return _fixed_tick_id;
+}
+
+size_t Scene::num_interpolated_nodes() const {
+  return _interpolated_nodes.size();
+}
+
+size_t Scene::get_interpolated_nodes(
+    size_t start_index,
+    size_t num_nodes,
+    size_t* out_num_nodes,
+    NodeId* out_nodes
+) const {
+  if (start_index >= _interpolated_nodes.size()) {
+    *out_num_nodes = 0;
+    return 0;
+  }
+
+  const auto num_copy = std::min(_interpolated_nodes.size() - start_index, num_nodes);
+  memcpy(out_nodes, _interpolated_nodes.data() + start_index, num_copy * sizeof(NodeId));
+  *out_num_nodes = num_copy;
+  return num_copy;
+}
+
+void Scene::from_archive_nodes(ArchiveReader& reader) {
+  auto& data = _scene_data;
+  reader.enumerate_object_members([this, &reader, &data](const char* id_str) {
+    // Get the Id
+    NodeId id;
+    id.from_string(id_str);
+
+    // Validate the Id
+    if (id.is_null()) {
+      std::cout << "Error: Invalid node Id" << std::endl;
+      return;
+    }
+
+    // Allocate the node
+    void* buff = data.node_buffer.alloc(sizeof(Node));
+    auto* node = new (buff) Node();
+
+    // Initialize it
+    node->_id = id;
+    node->_scene = this;
+    node->_mod_state = Node::NEW | Node::TRANSFORM_PENDING;
+    node->_transform_mod_index = (int32_t)data.system_node_local_transform_changes.size();
+
+    // Deserialize node data
+    reader.object_member("root", node->_root);
+    reader.object_member("name", node->_name);
+
+    // Deserialize transform data
+    NodeLocalTransformMod trans;
+    trans.node = node;
+    reader.object_member("lpos", trans.local_pos);
+    reader.object_member("lscale", trans.local_scale);
+    reader.object_member("lrot", trans.local_rot);
+    data.system_node_local_transform_changes.push_back(trans);
+
+    // Insert it into the scene
+    data.nodes[id] = node;
+    data.system_new_nodes.push_back(node);
+    data.update_modified_nodes.push_back(node);
+  });
+}
+
+void Scene::from_packed_archive_nodes(
+    const std::vector<NodeId::Index_t>& ids,
+    const std::vector<NodeId::Index_t>& roots,
+    const std::vector<float>& transforms,
+    std::vector<std::string>& names
+) {
+  if (roots.size() != ids.size() || transforms.size() != ids.size() * PACKED_NODE_TRANSFORM_SIZE) {
+    std::cout << "Error: Mismatched packed node arrays" << std::endl;
+    return;
+  }
+
+  // Make room for all nodes up front
+  auto& data = _scene_data;
+  data.system_node_local_transform_changes.reserve(ids.size());
+  data.system_new_nodes.reserve(ids.size());
+  data.update_modified_nodes.reserve(ids.size());
+
+  for (size_t i = 0; i < ids.size(); ++i) {
+    // Validate the Id
+    NodeId id;
+    id.index = ids[i];
+    if (id.is_null()) {
+      std::cout << "Error: Invalid node Id" << std::endl;
+      continue;
+    }
+
+    // Nodes are written in Id order, so they can be inserted at the end without searching
+    const auto iter = data.nodes.emplace_hint(data.nodes.end(), id, nullptr);
+    if (iter->second) {
+      std::cout << "Error: Duplicate node Id" << std::endl;
+      continue;
+    }
+
+    // Allocate the node
+    void* buff = data.node_buffer.alloc(sizeof(Node));
+    auto* node = new (buff) Node();
+    iter->second = node;
+
+    // Initialize it
+    node->_id = id;
+    node->_scene = this;
+    node->_mod_state = Node::NEW | Node::TRANSFORM_PENDING;
+    node->_transform_mod_index = (int32_t)data.system_node_local_transform_changes.size();
+    node->_root.index = roots[i];
+    if (i < names.size()) {
+      node->_name = std::move(names[i]);
+    }
+
+    // Get its transform
+    const float* const transform = transforms.data() + i * PACKED_NODE_TRANSFORM_SIZE;
+    NodeLocalTransformMod trans;
+    trans.node = node;
+    trans.local_pos = Vec3{transform[0], transform[1], transform[2]};
+    trans.local_scale = Vec3{transform[3], transform[4], transform[5]};
+    trans.local_rot = Quat{transform[6], transform[7], transform[8], transform[9]};
+    data.system_node_local_transform_changes.push_back(trans);
+
+    data.system_new_nodes.push_back(node);
+    data.update_modified_nodes.push_back(node);
+  }
+}
+
+void Scene::to_archive_components(ArchiveWriter& writer, bool packed) const {
+  struct Section {
+    const TypeInfo* type;
+    const ComponentContainer* container;
+    ArchiveWriter* writer;
+  };
+
+  // Serialize each component type on its own writer in parallel, if the writer supports it
+  std::vector<Section> sections;
+  sections.reserve(_scene_data.components.size());
+  for (const auto& component_type : _scene_data.components) {
+    sections.push_back({component_type.first, component_type.second.get(), writer.fork()});
+  }
+
+  TaskPool::global().parallel_for(sections.size(), [&sections, packed](size_t i) {
+    const auto& section = sections[i];
+    if (!section.writer) {
+      return;
+    }
+
+    if (packed) {
+      section.container->to_packed_archive(*section.writer);
+    } else {
+      section.container->to_archive(*section.writer);
+    }
+  });
+
+  // Add them to the archive in order, serializing any that couldn't be forked
+  writer.as_object();
+  for (const auto& section : sections) {
+    writer.push_object_member(section.type->name().c_str());
+    if (section.writer) {
+      writer.join(*section.writer);
+    } else if (packed) {
+      section.container->to_packed_archive(writer);
+    } else {
+      section.container->to_archive(writer);
+    }
+    writer.pop();
+  }
+}
+
+void Scene::from_archive_components(ArchiveReader& reader) {
+  struct Section {
+    ComponentContainer* container;
+    ArchiveReader* reader;
+  };
+
+  // Containers are independent of each other, so each may be deserialized in parallel on its own reader
+  std::vector<Section> sections;
+  reader.enumerate_object_members([&](const char* name) {
+    // Try to get the component type
+    auto type = get_component_type(name);
+    if (!type) {
+      return;
+    }
+
+    // Deserialize the storage object now if the reader can't be forked
+    auto* const container = _scene_data.components.find(type)->second.get();
+    auto* const section_reader = reader.fork();
+    if (!section_reader) {
+      container->from_archive(reader);
+      return;
+    }
+
+    sections.push_back({container, section_reader});
+  });
+
+  TaskPool::global().parallel_for(sections.size(), [&sections](size_t i) {
+    sections[i].container->from_archive(*sections[i].reader);
+    sections[i].reader->pop();
+  });
+}
+
 void Scene::initialize_hierarchy_depths() {
   const NodeId* root_nodes = _scene_data.root_nodes.data();
   const auto num_root_nodes = _scene_data.root_nodes.size();
@@ -431,28 +746,57 @@ void Scene::execute_job_queue(
     SystemInfo* const* jobs,
     size_t num_jobs,
     UpdatePipeline& pipeline,
+    float current_time,
     float time_delta
 ) {
   for (size_t i = 0; i < num_jobs; ++i) {
     // Create a system frame for the job
     SystemFrame frame;
-    frame._current_time = _current_time;
+    frame._current_time = current_time;
     frame._time_delta = time_delta;
+    frame._fixed_tick = _in_fixed_tick;
     frame._scene = this;
     frame._update_pipeline = &pipeline;
 
+    // Give the job a deadline, if it has a budget
+    auto* const job = jobs[i];
+    const auto start = SystemFrame::Clock::now();
+    if (job->budget_ms > 0.f) {
+      const float allowed_ms = job->budget_ms - job->overrun_debt_ms;
+      frame._deadline = start + std::chrono::duration_cast<SystemFrame::Clock::duration>(
+                                    std::chrono::duration<float, std::milli>{allowed_ms}
+                                );
+    }
+
     // Run the job
-    jobs[i]->system_fn(*this, frame);
+    {
+      SGE_PROFILE_SCOPE(job->name.c_str());
+      job->system_fn(*this, frame);
+    }
+
+    // Account for the time the job took, carrying any overrun into its next deadline
+    const auto end = SystemFrame::Clock::now();
+    job->last_run_time_ms = std::chrono::duration<float, std::milli>{end - start}.count();
+    if (job->budget_ms > 0.f) {
+      if (end > frame._deadline) {
+        job->num_overruns += 1;
+      }
+
+      const float debt = job->overrun_debt_ms + job->last_run_time_ms - job->budget_ms;
+      job->overrun_debt_ms = std::clamp(debt, 0.f, job->budget_ms);
+    }
 
     // Apply change the job created
     on_end_system_frame();
 
     // Run the job's created jobs
-    execute_job_queue(frame._job_queue.data(), frame._job_queue.size(), pipeline, time_delta);
+    execute_job_queue(frame._job_queue.data(), frame._job_queue.size(), pipeline, current_time, time_delta);
   }
 }
 
 void Scene::on_end_system_frame() {
+  SGE_PROFILE_SCOPE("on_end_system_frame");
+
   // Array of nodes that need to have their hierarchy traversed (initially includes destroyed nodes, and root
   // change nodes)
   std::vector<Node*> outdated_hierarchy_elements;
@@ -513,73 +857,92 @@ void Scene::on_end_system_frame() {
   }
 
   // Update the hierarchy (adds to deleted list, and updates hierarchy depths)
-  update_hierarchy(outdated_hierarchy_elements.data(), outdated_hierarchy_elements.size());
-
-  // Sort outdated matrices by hierarchy depth
-  std::sort(outdated_matrices.begin(), outdated_matrices.end(), &Node::sort_by_hierarchy_depth);
+  {
+    SGE_PROFILE_SCOPE("update_hierarchy");
+    update_hierarchy(outdated_hierarchy_elements.data(), outdated_hierarchy_elements.size());
+  }
 
   // Update matrices (also generates transform events)
-  update_matrices(outdated_matrices.data(), outdated_matrices.size());
-
-  // Create a single temporary buffer for all event types
-  const auto max_event_size = std::max(
-      {sizeof(NodeId),
-       sizeof(ENewNode),
-       sizeof(EDestroyedNode),
-       sizeof(ENodeRootChangd),
-       sizeof(ENodeTransformChanged)}
-  );
-  const auto num_new_nodes = _scene_data.system_new_nodes.size();
-  const auto num_destroyed_nodes = _scene_data.system_destroyed_nodes.size();
-  const auto num_root_changes = _scene_data.system_node_root_changes.size();
-  const auto num_local_transform_changes = _scene_data.system_node_local_transform_changes.size();
-  const auto max_event_count =
-      std::max({num_new_nodes, num_destroyed_nodes, num_root_changes, num_local_transform_changes});
-  void* const event_buff = malloc(max_event_count * max_event_size);
-
-  // Create new node events
-  const auto* const new_nodes = _scene_data.system_new_nodes.data();
-  for (size_t i = 0; i < num_new_nodes; ++i) {
-    ((ENewNode*)event_buff)[i].node = new_nodes[i];
-  }
-  _scene_data.new_node_channel.append(event_buff, sizeof(ENewNode), (int32_t)num_new_nodes);
-
-  // Create destroyed node events
-  const auto* const destroyed_nodes = _scene_data.system_destroyed_nodes.data();
-  for (size_t i = 0; i < num_destroyed_nodes; ++i) {
-    ((EDestroyedNode*)event_buff)[i].node = destroyed_nodes[i];
-    _scene_data.update_destroyed_nodes.push_back(destroyed_nodes[i]->get_id());
-  }
-  _scene_data.destroyed_node_channel.append(event_buff, sizeof(EDestroyedNode), (int32_t)num_destroyed_nodes);
-
-  // Create root changed events
-  const auto* const root_changed_nodes = _scene_data.system_node_root_changes.data();
-  for (size_t i = 0; i < num_root_changes; ++i) {
-    ((ENodeRootChangd*)event_buff)[i].node = root_changed_nodes[i].node;
-    ((ENodeRootChangd*)event_buff)[i].root = root_changed_nodes[i].root;
-  }
-  _scene_data.node_root_changed_channel.append(
-      event_buff, sizeof(ENodeRootChangd), (int32_t)num_root_changes
-  );
+  {
+    SGE_PROFILE_SCOPE("update_matrices");
 
-  // Create local transform changed events
-  const auto* const local_transform_changed_nodes = _scene_data.system_node_local_transform_changes.data();
-  for (size_t i = 0; i < num_local_transform_changes; ++i) {
-    ((ENodeTransformChanged*)event_buff)[i].node = local_transform_changed_nodes[i].node;
+    // Sort outdated matrices by hierarchy depth
+    std::sort(outdated_matrices.begin(), outdated_matrices.end(), &Node::sort_by_hierarchy_depth);
+    update_matrices(outdated_matrices.data(), outdated_matrices.size());
   }
-  _scene_data.node_local_transform_changed_channel.append(
-      event_buff, sizeof(ENodeTransformChanged), (int32_t)num_local_transform_changes
-  );
 
-  // Create array of destroyed NodeIds to notify component containers
-  for (size_t i = 0; i < num_destroyed_nodes; ++i) {
-    ((NodeId*)event_buff)[i] = destroyed_nodes[i]->get_id();
+  // Generate node events (leaves the Ids of destroyed nodes in the event buffer)
+  void* event_buff;
+  size_t num_destroyed_nodes;
+  {
+    SGE_PROFILE_SCOPE("node_events");
+
+    // Create a single temporary buffer for all event types
+    const auto max_event_size = std::max(
+        {sizeof(NodeId),
+         sizeof(ENewNode),
+         sizeof(EDestroyedNode),
+         sizeof(ENodeRootChangd),
+         sizeof(ENodeTransformChanged)}
+    );
+    const auto num_new_nodes = _scene_data.system_new_nodes.size();
+    num_destroyed_nodes = _scene_data.system_destroyed_nodes.size();
+    const auto num_root_changes = _scene_data.system_node_root_changes.size();
+    const auto num_local_transform_changes = _scene_data.system_node_local_transform_changes.size();
+    const auto max_event_count =
+        std::max({num_new_nodes, num_destroyed_nodes, num_root_changes, num_local_transform_changes});
+    event_buff = malloc(max_event_count * max_event_size);
+
+    // Create new node events
+    const auto* const new_nodes = _scene_data.system_new_nodes.data();
+    for (size_t i = 0; i < num_new_nodes; ++i) {
+      ((ENewNode*)event_buff)[i].node = new_nodes[i];
+    }
+    _scene_data.new_node_channel.append(event_buff, sizeof(ENewNode), (int32_t)num_new_nodes);
+
+    // Create destroyed node events
+    const auto* const destroyed_nodes = _scene_data.system_destroyed_nodes.data();
+    for (size_t i = 0; i < num_destroyed_nodes; ++i) {
+      ((EDestroyedNode*)event_buff)[i].node = destroyed_nodes[i];
+      _scene_data.update_destroyed_nodes.push_back(destroyed_nodes[i]->get_id());
+    }
+    _scene_data.destroyed_node_channel.append(
+        event_buff, sizeof(EDestroyedNode), (int32_t)num_destroyed_nodes
+    );
+
+    // Create root changed events
+    const auto* const root_changed_nodes = _scene_data.system_node_root_changes.data();
+    for (size_t i = 0; i < num_root_changes; ++i) {
+      ((ENodeRootChangd*)event_buff)[i].node = root_changed_nodes[i].node;
+      ((ENodeRootChangd*)event_buff)[i].root = root_changed_nodes[i].root;
+    }
+    _scene_data.node_root_changed_channel.append(
+        event_buff, sizeof(ENodeRootChangd), (int32_t)num_root_changes
+    );
+
+    // Create local transform changed events
+    const auto* const local_transform_changed_nodes =
+        _scene_data.system_node_local_transform_changes.data();
+    for (size_t i = 0; i < num_local_transform_changes; ++i) {
+      ((ENodeTransformChanged*)event_buff)[i].node = local_transform_changed_nodes[i].node;
+    }
+    _scene_data.node_local_transform_changed_channel.append(
+        event_buff, sizeof(ENodeTransformChanged), (int32_t)num_local_transform_changes
+    );
+
+    // Create array of destroyed NodeIds to notify component containers
+    for (size_t i = 0; i < num_destroyed_nodes; ++i) {
+      ((NodeId*)event_buff)[i] = destroyed_nodes[i]->get_id();
+    }
   }
 
   // Notify each component container, and run the end-system-frame handler
-  for (auto& component_type : _scene_data.components) {
-    component_type.second->remove_instances((const NodeId*)event_buff, num_destroyed_nodes);
-    component_type.second->on_end_system_frame();
+  {
+    SGE_PROFILE_SCOPE("component_end_system_frame");
+    for (auto& component_type : _scene_data.components) {
+      component_type.second->remove_instances((const NodeId*)event_buff, num_destroyed_nodes);
+      component_type.second->on_end_system_frame();
+    }
   }
 
   // Clean up
@@ -697,7 +1060,7 @@ void Scene::update_matrices(Node* const* nodes, size_t num_nodes) {
                              Mat4::rotate(node->_local_rotation) * Mat4::scale(node->_local_scale);
 
     // Update node
-    node->_cached_world_matrix = node_matrix;
+    set_world_matrix(node, node_matrix);
     node->_mod_state = (node->_mod_state & ~Node::TRANSFORM_PENDING) | Node::TRANSFORM_APPLIED;
 
     // Create event
@@ -721,6 +1084,24 @@ void Scene::update_matrices(Node* const* nodes, size_t num_nodes) {
   free(root_ids);
 }
 
+void Scene::set_world_matrix(Node* node, const Mat4& world_matrix) {
+  // Changes made outside of fixed ticks (and to new nodes) are not interpolated
+  if (!_in_fixed_tick || (node->_mod_state & Node::NEW) != 0) {
+    node->_prev_world_tick = 0;
+  } else if (node->_prev_world_tick != _fixed_tick_id) {
+    // If this is the first time the node has moved during this frame's ticks, add it to the interpolated set
+    if (node->_prev_world_tick <= _first_frame_tick_id) {
+      _interpolated_nodes.push_back(node->_id);
+    }
+
+    // Remember where the node was at the start of this tick
+    node->_prev_world_matrix = node->_cached_world_matrix;
+    node->_prev_world_tick = _fixed_tick_id;
+  }
+
+  node->_cached_world_matrix = world_matrix;
+}
+
 void Scene::update_child_matrices(
     const Mat4& parent_matrix,
     std::vector<Node*>& nodes,
@@ -740,8 +1121,11 @@ void Scene::update_child_matrices(
     }
 
     // Update this node
-    node->_cached_world_matrix = parent_matrix * Mat4::translation(node->_local_position) *
-                                 Mat4::rotate(node->_local_rotation) * Mat4::scale(node->_local_scale);
+    set_world_matrix(
+        node,
+        parent_matrix * Mat4::translation(node->_local_position) * Mat4::rotate(node->_local_rotation) *
+            Mat4::scale(node->_local_scale)
+    );
 
     // Update mod state
     if ((mod_state & Node::H_NODE_MODIFIED) == 0) {
@@ -63,6 +63,14 @@ struct SGE_ENGINE_API Scene {
    */
   void to_archive(ArchiveWriter& writer) const;
 
+  /**
+   * \brief Serializes the state of this Scene to an Archive in a compact layout, where nodes and their
+   * transforms are stored in contiguous typed arrays rather than as one object per node. This is intended for
+   * binary archives, and is accepted by 'from_archive'.
+   * \param writer The writer for the archive to serialize to.
+   */
+  void to_packed_archive(ArchiveWriter& writer) const;
+
   /**
    * \brief Deserializes the state of this Scene from an Archive.
    * \param reader The reader for the Archive to deserialize from.
@@ -100,11 +108,57 @@ struct SGE_ENGINE_API Scene {
    */
   void update(UpdatePipeline& pipeline, float dt);
 
+  /**
+   * \brief Returns how far the scene is between the last fixed tick and the next one, in the range [0, 1).
+   */
+  float get_interpolation_alpha() const;
+
+  /**
+   * \brief Returns the Id of the last fixed tick that was run (or is being run).
+   */
+  uint64_t get_fixed_tick_id() const;
+
+  /**
+   * \brief Returns the number of nodes which moved during the fixed ticks of the last frame that ran any.
+   */
+  size_t num_interpolated_nodes() const;
+
+  /**
+   * \brief Fills the given array with the Ids of nodes which moved during the fixed ticks of the last frame
+   * that ran any. Their interpolated world matrices may be retrieved with
+   * 'Node::get_interpolated_world_matrix'.
+   * NOTE: Nodes in this list may have been destroyed since.
+   */
+  size_t get_interpolated_nodes(
+      size_t start_index,
+      size_t num_nodes,
+      size_t* out_num_nodes,
+      NodeId* out_nodes
+  ) const;
+
  private:
+  void from_archive_nodes(ArchiveReader& reader);
+
+  void from_packed_archive_nodes(
+      const std::vector<NodeId::Index_t>& ids,
+      const std::vector<NodeId::Index_t>& roots,
+      const std::vector<float>& transforms,
+      std::vector<std::string>& names
+  );
+
+  void to_archive_components(ArchiveWriter& writer, bool packed) const;
+
+  void from_archive_components(ArchiveReader& reader);
+
   void initialize_hierarchy_depths();
 
-  void
-  execute_job_queue(SystemInfo* const* jobs, size_t num_jobs, UpdatePipeline& pipeline, float time_delta);
+  void execute_job_queue(
+      SystemInfo* const* jobs,
+      size_t num_jobs,
+      UpdatePipeline& pipeline,
+      float current_time,
+      float time_delta
+  );
 
   void on_end_system_frame();
 
@@ -119,6 +173,8 @@ struct SGE_ENGINE_API Scene {
 
   void update_matrices(Node* const* nodes, size_t num_nodes);
 
+  void set_world_matrix(Node* node, const Mat4& world_matrix);
+
   void update_child_matrices(
       const Mat4& parent_matrix,
       std::vector<Node*>& nodes,
@@ -129,6 +185,12 @@ struct SGE_ENGINE_API Scene {
   TypeDB* _type_db;
   float _current_time;
   uint64_t _frame_id = 0;
+  float _fixed_time_accumulator = 0.f;
+  float _interpolation_alpha = 0.f;
+  uint64_t _fixed_tick_id = 0;
+  uint64_t _first_frame_tick_id = 0;
+  bool _in_fixed_tick = false;
+  std::vector<NodeId> _interpolated_nodes;
   SceneData _scene_data;
   EventChannel _debug_draw_line_channel;
 };
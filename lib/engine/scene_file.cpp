@@ -0,0 +1,34 @@
+#include "lib/base/util/string_utils.h"
+#include "lib/engine/scene.h"
+#include "lib/engine/scene_file.h"
+#include "lib/resource/archives/binary_archive.h"
+#include "lib/resource/archives/json_archive.h"
+
+namespace sge {
+bool load_scene_file(Scene& scene, const char* path) {
+  // Both readers deserialize as they go, so JSON scenes are never parsed into a document first
+  auto* const reader = string_ends_with(path, ".sbin") ? BinaryArchive::read_mapped_file(path)
+                                                       : JsonArchive::read_file_streaming(path, false);
+  if (!reader) {
+    return false;
+  }
+
+  scene.from_archive(*reader);
+  reader->pop();
+  return true;
+}
+
+bool save_scene_file(const Scene& scene, const char* path) {
+  if (string_ends_with(path, ".sbin")) {
+    return BinaryArchive::write_file(path, [&scene](ArchiveWriter& writer) {
+      scene.to_packed_archive(writer);
+    });
+  }
+
+  JsonArchive archive;
+  auto* const writer = archive.write_root();
+  scene.to_archive(*writer);
+  writer->pop();
+  return archive.to_file(path);
+}
+}  // namespace sge
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "lib/engine/build.h"
+
+namespace sge {
+struct Scene;
+
+/**
+ * \brief Loads a scene from a file. '.sbin' files are read as memory-mapped binary archives, and anything
+ * else is parsed as JSON while it is deserialized.
+ * \param scene The scene to load into. It is reset first.
+ * \param path The path of the file to load.
+ * \return Whether the file could be read.
+ */
+SGE_ENGINE_API bool load_scene_file(Scene& scene, const char* path);
+
+/**
+ * \brief Saves a scene to a file. '.sbin' files are streamed to a binary archive using the packed scene
+ * layout, and anything else is saved as JSON.
+ * \param scene The scene to save.
+ * \param path The path of the file to save to.
+ * \return Whether the file could be written.
+ */
+SGE_ENGINE_API bool save_scene_file(const Scene& scene, const char* path);
+}  // namespace sge
@@ -1,5 +1,7 @@
 #include <stdint.h>
+#include <algorithm>
 #include <iostream>
+#include <limits>
 
 #include "lib/base/memory/functions.h"
 #include "lib/base/reflection/reflection_builder.h"
@@ -15,7 +17,9 @@ void SystemFrame::yield() {
   _scene->on_end_system_frame();
 
   // Execute this frame's job queue
-  _scene->execute_job_queue(_job_queue.data(), _job_queue.size(), *_update_pipeline, _time_delta);
+  _scene->execute_job_queue(
+      _job_queue.data(), _job_queue.size(), *_update_pipeline, _current_time, _time_delta
+  );
   _job_queue.clear();
 }
 
@@ -31,6 +35,14 @@ float SystemFrame::time_delta() const {
   return _time_delta;
 }
 
+bool SystemFrame::is_fixed_tick() const {
+  return _fixed_tick;
+}
+
+float SystemFrame::interpolation_alpha() const {
+  return _scene->get_interpolation_alpha();
+}
+
 void SystemFrame::push(const char* system_name) {
   auto* const system = _update_pipeline->find_system(system_name);
   if (!system) {
@@ -40,4 +52,25 @@ void SystemFrame::push(const char* system_name) {
 
   _job_queue.push_back(system);
 }
+
+bool SystemFrame::has_budget() const {
+  return _deadline != Clock::time_point::max();
+}
+
+SystemFrame::Clock::time_point SystemFrame::deadline() const {
+  return _deadline;
+}
+
+bool SystemFrame::past_deadline() const {
+  return Clock::now() >= _deadline;
+}
+
+float SystemFrame::remaining_time_ms() const {
+  if (!has_budget()) {
+    return std::numeric_limits<float>::infinity();
+  }
+
+  const auto remaining = std::chrono::duration<float, std::milli>{_deadline - Clock::now()}.count();
+  return std::max(remaining, 0.f);
+}
 }  // namespace sge
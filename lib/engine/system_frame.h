@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <chrono>
 #include <stack>
 
 #include "lib/base/functional/ufunction.h"
@@ -13,6 +14,7 @@ struct Scene;
 
 struct SGE_ENGINE_API SystemFrame {
   SGE_REFLECTED_TYPE;
+  using Clock = std::chrono::steady_clock;
 
   void yield();
 
@@ -22,8 +24,41 @@ struct SGE_ENGINE_API SystemFrame {
 
   float time_delta() const;
 
+  /**
+   * \brief Returns whether this frame is part of a fixed-rate tick.
+   */
+  bool is_fixed_tick() const;
+
+  /**
+   * \brief Returns how far the scene is between the last fixed tick and the next one, in the range [0, 1).
+   * Per-frame systems that present the scene (such as rendering) should use this to interpolate.
+   */
+  float interpolation_alpha() const;
+
   void push(const char* system_name);
 
+  /**
+   * \brief Returns whether the system running this frame has a time budget.
+   */
+  bool has_budget() const;
+
+  /**
+   * \brief Returns the point in time by which the system running this frame should return.
+   * If the system does not have a budget, this returns 'Clock::time_point::max()'.
+   */
+  Clock::time_point deadline() const;
+
+  /**
+   * \brief Returns whether the deadline for this frame has passed. Budgeted systems should check this
+   * between units of work, and return once it has. This always returns 'false' for unbudgeted systems.
+   */
+  bool past_deadline() const;
+
+  /**
+   * \brief Returns the number of milliseconds remaining until the deadline for this frame.
+   */
+  float remaining_time_ms() const;
+
  private:
   /* Only 'Scene' objects may construct SystemFrames. */
   friend Scene;
@@ -36,6 +71,8 @@ struct SGE_ENGINE_API SystemFrame {
 
   float _current_time = 0.f;
   float _time_delta = 0.f;
+  bool _fixed_tick = false;
+  Clock::time_point _deadline = Clock::time_point::max();
   Scene* _scene = nullptr;
   UpdatePipeline* _update_pipeline = nullptr;
   std::vector<SystemInfo*> _job_queue;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdint.h>
 #include <string>
 
 #include "lib/base/functional/ufunction.h"
@@ -16,5 +17,34 @@ struct SystemInfo {
    * \brief Actual system function to run.
    */
   UFunction<UpdatePipeline::SystemFn> system_fn;
+
+  /**
+   * \brief Whether this system runs at the pipeline's fixed timestep, rather than once per frame.
+   * Fixed-rate systems may run zero or more times per frame, and always receive the fixed timestep as their
+   * time delta.
+   */
+  bool fixed_rate = false;
+
+  /**
+   * \brief The amount of time this system may run for each time it is executed, in milliseconds.
+   * A value of zero (the default) means the system is not budgeted.
+   */
+  float budget_ms = 0.f;
+
+  /**
+   * \brief Time this system has run past its budget, which has not yet been paid back by running under
+   * budget. This is subtracted from the next deadline given to the system, and never exceeds 'budget_ms'.
+   */
+  float overrun_debt_ms = 0.f;
+
+  /**
+   * \brief How long this system took the last time it was executed, in milliseconds.
+   */
+  float last_run_time_ms = 0.f;
+
+  /**
+   * \brief The number of times this system has run past its deadline.
+   */
+  uint64_t num_overruns = 0;
 };
 }  // namespace sge
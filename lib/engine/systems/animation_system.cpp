@@ -1,11 +1,14 @@
 #include "lib/engine/systems/animation_system.h"
 #include "lib/engine/components/gameplay/animation.h"
 #include "lib/engine/scene.h"
+#include "lib/engine/update_pipeline.h"
 
 namespace sge {
 void AnimationSystem::register_pipeline(UpdatePipeline& pipeline) {
   pipeline.register_system_fn("animation_update", this, &AnimationSystem::animation_update);
   pipeline.register_system_fn("animation_apply", this, &AnimationSystem::animation_apply);
+  pipeline.set_system_fixed_rate("animation_update", true);
+  pipeline.set_system_fixed_rate("animation_apply", true);
 }
 
 void AnimationSystem::animation_update(Scene& scene, SystemFrame& frame) {
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 
 #include "lib/base/interfaces/from_archive.h"
@@ -20,9 +21,18 @@ void UpdatePipeline::configure_pipeline(ArchiveReader& reader) {
   _pipeline.clear();
 
   reader.enumerate_array_elements([this, &reader](size_t /*i*/) {
-    // Get the name of the system
+    // Get the name of the system, and its budget if it was given as an object
     std::string system_fn_name;
-    sge::from_archive(system_fn_name, reader);
+    float budget_ms = -1.f;
+    bool fixed_rate = false;
+    bool has_fixed_rate = false;
+    if (reader.is_object()) {
+      reader.object_member("system", system_fn_name);
+      reader.object_member("budget_ms", budget_ms);
+      has_fixed_rate = reader.object_member("fixed_rate", fixed_rate);
+    } else {
+      sge::from_archive(system_fn_name, reader);
+    }
 
     // Search for the system
     auto iter = this->_systems.find(system_fn_name);
@@ -37,6 +47,13 @@ void UpdatePipeline::configure_pipeline(ArchiveReader& reader) {
       return;
     }
 
+    if (budget_ms >= 0.f) {
+      iter->second->budget_ms = budget_ms;
+    }
+    if (has_fixed_rate) {
+      iter->second->fixed_rate = fixed_rate;
+    }
+
     this->_pipeline.push_back(iter->second.get());
   });
 }
@@ -59,4 +76,46 @@ SystemInfo* UpdatePipeline::find_system(const char* name) {
   const auto iter = _systems.find(name);
   return iter != _systems.end() ? iter->second.get() : nullptr;
 }
+
+bool UpdatePipeline::set_system_budget(const char* name, float budget_ms) {
+  auto* const system = find_system(name);
+  if (!system) {
+    return false;
+  }
+
+  system->budget_ms = budget_ms;
+  system->overrun_debt_ms = 0.f;
+  return true;
+}
+
+bool UpdatePipeline::set_system_fixed_rate(const char* name, bool fixed_rate) {
+  auto* const system = find_system(name);
+  if (!system) {
+    return false;
+  }
+
+  system->fixed_rate = fixed_rate;
+  return true;
+}
+
+float UpdatePipeline::get_fixed_timestep() const {
+  return _fixed_timestep;
+}
+
+void UpdatePipeline::set_fixed_timestep(float timestep) {
+  if (timestep <= 0.f) {
+    std::cout << "WARNING: Fixed timestep must be positive" << std::endl;
+    return;
+  }
+
+  _fixed_timestep = timestep;
+}
+
+uint32_t UpdatePipeline::get_max_fixed_steps() const {
+  return _max_fixed_steps;
+}
+
+void UpdatePipeline::set_max_fixed_steps(uint32_t max_steps) {
+  _max_fixed_steps = std::max(max_steps, 1u);
+}
 }  // namespace sge
@@ -42,11 +42,52 @@ struct SGE_ENGINE_API UpdatePipeline {
 
   SystemInfo* find_system(const char* name);
 
+  /**
+   * \brief Sets the per-frame time budget for the named system.
+   * \param name The name of the system to set the budget for.
+   * \param budget_ms The budget to set, in milliseconds. Zero removes the budget.
+   * \return Whether the system was found.
+   */
+  bool set_system_budget(const char* name, float budget_ms);
+
+  /**
+   * \brief Sets whether the named system runs at the fixed timestep, or once per frame.
+   * \param name The name of the system to set the update rate for.
+   * \param fixed_rate Whether the system should run at the fixed timestep.
+   * \return Whether the system was found.
+   */
+  bool set_system_fixed_rate(const char* name, bool fixed_rate);
+
+  /**
+   * \brief Returns the time delta given to fixed-rate systems, in seconds.
+   */
+  float get_fixed_timestep() const;
+
+  /**
+   * \brief Sets the time delta given to fixed-rate systems, in seconds.
+   */
+  void set_fixed_timestep(float timestep);
+
+  /**
+   * \brief Returns the maximum number of fixed ticks that may be run in a single frame.
+   * Time beyond this is dropped, so that slow frames don't snowball into slower frames.
+   */
+  uint32_t get_max_fixed_steps() const;
+
+  /**
+   * \brief Sets the maximum number of fixed ticks that may be run in a single frame.
+   */
+  void set_max_fixed_steps(uint32_t max_steps);
+
  private:
   /* Frame update pipeline. */
   Pipeline _pipeline;
 
   /* System functions */
   std::unordered_map<std::string, std::unique_ptr<SystemInfo>> _systems;
+
+  /* Fixed-rate update settings. */
+  float _fixed_timestep = 1.f / 60.f;
+  uint32_t _max_fixed_steps = 5;
 };
 }  // namespace sge
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <string.h>
 #include <algorithm>
 #include <map>
 #include <set>
@@ -8,6 +9,7 @@
 
 #include "lib/base/interfaces/from_string.h"
 #include "lib/base/memory/buffers/multi_stack_buffer.h"
+#include "lib/base/reflection/static_fields.h"
 #include "lib/engine/component.h"
 
 namespace sge {
@@ -42,43 +44,89 @@ class BasicComponentContainer final : public ComponentContainer {
     }
   }
 
-  void from_archive(ArchiveReader& reader) override {
-    reset();
+  void to_packed_archive(ArchiveWriter& writer) const override {
+    writer.as_object();
 
-    std::vector<ENewComponent> new_instances;
+    // Write the instance nodes, in the same order as the instances
+    std::vector<NodeId::Index_t> nodes;
+    nodes.reserve(_instance_map.size());
+    for (auto instance : _instance_map) {
+      nodes.push_back(instance.first.index);
+    }
 
-    reader.enumerate_object_members([this, &reader, &new_instances](const char* id_str) {
-      // Get the node id
-      NodeId node;
-      node.from_string(id_str);
+    writer.push_object_member("nodes");
+    writer.typed_array(nodes.data(), nodes.size());
+    writer.pop();
 
-      // Make sure it's valid
-      if (node.is_null()) {
-        return;
+    // Write the instances' fields as columns if possible, otherwise write each instance on its own
+    if constexpr (HAS_FIELD_COLUMNS) {
+      std::vector<const ComponentT*> instances;
+      instances.reserve(_instance_map.size());
+      for (auto instance : _instance_map) {
+        instances.push_back(instance.second);
       }
 
-      // Make sure it doesn't already exist in the map
-      const auto node_iter = this->_instance_map.find(node);
-      if (node_iter != this->_instance_map.end()) {
-        return;
+      writer.push_object_member("fields");
+      field_columns_to_archive(instances.data(), instances.size(), ComponentT::archive_fields(), writer);
+      writer.pop();
+    } else {
+      writer.push_object_member("instances");
+      for (auto instance : _instance_map) {
+        writer.push_array_element();
+        instance.second->to_archive(writer);
+        writer.pop();
       }
+      writer.pop();
+    }
+  }
 
-      // Allocate space for the node
-      auto* const buff = this->_instance_buffer.alloc(sizeof(ComponentT));
-      auto* const instance = new (buff) ComponentT(node, _shared_data);
-
-      // Insert it into the map
-      this->_instance_map[node] = instance;
-      this->_instance_nodes.push_back(node);
-
-      // Deserialize it
-      instance->from_archive(reader);
+  void from_archive(ArchiveReader& reader) override {
+    reset();
 
-      // Create the new instance event
-      ENewComponent event;
-      event.node = node;
-      event.instance = instance;
-      new_instances.push_back(event);
+    std::vector<ENewComponent> new_instances;
+    std::vector<ComponentT*> packed_instances;
+    bool packed = false;
+    bool read_fields = false;
+
+    // Members are enumerated rather than pulled by name, so that streaming readers needn't parse the whole
+    // section at once. In the packed layout, "nodes" is written before the instances' data.
+    reader.enumerate_object_members([&](const char* name) {
+      if (strcmp(name, "nodes") == 0) {
+        packed = true;
+        this->create_packed_instances(reader, packed_instances, new_instances);
+      } else if (strcmp(name, "fields") == 0) {
+        if constexpr (HAS_FIELD_COLUMNS) {
+          const auto fields = ComponentT::archive_fields();
+          field_columns_from_archive(packed_instances.data(), packed_instances.size(), fields, reader);
+          read_fields = true;
+        }
+      } else if (strcmp(name, "instances") == 0) {
+        if (!read_fields) {
+          reader.enumerate_array_elements([&reader, &packed_instances](size_t i) {
+            if (i < packed_instances.size() && packed_instances[i]) {
+              packed_instances[i]->from_archive(reader);
+            }
+          });
+        }
+      } else if (!packed) {
+        // Otherwise each member is an instance, named by its node id
+        NodeId node;
+        node.from_string(name);
+
+        auto* const instance = this->create_loaded_instance(node);
+        if (!instance) {
+          return;
+        }
+
+        // Deserialize it
+        instance->from_archive(reader);
+
+        // Create the new instance event
+        ENewComponent event;
+        event.node = node;
+        event.instance = instance;
+        new_instances.push_back(event);
+      }
     });
 
     // Append all new instance events
@@ -248,6 +296,69 @@ class BasicComponentContainer final : public ComponentContainer {
   }
 
  private:
+  // Whether the component lists its fields with 'archive_fields', and they may all be serialized as columns
+  static constexpr bool HAS_FIELD_COLUMNS = []() {
+    if constexpr (requires { ComponentT::archive_fields(); }) {
+      return FieldsSupportColumns<decltype(ComponentT::archive_fields())>::value;
+    } else {
+      return false;
+    }
+  }();
+
+  // Creates the instances for the packed layout's "nodes" member, in the order of their nodes.
+  void create_packed_instances(
+      ArchiveReader& reader,
+      std::vector<ComponentT*>& out_instances,
+      std::vector<ENewComponent>& out_new_instances
+  ) {
+    size_t num_nodes = 0;
+    reader.array_size(num_nodes);
+    std::vector<NodeId::Index_t> nodes(num_nodes);
+    nodes.resize(reader.typed_array(nodes.data(), nodes.size()));
+
+    out_instances.reserve(nodes.size());
+    out_new_instances.reserve(nodes.size());
+    _instance_nodes.reserve(nodes.size());
+    for (const auto index : nodes) {
+      NodeId node;
+      node.index = index;
+      auto* const instance = create_loaded_instance(node);
+      out_instances.push_back(instance);
+
+      if (instance) {
+        ENewComponent event;
+        event.node = node;
+        event.instance = instance;
+        out_new_instances.push_back(event);
+      }
+    }
+  }
+
+  // Creates an instance for a node being deserialized. Returns null if the node is invalid, or already has
+  // an instance.
+  ComponentT* create_loaded_instance(NodeId node) {
+    // Make sure it's valid
+    if (node.is_null()) {
+      return nullptr;
+    }
+
+    // Make sure it doesn't already exist in the map (and find where it goes, so it's only searched once)
+    const auto node_iter = _instance_map.lower_bound(node);
+    if (node_iter != _instance_map.end() && node_iter->first == node) {
+      return nullptr;
+    }
+
+    // Allocate space for the node
+    auto* const buff = _instance_buffer.alloc(sizeof(ComponentT));
+    auto* const instance = new (buff) ComponentT(node, _shared_data);
+
+    // Insert it into the map
+    _instance_map.emplace_hint(node_iter, node, instance);
+    _instance_nodes.push_back(node);
+
+    return instance;
+  }
+
   SharedDataT _shared_data;
   EventChannel _new_instance_channel;
   EventChannel _destroyed_instance_channel;
@@ -7,7 +7,12 @@ SGE_REFLECT_TYPE(sge::gl_render::Config).implements<IFromArchive>();
 
 namespace sge {
 namespace gl_render {
-Config::Config() : viewport_width(0), viewport_height(0) {}
+Config::Config()
+    : viewport_width(0),
+      viewport_height(0),
+      lod_error_pixels(1.f),
+      shadow_lod_bias(4.f),
+      resource_finalize_budget_ms(2.f) {}
 
 void Config::from_archive(ArchiveReader& reader) {
   reader.object_member("viewport_width", viewport_width);
@@ -19,6 +24,9 @@ void Config::from_archive(ArchiveReader& reader) {
   reader.object_member("debug_line_frag_shader", debug_line_frag_shader);
   reader.object_member("missing_material", missing_material);
   reader.object_member("missing_mesh", missing_mesh);
+  reader.object_member("lod_error_pixels", lod_error_pixels);
+  reader.object_member("shadow_lod_bias", shadow_lod_bias);
+  reader.object_member("resource_finalize_budget_ms", resource_finalize_budget_ms);
 }
 
 bool Config::validate() const {
@@ -49,6 +57,15 @@ bool Config::validate() const {
   if (missing_mesh.empty()) {
     return false;
   }
+  if (lod_error_pixels < 0.f) {
+    return false;
+  }
+  if (shadow_lod_bias < 0.f) {
+    return false;
+  }
+  if (resource_finalize_budget_ms < 0.f) {
+    return false;
+  }
 
   return true;
 }
@@ -25,6 +25,17 @@ struct SGE_GL_RENDER_API Config {
   std::string debug_line_frag_shader;
   std::string missing_material;
   std::string missing_mesh;
+
+  /* How many pixels the error of a static mesh LOD may cover on screen before a more detailed LOD is drawn.
+   * Zero always draws meshes in full detail. */
+  float lod_error_pixels;
+
+  /* Multiplier for 'lod_error_pixels' in spotlight shadow passes, where coarser LODs are less noticeable. */
+  float shadow_lod_bias;
+
+  /* Time per frame that may be spent creating GL objects for resources that have finished loading, in
+   * milliseconds. At least one resource is created each frame if any are ready. */
+  float resource_finalize_budget_ms;
 };
 }  // namespace gl_render
 }  // namespace sge
@@ -1,4 +1,5 @@
 #include <stdint.h>
+#include <algorithm>
 #include <iostream>
 
 #include "lib/base/reflection/reflection_builder.h"
@@ -43,6 +44,54 @@ static void on_node_transform_update(
   }
 }
 
+static void on_node_transform_interpolate(
+    Scene& scene,
+    std::vector<NodeId>& interpolated_nodes,
+    RenderScene_Commands& commands
+) {
+  NodeId node_ids[16];
+  Node* nodes[16];
+  Mat4 world_transforms[16];
+
+  // Put nodes that were interpolated last frame back to their actual transform, in case they've stopped moving
+  for (size_t start_index = 0; start_index < interpolated_nodes.size(); start_index += 16) {
+    const auto num_nodes = std::min<size_t>(interpolated_nodes.size() - start_index, 16);
+    scene.get_nodes(interpolated_nodes.data() + start_index, num_nodes, nodes);
+
+    size_t num_valid = 0;
+    for (size_t i = 0; i < num_nodes; ++i) {
+      if (nodes[i]) {
+        node_ids[num_valid] = nodes[i]->get_id();
+        world_transforms[num_valid] = nodes[i]->get_world_matrix();
+        num_valid += 1;
+      }
+    }
+
+    RenderScene_update_matrices(commands, node_ids, world_transforms, num_valid);
+  }
+
+  // Interpolate the nodes that moved during the last fixed tick
+  interpolated_nodes.clear();
+  size_t num_ids;
+  size_t start_index = 0;
+  while (scene.get_interpolated_nodes(start_index, 16, &num_ids, node_ids)) {
+    start_index += 16;
+    scene.get_nodes(node_ids, num_ids, nodes);
+
+    size_t num_valid = 0;
+    for (size_t i = 0; i < num_ids; ++i) {
+      if (nodes[i]) {
+        node_ids[num_valid] = nodes[i]->get_id();
+        world_transforms[num_valid] = nodes[i]->get_interpolated_world_matrix();
+        num_valid += 1;
+      }
+    }
+
+    RenderScene_update_matrices(commands, node_ids, world_transforms, num_valid);
+    interpolated_nodes.insert(interpolated_nodes.end(), node_ids, node_ids + num_valid);
+  }
+}
+
 static void on_static_mesh_new(
     Scene& scene,
     EventChannel& new_static_mesh_channel,
@@ -70,6 +119,32 @@ static void on_static_mesh_new(
   }
 }
 
+static void on_static_mesh_resources_loaded(
+    Scene& scene,
+    RenderResource& resources,
+    RenderScene_Commands& commands
+) {
+  // Take the nodes waiting on resources (any still waiting are added back when they're re-inserted)
+  std::vector<NodeId> node_ids;
+  std::swap(node_ids, commands.pending_static_mesh_nodes);
+  if (node_ids.empty()) {
+    return;
+  }
+
+  // Get nodes and components
+  std::vector<const Node*> nodes(node_ids.size());
+  std::vector<CStaticMesh*> components(node_ids.size());
+  scene.get_nodes(node_ids.data(), node_ids.size(), nodes.data());
+  scene.get_component_container(CStaticMesh::type_info)
+      ->get_instances(node_ids.data(), node_ids.size(), components.data());
+
+  // Replace their commands with ones using the loaded resources
+  RenderScene_remove_static_mesh_commands(commands, node_ids.data(), node_ids.size());
+  RenderScene_insert_static_mesh_commands(
+      commands, resources, nodes.data(), components.data(), node_ids.size()
+  );
+}
+
 static void on_static_mesh_destroy(
     EventChannel& destroyed_static_mesh_channel,
     EventChannel::SubscriberId subscriber_id,
@@ -165,11 +240,13 @@ static void on_spotlight_destroy(
 static void initialize_render_scene(RenderScene_Commands& render_scene, Scene& scene) {
   // Load the lightmap object
   if (!scene.get_raw_scene_data().lightmap_data_path.empty()) {
-    BinaryArchive lightmap_archive;
-    lightmap_archive.from_file(scene.get_raw_scene_data().lightmap_data_path.c_str());
-
     SceneLightmap scene_lightmap;
-    lightmap_archive.deserialize_root(scene_lightmap);
+    auto* const lightmap_reader =
+        BinaryArchive::read_mapped_file(scene.get_raw_scene_data().lightmap_data_path.c_str());
+    if (lightmap_reader) {
+      scene_lightmap.from_archive(*lightmap_reader);
+      lightmap_reader->pop();
+    }
 
     // Get the light direction and color
     render_scene.light_dir = scene_lightmap.light_direction;
@@ -276,6 +353,9 @@ GLRenderSystem::GLRenderSystem(const Config& config) {
   _state = std::make_unique<GLRenderSystem::State>();
   _state->width = config.viewport_width;
   _state->height = config.viewport_height;
+  _state->render_scene.lod_error_pixels = config.lod_error_pixels;
+  _state->render_scene.shadow_lod_bias = config.shadow_lod_bias;
+  _state->resource_finalize_budget_ms = config.resource_finalize_budget_ms;
 
   // Initialize GLEW
   glewExperimental = GL_TRUE;
@@ -651,6 +731,7 @@ void GLRenderSystem::set_viewport(int width, int height) {
 
 void GLRenderSystem::reset() {
   RenderScene_clear(_state->render_scene);
+  _state->interpolated_nodes.clear();
   _state->initialized_render_scene = false;
 }
 
@@ -668,6 +749,11 @@ void GLRenderSystem::render_scene(Scene& scene, SystemFrame& /*frame*/) {
       scene, *_new_static_mesh_channel, _new_static_mesh_sid, _state->resources, _state->render_scene
   );
   on_static_mesh_destroy(*_destroyed_static_mesh_channel, _destroyed_static_mesh_sid, _state->render_scene);
+
+  // Create resources that have finished loading, and swap them in for the placeholders
+  if (RenderResource_finalize_loads(_state->resources, _state->resource_finalize_budget_ms)) {
+    on_static_mesh_resources_loaded(scene, _state->resources, _state->render_scene);
+  }
   on_spotlight_new(
       scene, *_new_spotlight_channel, _new_spotlight_sid, _state->resources, _state->render_scene
   );
@@ -678,6 +764,7 @@ void GLRenderSystem::render_scene(Scene& scene, SystemFrame& /*frame*/) {
   on_node_transform_update(
       *_modified_node_transform_channel, _modified_node_transform_sid, _state->render_scene
   );
+  on_node_transform_interpolate(scene, _state->interpolated_nodes, _state->render_scene);
 
   // Create camera matrices
   NodeId cam_node;
@@ -696,7 +783,7 @@ void GLRenderSystem::render_scene(Scene& scene, SystemFrame& /*frame*/) {
   // Access the camera
   cam_component->get_instances(&cam_node, 1, &cam_instance);
   scene.get_nodes(&cam_node, 1, &cam_node_instance);
-  const Mat4 view = cam_node_instance->get_world_matrix().inverse();
+  const Mat4 view = cam_node_instance->get_interpolated_world_matrix().inverse();
   const Mat4 proj = cam_instance->get_projection_matrix((float)this->_state->width / this->_state->height);
 
   // Render the scene
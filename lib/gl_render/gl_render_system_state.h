@@ -55,6 +55,7 @@ struct GLRenderSystem::State {
   // Config
   GLint width;
   GLint height;
+  float resource_finalize_budget_ms;
 
   // The default framebuffer
   GLint default_framebuffer;
@@ -99,6 +100,9 @@ struct GLRenderSystem::State {
   bool initialized_render_scene = false;
   RenderScene_Commands render_scene;
   RenderResource resources;
+
+  // Nodes whose render transforms were interpolated last frame
+  std::vector<NodeId> interpolated_nodes;
 };
 }  // namespace gl_render
 }  // namespace sge
@@ -1,8 +1,9 @@
-#include <fstream>
 #include <iostream>
+#include <string>
 
 #include "lib/gl_render/gl_shader.h"
 #include "lib/gl_render/util.h"
+#include "lib/resource/sources/resource_source.h"
 
 namespace sge {
 namespace gl_render {
@@ -17,17 +18,15 @@ GLuint create_shader(GLenum type, const char* source) {
 }
 
 GLuint load_shader(GLenum type, const char* path) {
-  // Open a file containing the shader source code
-  std::ifstream file{path};
-
-  // Figure out the size of the file
-  file.seekg(0, std::ios::end);
-  size_t len = static_cast<size_t>(file.tellg());
-  file.seekg(0);
-
-  // Allocate a string for the source code
-  std::string source(len, ' ');
-  file.read(&source[0], len);
+  // Open the resource containing the shader source code
+  ResourceData resource;
+  if (!open_resource(path, true, resource)) {
+    std::cerr << "Could not open shader '" << path << "'" << std::endl;
+    return 0;
+  }
+
+  // Copy it into a string, since the source code must be null-terminated
+  const std::string source(reinterpret_cast<const char*>(resource.data), resource.size);
 
   // Compile the shader
   return create_shader(type, source.c_str());
@@ -1,3 +1,4 @@
+#include <stddef.h>
 #include <stdint.h>
 
 #include "lib/gl_render/gl_material.h"
@@ -8,55 +9,62 @@ namespace gl_render {
 namespace gl_static_mesh {
 void upload_static_mesh_vertex_data(
     GLuint vao,
-    const GLuint vertex_buffers[],
+    GLuint vbo,
     size_t num_vertices,
-    const Vec3* vertex_positions,
-    const HalfVec3* vertex_normals,
-    const HalfVec3* vertex_tangents,
-    const int8_t* vertex_bitangent_signs,
-    const UHalfVec2* material_uv_coords,
-    const UHalfVec2* lightmap_uv_coords
+    const sge::StaticMesh::InterleavedVertex* vertices
 ) {
+  using Vertex = sge::StaticMesh::InterleavedVertex;
+
   // Bind VAO
   glBindVertexArray(vao);
 
-  // Upload vertex position data
-  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffers[POSITION_BUFFER_INDEX]);
-  glBufferData(GL_ARRAY_BUFFER, num_vertices * sizeof(Vec3), vertex_positions, GL_STATIC_DRAW);
+  // Upload vertex data
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  glBufferData(GL_ARRAY_BUFFER, num_vertices * sizeof(Vertex), vertices, GL_STATIC_DRAW);
 
   // Define vertex position specification
   glEnableVertexAttribArray(gl_material::POSITION_ATTRIB_LOCATION);
-  glVertexAttribPointer(gl_material::POSITION_ATTRIB_LOCATION, 3, GL_FLOAT, GL_FALSE, sizeof(Vec3), nullptr);
-
-  // Upload normal buffer
-  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffers[NORMAL_BUFFER_INDEX]);
-  glBufferData(GL_ARRAY_BUFFER, num_vertices * sizeof(HalfVec3), vertex_normals, GL_STATIC_DRAW);
+  glVertexAttribPointer(
+      gl_material::POSITION_ATTRIB_LOCATION,
+      3,
+      GL_FLOAT,
+      GL_FALSE,
+      sizeof(Vertex),
+      reinterpret_cast<const void*>(offsetof(Vertex, position))
+  );
 
   // Define vertex normal specification
   glEnableVertexAttribArray(gl_material::NORMAL_ATTRIB_LOCATION);
-  glVertexAttribPointer(gl_material::NORMAL_ATTRIB_LOCATION, 3, GL_SHORT, GL_TRUE, sizeof(HalfVec3), nullptr);
-
-  // Upload tangent buffer
-  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffers[TANGENT_BUFFER_INDEX]);
-  glBufferData(GL_ARRAY_BUFFER, num_vertices * sizeof(HalfVec3), vertex_tangents, GL_STATIC_DRAW);
+  glVertexAttribPointer(
+      gl_material::NORMAL_ATTRIB_LOCATION,
+      4,
+      GL_INT_2_10_10_10_REV,
+      GL_TRUE,
+      sizeof(Vertex),
+      reinterpret_cast<const void*>(offsetof(Vertex, normal))
+  );
 
   // Define vertex tangent specification
   glEnableVertexAttribArray(gl_material::TANGENT_ATTRIB_LOCATION);
   glVertexAttribPointer(
-      gl_material::TANGENT_ATTRIB_LOCATION, 3, GL_SHORT, GL_TRUE, sizeof(HalfVec3), nullptr
+      gl_material::TANGENT_ATTRIB_LOCATION,
+      4,
+      GL_INT_2_10_10_10_REV,
+      GL_TRUE,
+      sizeof(Vertex),
+      reinterpret_cast<const void*>(offsetof(Vertex, tangent))
   );
 
-  // Upload bitangent sign buffer
-  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffers[BITANGENT_SIGN_BUFFER_INDEX]);
-  glBufferData(GL_ARRAY_BUFFER, num_vertices, vertex_bitangent_signs, GL_STATIC_DRAW);
-
   // Define bitangent specification
   glEnableVertexAttribArray(gl_material::BITANGENT_SIGN_ATTRIB_LOCATION);
-  glVertexAttribPointer(gl_material::BITANGENT_SIGN_ATTRIB_LOCATION, 1, GL_BYTE, GL_FALSE, 1, nullptr);
-
-  // Upload material uv data
-  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffers[MATERIAL_UV_BUFFER_INDEX]);
-  glBufferData(GL_ARRAY_BUFFER, num_vertices * sizeof(UHalfVec2), material_uv_coords, GL_STATIC_DRAW);
+  glVertexAttribPointer(
+      gl_material::BITANGENT_SIGN_ATTRIB_LOCATION,
+      1,
+      GL_BYTE,
+      GL_FALSE,
+      sizeof(Vertex),
+      reinterpret_cast<const void*>(offsetof(Vertex, bitangent_sign))
+  );
 
   // Define vertex material uv specification
   glEnableVertexAttribArray(gl_material::MATERIAL_TEXCOORD_ATTRIB_LOCATION);
@@ -65,14 +73,10 @@ void upload_static_mesh_vertex_data(
       2,
       GL_UNSIGNED_SHORT,
       GL_TRUE,
-      sizeof(UHalfVec2),
-      nullptr
+      sizeof(Vertex),
+      reinterpret_cast<const void*>(offsetof(Vertex, material_uv))
   );
 
-  // Upload lightmap uv data
-  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffers[LIGHTMAP_UV_BUFFER_INDEX]);
-  glBufferData(GL_ARRAY_BUFFER, num_vertices * sizeof(UHalfVec2), lightmap_uv_coords, GL_STATIC_DRAW);
-
   // Define vertex lightmap uv specification
   glEnableVertexAttribArray(gl_material::LIGHTMAP_TEXCOORD_ATTRIB_LOCATION);
   glVertexAttribPointer(
@@ -80,8 +84,8 @@ void upload_static_mesh_vertex_data(
       2,
       GL_UNSIGNED_SHORT,
       GL_TRUE,
-      sizeof(UHalfVec2),
-      nullptr
+      sizeof(Vertex),
+      reinterpret_cast<const void*>(offsetof(Vertex, lightmap_uv))
   );
 
   // Unbind
@@ -89,15 +93,47 @@ void upload_static_mesh_vertex_data(
   glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
-void upload_static_mesh_elements(GLuint vao, GLuint ebo, size_t num_elements, const uint32_t* elements) {
+void upload_static_mesh_elements(
+    GLuint vao,
+    GLuint ebo,
+    const sge::StaticMesh& mesh,
+    std::vector<LodSlice>& out_lods
+) {
   // Bind the vertex array object
   glBindVertexArray(vao);
 
   // Bind the element buffer object
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
 
+  // Lay out each LOD after the full mesh
+  size_t num_elements = mesh.num_triangle_elements();
+  out_lods.clear();
+  for (size_t i = 0; i < mesh.num_lods(); ++i) {
+    const auto& lod = mesh.lods()[i];
+    LodSlice slice;
+    slice.start_element_index = static_cast<uint32_t>(num_elements);
+    slice.num_element_indices = static_cast<uint32_t>(lod.triangle_elements.size);
+    slice.error = lod.error;
+    out_lods.push_back(slice);
+    num_elements += lod.triangle_elements.size;
+  }
+
   // Upload the data
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, num_elements * sizeof(uint32_t), elements, GL_STATIC_DRAW);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, num_elements * sizeof(uint32_t), nullptr, GL_STATIC_DRAW);
+  glBufferSubData(
+      GL_ELEMENT_ARRAY_BUFFER,
+      0,
+      mesh.num_triangle_elements() * sizeof(uint32_t),
+      mesh.triangle_elements()
+  );
+  for (size_t i = 0; i < mesh.num_lods(); ++i) {
+    glBufferSubData(
+        GL_ELEMENT_ARRAY_BUFFER,
+        out_lods[i].start_element_index * sizeof(uint32_t),
+        out_lods[i].num_element_indices * sizeof(uint32_t),
+        mesh.lods()[i].triangle_elements.data.get()
+    );
+  }
 
   // Unbind
   glBindVertexArray(0);
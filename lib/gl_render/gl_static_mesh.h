@@ -1,71 +1,87 @@
 #pragma once
 
 #include <stdint.h>
-#include <array>
+#include <memory>
+#include <vector>
 
-#include "lib/base/math/ivec2.h"
-#include "lib/base/math/ivec3.h"
-#include "lib/base/math/vec3.h"
 #include "lib/gl_render/glew.h"
+#include "lib/resource/resources/static_mesh.h"
 
 namespace sge {
 namespace gl_render {
 namespace gl_static_mesh {
-enum BufferIndex {
-  POSITION_BUFFER_INDEX,
-  NORMAL_BUFFER_INDEX,
-  TANGENT_BUFFER_INDEX,
-  BITANGENT_BUFFER_INDEX,
-  BITANGENT_SIGN_BUFFER_INDEX,
-  MATERIAL_UV_BUFFER_INDEX,
-  LIGHTMAP_UV_BUFFER_INDEX,
-  NUM_VERTEX_BUFFERS
-};
-
 struct MeshSlice {
   GLuint material = 0;
   uint32_t start_element_index = 0;
   uint32_t num_element_indices = 0;
 };
 
+/**
+ * \brief A range of the element buffer holding a simplified version of the mesh, which may be drawn in place
+ * of it once its error is small enough on screen.
+ */
+struct LodSlice {
+  uint32_t start_element_index = 0;
+  uint32_t num_element_indices = 0;
+
+  /* How far the LOD's surface may be from the full mesh's, relative to 'bounds_radius'. */
+  float error = 0.f;
+};
+
+/**
+ * \brief Clusters of a mesh's elements, which may be culled individually.
+ */
+struct Clusters {
+  std::vector<sge::StaticMesh::ClusterRange> ranges;
+  std::vector<sge::StaticMesh::ClusterBounds> bounds;
+};
+
 struct StaticMesh {
   GLuint vao = 0;
   GLuint ebo = 0;
   GLint num_total_elements = 0;
-  std::array<GLuint, NUM_VERTEX_BUFFERS> vertex_buffers;
+  GLuint vertex_buffer = 0;
   std::vector<MeshSlice> material_slices;
+
+  /* LODs of the mesh from most to least detailed, after the full mesh in the element buffer. This is shared
+   * with every command set drawing the mesh, and null if the mesh has no LODs. */
+  std::shared_ptr<const std::vector<LodSlice>> lods;
+
+  /* Clusters of the full mesh, if it's large enough to have them. */
+  std::shared_ptr<const Clusters> clusters;
+
+  /* Sphere enclosing the mesh, in its local space. */
+  Vec3 bounds_center = Vec3::zero();
+  float bounds_radius = 0.f;
 };
 
 /**
- * \brief Uploads vertex data for the given static mesh.
+ * \brief Uploads vertex data for the given static mesh, and points every vertex attribute at it.
+ * \param vao The VAO of the mesh to associate the vertex buffer with.
+ * \param vbo The buffer to store the vertices in.
  * \param num_vertices The number of vertices in the mesh.
- * \param vertex_positions Array of vertex positions.
- * \param vertex_normals Array of vertex normals.
- * \param vertex_tangents Array of vertex tangents.
- * \param vertex_bitangent_signs Array of bitangent signs.
- * \param material_uv_coords Array of material UV coordinates.
- * \param lightmap_uv_coords Array of lightmap UV coordaintes.
+ * \param vertices Array of interleaved vertices.
  */
 void upload_static_mesh_vertex_data(
     GLuint vao,
-    const GLuint vertex_buffers[],
+    GLuint vbo,
     size_t num_vertices,
-    const Vec3* vertex_positions,
-    const HalfVec3* vertex_normals,
-    const HalfVec3* vertex_tangents,
-    const int8_t* vertex_bitangent_signs,
-    const UHalfVec2* material_uv_coords,
-    const UHalfVec2* lightmap_uv_coords
+    const sge::StaticMesh::InterleavedVertex* vertices
 );
 
 /**
- * \brief Uploads the given element buffer.
- * \param num_elements The number of elements to upload.
- * \param elements The elements to upload.
+ * \brief Uploads the elements of the given mesh, followed by those of each of its LODs.
  * \param vao The VAO of the mesh to associate the element buffer with.
  * \param ebo The buffer to store the elements in.
+ * \param mesh The mesh to upload the elements of.
+ * \param out_lods Set to where each of the mesh's LODs were uploaded to.
  */
-void upload_static_mesh_elements(GLuint vao, GLuint ebo, size_t num_elements, const uint32_t* elements);
+void upload_static_mesh_elements(
+    GLuint vao,
+    GLuint ebo,
+    const sge::StaticMesh& mesh,
+    std::vector<LodSlice>& out_lods
+);
 }  // namespace gl_static_mesh
 }  // namespace gl_render
 }  // namespace sge
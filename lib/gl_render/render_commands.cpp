@@ -38,6 +38,28 @@ void RenderCommand_bind_material(
   glProgramUniformMatrix4fv(program_id, uniforms.proj_matrix_uniform, 1, GL_FALSE, proj_matrix.vec());
 }
 
+static void bind_mesh_instance(
+    const gl_material::MaterialStandardUniforms uniforms,
+    const RenderCommand_MeshInstance& instance
+) {
+  // Set lightmap parameters
+  glActiveTexture(gl_material::LIGHTMAP_X_BASIS_TEXTURE_SLOT);
+  glBindTexture(GL_TEXTURE_2D, instance.lightmap_x_basis);
+  glActiveTexture(gl_material::LIGHTMAP_Y_BASIS_TEXTURE_SLOT);
+  glBindTexture(GL_TEXTURE_2D, instance.lightmap_y_basis);
+  glActiveTexture(gl_material::LIGHTMAP_Z_BASIS_TEXTURE_SLOT);
+  glBindTexture(GL_TEXTURE_2D, instance.lightmap_z_basis);
+  glActiveTexture(gl_material::LIGHTMAP_DIRECT_MASK_TEXTURE_SLOT);
+  glBindTexture(GL_TEXTURE_2D, instance.lightmap_direct_mask);
+  glUniform1i(uniforms.use_lightmap_uniform, instance.lightmap_x_basis == 0 ? 0 : 1);
+
+  // Set model matrix
+  glUniformMatrix4fv(uniforms.model_matrix_uniform, 1, GL_FALSE, instance.world_transform.vec());
+
+  // Set instance UV Scale
+  glUniform2fv(uniforms.inst_mat_uv_scale_uniform, 1, instance.mat_uv_scale.vec());
+}
+
 void RenderCommand_render_meshes(
     const gl_material::MaterialStandardUniforms uniforms,
     const RenderCommand_Mesh& mesh,
@@ -48,35 +70,31 @@ void RenderCommand_render_meshes(
   glBindVertexArray(mesh.vao);
 
   for (size_t i = 0; i < num_instances; ++i) {
-    // Set lightmap parameters
-    glActiveTexture(gl_material::LIGHTMAP_X_BASIS_TEXTURE_SLOT);
-    glBindTexture(GL_TEXTURE_2D, instances[i].lightmap_x_basis);
-    glActiveTexture(gl_material::LIGHTMAP_Y_BASIS_TEXTURE_SLOT);
-    glBindTexture(GL_TEXTURE_2D, instances[i].lightmap_y_basis);
-    glActiveTexture(gl_material::LIGHTMAP_Z_BASIS_TEXTURE_SLOT);
-    glBindTexture(GL_TEXTURE_2D, instances[i].lightmap_z_basis);
-    glActiveTexture(gl_material::LIGHTMAP_DIRECT_MASK_TEXTURE_SLOT);
-    glBindTexture(GL_TEXTURE_2D, instances[i].lightmap_direct_mask);
-    glUniform1i(uniforms.use_lightmap_uniform, instances[i].lightmap_x_basis == 0 ? 0 : 1);
-
-    // Set model matrix
-    glUniformMatrix4fv(uniforms.model_matrix_uniform, 1, GL_FALSE, instances[i].world_transform.vec());
-
-    // Set instance UV Scale
-    glUniform2fv(uniforms.inst_mat_uv_scale_uniform, 1, instances[i].mat_uv_scale.vec());
+    bind_mesh_instance(uniforms, instances[i]);
 
     // Draw the mesh
-    glDrawRangeElements(
+    glDrawElements(
         GL_TRIANGLES,
-        mesh.start_element_index,
-        mesh.start_element_index + mesh.num_element_indices,
         mesh.num_element_indices,
         GL_UNSIGNED_INT,
-        nullptr
+        reinterpret_cast<const void*>(mesh.start_element_index * sizeof(GLuint))
     );
   }
 }
 
+void RenderCommand_render_mesh_ranges(
+    const gl_material::MaterialStandardUniforms uniforms,
+    const GLuint vao,
+    const RenderCommand_MeshInstance& instance,
+    const GLsizei* counts,
+    const void* const* offsets,
+    size_t num_ranges
+) {
+  glBindVertexArray(vao);
+  bind_mesh_instance(uniforms, instance);
+  glMultiDrawElements(GL_TRIANGLES, counts, GL_UNSIGNED_INT, offsets, static_cast<GLsizei>(num_ranges));
+}
+
 void RenderCommand_render_lines(const RenderCommand_Lines* line_sets, size_t num_line_sets) {
   for (size_t i = 0; i < num_line_sets; ++i) {
     glBindVertexArray(line_sets[i].vao);
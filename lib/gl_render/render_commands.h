@@ -65,6 +65,24 @@ void RenderCommand_render_meshes(
     size_t num_instances
 );
 
+/**
+ * \brief Renders ranges of the given mesh's elements for a single instance, with one draw call.
+ * \param uniforms Uniform locations for the currently bound material.
+ * \param vao The mesh to render.
+ * \param instance The instance of the mesh to render.
+ * \param counts The number of elements in each range.
+ * \param offsets The byte offset of each range within the mesh's element buffer.
+ * \param num_ranges The number of ranges to render.
+ */
+void RenderCommand_render_mesh_ranges(
+    const gl_material::MaterialStandardUniforms uniforms,
+    const GLuint vao,
+    const RenderCommand_MeshInstance& instance,
+    const GLsizei* counts,
+    const void* const* offsets,
+    size_t num_ranges
+);
+
 /**
  * \brief Command to render sets of lines to the currently bound framebuffer with the currently bound material
  * and parameters. \param lines Sets of lines to draw. NOTE: You can have arbitrarily many lines within the
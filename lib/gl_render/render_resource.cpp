@@ -1,7 +1,10 @@
 #include <stdio.h>
+#include <chrono>
+#include <exception>
 
 #include "lib/gl_render/gl_texture_2d.h"
 #include "lib/gl_render/render_resource.h"
+#include "lib/resource/cache/resource_cache.h"
 #include "lib/resource/resources/hdr_image.h"
 #include "lib/resource/resources/image.h"
 #include "lib/resource/resources/material.h"
@@ -10,97 +13,312 @@
 
 namespace sge {
 namespace gl_render {
-const gl_material::Material&
-RenderResource_get_material_resource(RenderResource& resources, const char* path) {
-  auto iter = resources.material_resources.find(path);
-  if (iter == resources.material_resources.end()) {
-    // Create the material from the archive
-    Material material;
-    const auto loaded = material.from_file(path);
+static gl_material::Material create_material(RenderResource& resources, const Material& material) {
+  // Load shaders required by this material
+  const auto v_shader = RenderResource_get_shader_resource(resources, material.vertex_shader().c_str());
+  const auto f_shader = RenderResource_get_shader_resource(resources, material.pixel_shader().c_str());
+
+  // Create the material
+  gl_material::Material gl_mat;
+  gl_mat.program_id = gl_material::new_standard_material_program(v_shader, f_shader);
+  debug_program_status(gl_mat.program_id, GLDebugOutputMode::ONLY_ERROR);
+
+  // Get standard uniforms for the material program
+  gl_material::get_material_standard_uniforms(gl_mat.program_id, &gl_mat.uniforms);
+
+  // Set constant uniform parameters
+  glUseProgram(gl_mat.program_id);
+  glUniform1i(gl_mat.uniforms.lightmap_x_basis_uniform, 0);
+  glUniform1i(gl_mat.uniforms.lightmap_y_basis_uniform, 1);
+  glUniform1i(gl_mat.uniforms.lightmap_z_basis_uniform, 2);
+  glUniform1i(gl_mat.uniforms.lightmap_direct_mask_uniform, 3);
+  glUniform2fv(gl_mat.uniforms.base_mat_uv_scale_uniform, 1, material.base_uv_scale().vec());
+  glUseProgram(0);
+
+  // Get all of the default int parameters for this material
+  for (const auto& int_param : material.param_table().bool_params) {
+    const auto uniform_loc = gl_material::get_uniform_location(gl_mat.program_id, int_param.first.c_str());
+    if (uniform_loc != -1) {
+      gl_mat.params.int_params[uniform_loc] = int_param.second ? 1 : 0;
+    }
+  }
 
-    // If the material could not be loaded, return missing material
-    if (!loaded) {
-      if (strlen(path) != 0) {
-        printf("WARNING: GLRenderSystem could not load material '%s'\n", path);
-      }
+  // Get all default float parameters
+  for (const auto& float_param : material.param_table().float_params) {
+    const auto uniform_loc =
+        gl_material::get_uniform_location(gl_mat.program_id, float_param.first.c_str());
+    if (uniform_loc != -1) {
+      gl_mat.params.float_params[uniform_loc] = float_param.second;
+    }
+  }
 
-      return resources.missing_material;
+  // Get all default Vec2 parameters
+  for (const auto& vec2_param : material.param_table().vec2_params) {
+    const auto uniform_loc = gl_material::get_uniform_location(gl_mat.program_id, vec2_param.first.c_str());
+    if (uniform_loc != -1) {
+      gl_mat.params.vec2_params[uniform_loc] = vec2_param.second;
     }
+  }
 
-    // Load shaders required by this material
-    const auto v_shader = RenderResource_get_shader_resource(resources, material.vertex_shader().c_str());
-    const auto f_shader = RenderResource_get_shader_resource(resources, material.pixel_shader().c_str());
-
-    // Create the material
-    gl_material::Material gl_mat;
-    gl_mat.program_id = gl_material::new_standard_material_program(v_shader, f_shader);
-    debug_program_status(gl_mat.program_id, GLDebugOutputMode::ONLY_ERROR);
-
-    // Get standard uniforms for the material program
-    gl_material::get_material_standard_uniforms(gl_mat.program_id, &gl_mat.uniforms);
-
-    // Set constant uniform parameters
-    glUseProgram(gl_mat.program_id);
-    glUniform1i(gl_mat.uniforms.lightmap_x_basis_uniform, 0);
-    glUniform1i(gl_mat.uniforms.lightmap_y_basis_uniform, 1);
-    glUniform1i(gl_mat.uniforms.lightmap_z_basis_uniform, 2);
-    glUniform1i(gl_mat.uniforms.lightmap_direct_mask_uniform, 3);
-    glUniform2fv(gl_mat.uniforms.base_mat_uv_scale_uniform, 1, material.base_uv_scale().vec());
-    glUseProgram(0);
-
-    // Get all of the default int parameters for this material
-    for (const auto& int_param : material.param_table().bool_params) {
-      const auto uniform_loc = gl_material::get_uniform_location(gl_mat.program_id, int_param.first.c_str());
-      if (uniform_loc != -1) {
-        gl_mat.params.int_params[uniform_loc] = int_param.second ? 1 : 0;
-      }
+  // Get all default Vec3 parameters
+  for (const auto& vec3_param : material.param_table().vec3_params) {
+    const auto uniform_loc = gl_material::get_uniform_location(gl_mat.program_id, vec3_param.first.c_str());
+    if (uniform_loc != -1) {
+      gl_mat.params.vec3_params[uniform_loc] = vec3_param.second;
     }
+  }
 
-    // Get all default float parameters
-    for (const auto& float_param : material.param_table().float_params) {
-      const auto uniform_loc =
-          gl_material::get_uniform_location(gl_mat.program_id, float_param.first.c_str());
-      if (uniform_loc != -1) {
-        gl_mat.params.float_params[uniform_loc] = float_param.second;
-      }
+  // Get all default Vec4 parameters
+  for (const auto& vec4_param : material.param_table().vec4_params) {
+    const auto uniform_loc = gl_material::get_uniform_location(gl_mat.program_id, vec4_param.first.c_str());
+    if (uniform_loc != -1) {
+      gl_mat.params.vec4_params[uniform_loc] = vec4_param.second;
+    }
+  }
+
+  // Get all texture parameters
+  for (const auto& tex_param : material.param_table().texture_params) {
+    const auto uniform_loc = gl_material::get_uniform_location(gl_mat.program_id, tex_param.first.c_str());
+    if (uniform_loc != -1) {
+      // Get the texture resource
+      const auto tex_id =
+          RenderResource_get_texture_2d_resource(resources, tex_param.second.c_str(), false);
+      gl_mat.params.tex_params[uniform_loc] = tex_id;
     }
+  }
+
+  return gl_mat;
+}
+
+static gl_static_mesh::StaticMesh
+create_static_mesh(const StaticMesh& static_mesh, const StaticMesh::InterleavedVertex* vertices) {
+  // Create a GLStaticMesh from the loaded mesh object
+  gl_static_mesh::StaticMesh gl_mesh;
+  glGenVertexArrays(1, &gl_mesh.vao);
+  glGenBuffers(1, &gl_mesh.ebo);
+  glGenBuffers(1, &gl_mesh.vertex_buffer);
+
+  // Upload data
+  gl_static_mesh::upload_static_mesh_vertex_data(
+      gl_mesh.vao, gl_mesh.vertex_buffer, static_mesh.num_verts(), vertices
+  );
+  std::vector<gl_static_mesh::LodSlice> lods;
+  gl_static_mesh::upload_static_mesh_elements(gl_mesh.vao, gl_mesh.ebo, static_mesh, lods);
+  gl_mesh.num_total_elements = static_cast<GLint>(static_mesh.num_triangle_elements());
+  static_mesh.bounding_sphere(gl_mesh.bounds_center, gl_mesh.bounds_radius);
+  if (!lods.empty()) {
+    gl_mesh.lods = std::make_shared<const std::vector<gl_static_mesh::LodSlice>>(std::move(lods));
+  }
+
+  const auto num_clusters = static_mesh.num_clusters();
+  if (num_clusters != 0) {
+    auto clusters = std::make_shared<gl_static_mesh::Clusters>();
+    clusters->ranges.assign(static_mesh.cluster_ranges(), static_mesh.cluster_ranges() + num_clusters);
+    clusters->bounds.assign(static_mesh.cluster_bounds(), static_mesh.cluster_bounds() + num_clusters);
+    gl_mesh.clusters = std::move(clusters);
+  }
+
+  return gl_mesh;
+}
+
+static void add_material_slice(
+    gl_static_mesh::StaticMesh& gl_mesh,
+    const StaticMesh::Material& mat,
+    const gl_material::Material& gl_mat
+) {
+  gl_static_mesh::MeshSlice slice;
+  slice.material = gl_mat.program_id;
+  slice.start_element_index = mat.start_elem_index();
+  slice.num_element_indices = mat.num_elem_indices();
+  gl_mesh.material_slices.push_back(slice);
+}
+
+static GLuint create_image_texture(const Image& texture) {
+  // Figure out the color format of the image
+  GLenum format;
+  switch (texture.get_colorspace()) {
+    case Image::ColorSpace::Linear:
+      format = GL_RGBA8;
+      break;
+
+    case Image::ColorSpace::SRGB:
+      format = GL_SRGB8_ALPHA8;
+      break;
+
+    default:
+      assert(false);
+      return 0;
+  }
 
-    // Get all default Vec2 parameters
-    for (const auto& vec2_param : material.param_table().vec2_params) {
-      const auto uniform_loc = gl_material::get_uniform_location(gl_mat.program_id, vec2_param.first.c_str());
-      if (uniform_loc != -1) {
-        gl_mat.params.vec2_params[uniform_loc] = vec2_param.second;
+  // Create an opengl texture from the texture object
+  return create_texture(
+      texture.get_width(), texture.get_height(), texture.get_bitmap(), format, GL_RGBA, GL_UNSIGNED_BYTE
+  );
+}
+
+static void load_resource(RenderResource_Load& load) {
+  switch (load.type) {
+    case RenderResource_Load::Type::STATIC_MESH:
+      load.static_mesh = ResourceCache::global().get_static_mesh(load.path);
+      if (load.static_mesh) {
+        load.vertices.resize(load.static_mesh->num_verts());
+        load.static_mesh->interleave_vertices(load.vertices.data());
+      }
+      break;
+
+    case RenderResource_Load::Type::MATERIAL:
+      load.material = ResourceCache::global().get_material(load.path);
+      if (!load.material) {
+        break;
       }
+
+      // Decode the material's textures as well, so that only their upload is left for the render thread
+      for (const auto& tex_param : load.material->param_table().texture_params) {
+        auto texture = ResourceCache::global().get_image(tex_param.second);
+        if (!texture) {
+          printf("WARNING: GLRenderSystem could not load texture '%s'\n", tex_param.second.c_str());
+        }
+        load.textures.emplace_back(tex_param.second, std::move(texture));
+      }
+      break;
+  }
+}
+
+/* Leaves the load empty, so that finalizing it falls back to the missing mesh or material. */
+static void fail_load(RenderResource_Load& load) {
+  load.static_mesh = nullptr;
+  load.material = nullptr;
+  load.vertices.clear();
+  load.textures.clear();
+}
+
+static void run_loader(RenderResource& resources) {
+  std::unique_lock<std::mutex> lock{resources.loader_mutex};
+  while (true) {
+    resources.loader_cond.wait(lock, [&resources]() {
+      return resources.stopping_loaders || !resources.load_requests.empty();
+    });
+    if (resources.stopping_loaders) {
+      return;
+    }
+
+    auto load = std::move(resources.load_requests.front());
+    resources.load_requests.pop_front();
+    lock.unlock();
+    try {
+      load_resource(*load);
+    } catch (const std::exception& error) {
+      printf("WARNING: GLRenderSystem failed loading '%s': %s\n", load->path.c_str(), error.what());
+      fail_load(*load);
+    } catch (...) {
+      printf("WARNING: GLRenderSystem failed loading '%s'\n", load->path.c_str());
+      fail_load(*load);
     }
+    lock.lock();
+
+    resources.completed_loads.push_back(std::move(load));
+  }
+}
+
+static void request_load(RenderResource& resources, RenderResource_Load::Type type, const char* path) {
+  auto load = std::make_unique<RenderResource_Load>();
+  load->type = type;
+  load->path = path;
+
+  {
+    std::lock_guard<std::mutex> lock{resources.loader_mutex};
+    resources.load_requests.push_back(std::move(load));
+  }
+  resources.loader_cond.notify_one();
+
+  // Start the loader threads on first use
+  if (resources.loader_threads.empty()) {
+    for (size_t i = 0; i < RENDER_RESOURCE_NUM_LOADER_THREADS; ++i) {
+      resources.loader_threads.emplace_back([&resources]() { run_loader(resources); });
+    }
+  }
+}
 
-    // Get all default Vec3 parameters
-    for (const auto& vec3_param : material.param_table().vec3_params) {
-      const auto uniform_loc = gl_material::get_uniform_location(gl_mat.program_id, vec3_param.first.c_str());
-      if (uniform_loc != -1) {
-        gl_mat.params.vec3_params[uniform_loc] = vec3_param.second;
+static void finalize_load(RenderResource& resources, RenderResource_Load& load) {
+  switch (load.type) {
+    case RenderResource_Load::Type::STATIC_MESH: {
+      resources.pending_static_meshes.erase(load.path);
+
+      // Meshes that couldn't be loaded keep using the missing mesh, rather than being requested again
+      if (!load.static_mesh) {
+        printf("WARNING: GLRenderSystem could not load mesh '%s'\n", load.path.c_str());
+        resources.static_mesh_resources.insert(std::make_pair(load.path, resources.missing_mesh));
+        break;
+      }
+
+      auto gl_mesh = create_static_mesh(*load.static_mesh, load.vertices.data());
+      for (size_t i = 0; i < load.static_mesh->num_materials(); ++i) {
+        const auto& mat = load.static_mesh->materials()[i];
+        const auto* const gl_mat = RenderResource_request_material_resource(resources, mat.path().c_str());
+        add_material_slice(gl_mesh, mat, gl_mat ? *gl_mat : resources.missing_material);
       }
+
+      resources.static_mesh_resources.insert(std::make_pair(load.path, std::move(gl_mesh)));
+      break;
     }
 
-    // Get all default Vec4 parameters
-    for (const auto& vec4_param : material.param_table().vec4_params) {
-      const auto uniform_loc = gl_material::get_uniform_location(gl_mat.program_id, vec4_param.first.c_str());
-      if (uniform_loc != -1) {
-        gl_mat.params.vec4_params[uniform_loc] = vec4_param.second;
+    case RenderResource_Load::Type::MATERIAL: {
+      resources.pending_materials.erase(load.path);
+
+      // Materials that couldn't be loaded keep using the missing material, rather than being requested again
+      if (!load.material) {
+        printf("WARNING: GLRenderSystem could not load material '%s'\n", load.path.c_str());
+        resources.material_resources.insert(std::make_pair(load.path, resources.missing_material));
+        break;
+      }
+
+      // Upload the material's textures, so they're found when creating it. Missing textures are left empty.
+      const Image empty_texture;
+      for (const auto& texture : load.textures) {
+        if (resources.texture_2d_resources.find(texture.first) == resources.texture_2d_resources.end()) {
+          const auto gl_tex = create_image_texture(texture.second ? *texture.second : empty_texture);
+          resources.texture_2d_resources.insert(std::make_pair(texture.first, gl_tex));
+        }
       }
+
+      resources.material_resources.insert(
+          std::make_pair(load.path, create_material(resources, *load.material))
+      );
+      break;
     }
+  }
+}
+
+RenderResource::~RenderResource() {
+  {
+    std::lock_guard<std::mutex> lock{loader_mutex};
+    stopping_loaders = true;
+  }
+  loader_cond.notify_all();
+
+  for (auto& thread : loader_threads) {
+    thread.join();
+  }
+}
+
+const gl_material::Material&
+RenderResource_get_material_resource(RenderResource& resources, const char* path) {
+  auto iter = resources.material_resources.find(path);
+  if (iter == resources.material_resources.end()) {
+    // Get the material from the resource cache
+    const auto material = ResourceCache::global().get_material(path);
 
-    // Get all texture parameters
-    for (const auto& tex_param : material.param_table().texture_params) {
-      const auto uniform_loc = gl_material::get_uniform_location(gl_mat.program_id, tex_param.first.c_str());
-      if (uniform_loc != -1) {
-        // Get the texture resource
-        const auto tex_id =
-            RenderResource_get_texture_2d_resource(resources, tex_param.second.c_str(), false);
-        gl_mat.params.tex_params[uniform_loc] = tex_id;
+    // If the material could not be loaded, return missing material
+    if (!material) {
+      if (strlen(path) != 0) {
+        printf("WARNING: GLRenderSystem could not load material '%s'\n", path);
       }
+
+      return resources.missing_material;
     }
 
     // Put it into the resource table
+    auto gl_mat = create_material(resources, *material);
     iter = resources.material_resources.insert(std::make_pair(path, std::move(gl_mat))).first;
   }
 
@@ -111,51 +329,22 @@ const gl_static_mesh::StaticMesh&
 RenderResource_get_static_mesh_resource(RenderResource& resources, const char* path) {
   auto iter = resources.static_mesh_resources.find(path);
   if (iter == resources.static_mesh_resources.end()) {
-    // Load the mesh from the file
-    StaticMesh static_mesh;
-    const bool loaded = static_mesh.from_file(path);
+    // Get the mesh from the resource cache
+    const auto static_mesh = ResourceCache::global().get_static_mesh(path);
 
     // If the mesh could not be loaded, return the missing mesh object
-    if (!loaded) {
+    if (!static_mesh) {
       printf("WARNING: GLRenderSystem could not load mesh '%s'\n", path);
       return resources.missing_mesh;
     }
 
-    // Create a GLStaticMesh from the loaded mesh object
-    gl_static_mesh::StaticMesh gl_mesh;
-    glGenVertexArrays(1, &gl_mesh.vao);
-    glGenBuffers(1, &gl_mesh.ebo);
-    glGenBuffers(gl_static_mesh::NUM_VERTEX_BUFFERS, gl_mesh.vertex_buffers.data());
-
-    // Upload data
-    gl_static_mesh::upload_static_mesh_vertex_data(
-        gl_mesh.vao,
-        gl_mesh.vertex_buffers.data(),
-        static_mesh.num_verts(),
-        static_mesh.vertex_positions(),
-        static_mesh.vertex_normals(),
-        static_mesh.vertex_tangents(),
-        static_mesh.bitangent_signs(),
-        static_mesh.material_uv(),
-        static_mesh.lightmap_uv()
-    );
-    gl_static_mesh::upload_static_mesh_elements(
-        gl_mesh.vao, gl_mesh.ebo, static_mesh.num_triangle_elements(), static_mesh.triangle_elements()
-    );
-    gl_mesh.num_total_elements = static_cast<GLint>(static_mesh.num_triangle_elements());
-
-    // Create each material slice for the mesh
-    for (size_t i = 0; i < static_mesh.num_materials(); ++i) {
-      // Get the material
-      const auto& mat = static_mesh.materials()[i];
-      const auto& gl_mat = RenderResource_get_material_resource(resources, mat.path().c_str());
-
-      // Create the slice
-      gl_static_mesh::MeshSlice slice;
-      slice.material = gl_mat.program_id;
-      slice.start_element_index = mat.start_elem_index();
-      slice.num_element_indices = mat.num_elem_indices();
-      gl_mesh.material_slices.push_back(slice);
+    // Upload its vertices, and create each material slice for the mesh
+    std::vector<StaticMesh::InterleavedVertex> vertices(static_mesh->num_verts());
+    static_mesh->interleave_vertices(vertices.data());
+    auto gl_mesh = create_static_mesh(*static_mesh, vertices.data());
+    for (size_t i = 0; i < static_mesh->num_materials(); ++i) {
+      const auto& mat = static_mesh->materials()[i];
+      add_material_slice(gl_mesh, mat, RenderResource_get_material_resource(resources, mat.path().c_str()));
     }
 
     // Insert it into the resource table
@@ -165,6 +354,65 @@ RenderResource_get_static_mesh_resource(RenderResource& resources, const char* p
   return iter->second;
 }
 
+const gl_material::Material*
+RenderResource_request_material_resource(RenderResource& resources, const char* path) {
+  // Materials that haven't been set use the missing material, without a warning
+  if (path[0] == 0) {
+    return &resources.missing_material;
+  }
+
+  const auto iter = resources.material_resources.find(path);
+  if (iter != resources.material_resources.end()) {
+    return &iter->second;
+  }
+
+  if (resources.pending_materials.insert(path).second) {
+    request_load(resources, RenderResource_Load::Type::MATERIAL, path);
+  }
+
+  return nullptr;
+}
+
+const gl_static_mesh::StaticMesh*
+RenderResource_request_static_mesh_resource(RenderResource& resources, const char* path) {
+  const auto iter = resources.static_mesh_resources.find(path);
+  if (iter != resources.static_mesh_resources.end()) {
+    return &iter->second;
+  }
+
+  if (resources.pending_static_meshes.insert(path).second) {
+    request_load(resources, RenderResource_Load::Type::STATIC_MESH, path);
+  }
+
+  return nullptr;
+}
+
+bool RenderResource_finalize_loads(RenderResource& resources, float budget_ms) {
+  {
+    std::lock_guard<std::mutex> lock{resources.loader_mutex};
+    for (auto& load : resources.completed_loads) {
+      resources.finalize_queue.push_back(std::move(load));
+    }
+    resources.completed_loads.clear();
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  bool finalized = false;
+  while (!resources.finalize_queue.empty()) {
+    const auto elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start);
+    if (finalized && elapsed.count() >= budget_ms) {
+      break;
+    }
+
+    const auto load = std::move(resources.finalize_queue.front());
+    resources.finalize_queue.pop_front();
+    finalize_load(resources, *load);
+    finalized = true;
+  }
+
+  return finalized;
+}
+
 GLuint RenderResource_get_shader_resource(RenderResource& resources, const char* path) {
   auto iter = resources.shader_resources.find(path);
   if (iter == resources.shader_resources.end()) {
@@ -194,48 +442,30 @@ GLuint RenderResource_get_texture_2d_resource(RenderResource& resources, const c
   auto iter = resources.texture_2d_resources.find(path);
   if (iter == resources.texture_2d_resources.end()) {
     if (!hdr) {
-      // Load the texture from the file
-      Image texture;
-      const auto loaded = texture.from_file(path);
-      if (!loaded) {
+      // Get the texture from the resource cache, leaving it empty if it could not be loaded
+      const auto texture = ResourceCache::global().get_image(path);
+      if (!texture) {
         printf("WARNING: GLRenderSystem could not load texture '%s'\n", path);
       }
 
-      // Figure out the color format of the image
-      GLenum format;
-      switch (texture.get_colorspace()) {
-        case Image::ColorSpace::Linear:
-          format = GL_RGBA8;
-          break;
-
-        case Image::ColorSpace::SRGB:
-          format = GL_SRGB8_ALPHA8;
-          break;
-
-        default:
-          assert(false);
-          return 0;
-      }
-
       // Create an opengl texture from the texture object
-      const auto gl_tex = create_texture(
-          texture.get_width(), texture.get_height(), texture.get_bitmap(), format, GL_RGBA, GL_UNSIGNED_BYTE
-      );
+      const Image empty_texture;
+      const auto gl_tex = create_image_texture(texture ? *texture : empty_texture);
 
       // Add it to the resource table
       resources.texture_2d_resources.insert(std::make_pair(path, gl_tex));
       return gl_tex;
     } else {
-      HDRImage image;
-      const auto loaded = image.from_file(path);
-      if (!loaded) {
+      const auto image = ResourceCache::global().get_hdr_image(path);
+      if (!image) {
         printf("WARNING: GLRenderSystem could not load texture '%s'\n", path);
+        return 0;
       }
 
       // Figure out which internal and upload format to use
       GLenum internal_format;
       GLenum upload_format;
-      switch (image.get_num_channels()) {
+      switch (image->get_num_channels()) {
         case 3:
           internal_format = GL_RGB32F;
           upload_format = GL_RGB;
@@ -253,7 +483,7 @@ GLuint RenderResource_get_texture_2d_resource(RenderResource& resources, const c
 
       // Create an opengl texture for this image
       const auto gl_tex = create_texture(
-          image.get_width(), image.get_height(), image.get_bits(), internal_format, upload_format, GL_FLOAT
+          image->get_width(), image->get_height(), image->get_bits(), internal_format, upload_format, GL_FLOAT
       );
 
       // Add it to the resource table
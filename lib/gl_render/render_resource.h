@@ -1,14 +1,51 @@
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "lib/gl_render/gl_material.h"
 #include "lib/gl_render/gl_shader.h"
 #include "lib/gl_render/gl_static_mesh.h"
+#include "lib/resource/resources/image.h"
+#include "lib/resource/resources/material.h"
+#include "lib/resource/resources/static_mesh.h"
 
 namespace sge {
 namespace gl_render {
+/* Number of threads that read and decode resources in the background. */
+static constexpr size_t RENDER_RESOURCE_NUM_LOADER_THREADS = 2;
+
+/* A resource being read and decoded on a loader thread. */
+struct RenderResource_Load {
+  enum class Type { STATIC_MESH, MATERIAL };
+
+  Type type;
+  std::string path;
+
+  /* Decoded data, depending on the type of resource. These are null if the resource could not be loaded. */
+  std::shared_ptr<const StaticMesh> static_mesh;
+  std::shared_ptr<const Material> material;
+
+  /* The static mesh's vertices, which are interleaved along with loading it. */
+  std::vector<StaticMesh::InterleavedVertex> vertices;
+
+  /* Textures used by the material, which are decoded along with it. */
+  std::vector<std::pair<std::string, std::shared_ptr<const Image>>> textures;
+};
+
 struct RenderResource {
+  RenderResource() = default;
+  ~RenderResource();
+  RenderResource(const RenderResource& copy) = delete;
+  RenderResource& operator=(const RenderResource& copy) = delete;
+
   /* Dynamically loaded resources. */
   std::unordered_map<std::string, gl_material::Material> material_resources;
   std::unordered_map<std::string, gl_static_mesh::StaticMesh> static_mesh_resources;
@@ -22,6 +59,21 @@ struct RenderResource {
   /* Lightmask volume resources */
   gl_material::Material lightmask_volume_material;
   GLuint frustum_ebo;
+
+  /* Paths of resources that have been requested, but not yet finalized. */
+  std::unordered_set<std::string> pending_static_meshes;
+  std::unordered_set<std::string> pending_materials;
+
+  /* Loads that have completed, but not yet been finalized. Only accessed by the render thread. */
+  std::deque<std::unique_ptr<RenderResource_Load>> finalize_queue;
+
+  /* Loader threads, and the loads passed to and from them. These are guarded by 'loader_mutex'. */
+  std::vector<std::thread> loader_threads;
+  std::mutex loader_mutex;
+  std::condition_variable loader_cond;
+  std::deque<std::unique_ptr<RenderResource_Load>> load_requests;
+  std::deque<std::unique_ptr<RenderResource_Load>> completed_loads;
+  bool stopping_loaders = false;
 };
 
 const gl_material::Material&
@@ -30,6 +82,29 @@ RenderResource_get_material_resource(RenderResource& resources, const char* path
 const gl_static_mesh::StaticMesh&
 RenderResource_get_static_mesh_resource(RenderResource& resources, const char* path);
 
+/**
+ * \brief Returns the material at the given path if it has been loaded, otherwise starts loading it in the
+ * background and returns null. Materials that fail to load are replaced with the missing material.
+ */
+const gl_material::Material*
+RenderResource_request_material_resource(RenderResource& resources, const char* path);
+
+/**
+ * \brief Returns the static mesh at the given path if it has been loaded, otherwise starts loading it in the
+ * background and returns null. Meshes that fail to load are replaced with the missing mesh.
+ */
+const gl_static_mesh::StaticMesh*
+RenderResource_request_static_mesh_resource(RenderResource& resources, const char* path);
+
+/**
+ * \brief Creates the GL objects for requested resources that have finished loading. This must be called on
+ * the render thread.
+ * \param budget_ms The time that may be spent, after which remaining resources are left for the next call.
+ * At least one resource is finalized if any are ready.
+ * \return Whether any resources were finalized.
+ */
+bool RenderResource_finalize_loads(RenderResource& resources, float budget_ms);
+
 GLuint RenderResource_get_shader_resource(RenderResource& resources, const char* path);
 
 GLuint RenderResource_get_texture_2d_resource(RenderResource& resources, const char* path, bool hdr);
@@ -1,10 +1,165 @@
+#include <algorithm>
+
 #include "lib/gl_render/render_scene.h"
 #include "lib/engine/components/display/static_mesh.h"
 #include "lib/gl_render/render_resource.h"
 #include "lib/resource/misc/lightmask_volume.h"
+#include "lib/resource/misc/mesh_clusters.h"
 
 namespace sge {
 namespace gl_render {
+/**
+ * \brief Selects the least detailed LOD of the mesh whose error covers no more than 'max_error_pixels' on
+ * screen at the given instance.
+ * \param pixels_per_unit Number of pixels covered by a unit-sized object a unit away from the camera.
+ */
+static RenderCommand_Mesh select_mesh_lod(
+    const RenderScene_Mesh& mesh,
+    const Mat4& world_matrix,
+    const Mat4& view_matrix,
+    const float pixels_per_unit,
+    const float max_error_pixels
+) {
+  auto command = mesh.mesh_command;
+  const auto center = view_matrix * (world_matrix * mesh.bounds_center);
+  float scale = 0.f;
+  for (uint32_t column = 0; column < 3; ++column) {
+    const auto axis =
+        Vec3{world_matrix.get(column, 0), world_matrix.get(column, 1), world_matrix.get(column, 2)};
+    scale = std::max(scale, axis.length());
+  }
+
+  // Use the full mesh if the camera is within its bounds
+  const auto radius = mesh.bounds_radius * scale;
+  const auto distance = center.length();
+  if (distance <= radius) {
+    return command;
+  }
+
+  const auto radius_pixels = radius * pixels_per_unit / distance;
+  for (const auto& lod : *mesh.lods) {
+    if (lod.error * radius_pixels > max_error_pixels) {
+      break;
+    }
+
+    command.start_element_index = lod.start_element_index;
+    command.num_element_indices = static_cast<GLsizei>(lod.num_element_indices);
+  }
+
+  return command;
+}
+
+/* Storage reused between instances while culling their clusters. */
+struct ClusterScratch {
+  std::vector<StaticMesh::ClusterRange> ranges;
+  std::vector<GLsizei> counts;
+  std::vector<const void*> offsets;
+};
+
+/**
+ * \brief Renders the clusters of the mesh that may be visible at the given instance.
+ */
+static void render_mesh_clusters(
+    const gl_material::MaterialStandardUniforms uniforms,
+    const RenderScene_Mesh& mesh,
+    const RenderCommand_MeshInstance& instance,
+    const Mat4& view_matrix,
+    const Mat4& proj_matrix,
+    const bool cull_backfacing,
+    ClusterScratch& scratch
+) {
+  const auto model_view = view_matrix * instance.world_transform;
+  const auto local_camera_pos = model_view.inverse() * Vec3::zero();
+  scratch.ranges.clear();
+  mesh_clusters::cull_clusters(
+      mesh.clusters->ranges.data(),
+      mesh.clusters->bounds.data(),
+      mesh.clusters->ranges.size(),
+      proj_matrix * model_view,
+      local_camera_pos,
+      cull_backfacing,
+      scratch.ranges
+  );
+  if (scratch.ranges.empty()) {
+    return;
+  }
+
+  scratch.counts.clear();
+  scratch.offsets.clear();
+  for (const auto& range : scratch.ranges) {
+    scratch.counts.push_back(static_cast<GLsizei>(range.num_elem_indices));
+    scratch.offsets.push_back(reinterpret_cast<const void*>(range.start_elem_index * sizeof(GLuint)));
+  }
+
+  RenderCommand_render_mesh_ranges(
+      uniforms,
+      mesh.mesh_command.vao,
+      instance,
+      scratch.counts.data(),
+      scratch.offsets.data(),
+      scratch.counts.size()
+  );
+}
+
+/**
+ * \brief Renders each instance of the mesh with the LOD selected for it, drawing runs of instances that
+ * share a LOD together. Instances drawn at full detail only draw the clusters that may be visible, if the
+ * mesh has any.
+ * \param viewport_height The height of the framebuffer being rendered to, in pixels.
+ * \param cull_backfacing Whether clusters facing away from the camera are culled.
+ */
+static void render_mesh_instances(
+    const gl_material::MaterialStandardUniforms uniforms,
+    const RenderScene_Mesh& mesh,
+    const Mat4& view_matrix,
+    const Mat4& proj_matrix,
+    const GLuint viewport_height,
+    const float max_error_pixels,
+    const bool cull_backfacing
+) {
+  const auto* const instances = mesh.instance_commands.data();
+  const auto num_instances = mesh.instance_commands.size();
+  const bool select_lods = mesh.lods && max_error_pixels > 0.f;
+  if (!select_lods && !mesh.clusters) {
+    RenderCommand_render_meshes(uniforms, mesh.mesh_command, instances, num_instances);
+    return;
+  }
+
+  const auto pixels_per_unit = proj_matrix.get(1, 1) * viewport_height * 0.5f;
+  ClusterScratch cluster_scratch;
+  size_t run_start = 0;
+  RenderCommand_Mesh run_command;
+  for (size_t i = 0; i < num_instances; ++i) {
+    auto command = mesh.mesh_command;
+    if (select_lods) {
+      command = select_mesh_lod(
+          mesh, instances[i].world_transform, view_matrix, pixels_per_unit, max_error_pixels
+      );
+    }
+
+    const bool clustered =
+        mesh.clusters && command.start_element_index == mesh.mesh_command.start_element_index;
+    if (i != run_start && (clustered || command.start_element_index != run_command.start_element_index)) {
+      RenderCommand_render_meshes(uniforms, run_command, instances + run_start, i - run_start);
+      run_start = i;
+    }
+
+    if (clustered) {
+      render_mesh_clusters(
+          uniforms, mesh, instances[i], view_matrix, proj_matrix, cull_backfacing, cluster_scratch
+      );
+      run_start = i + 1;
+      continue;
+    }
+
+    run_command = command;
+  }
+
+  if (run_start < num_instances) {
+    RenderCommand_render_meshes(uniforms, run_command, instances + run_start, num_instances - run_start);
+  }
+}
+
 static void render_lightmask_volumes(
     const RenderScene_Commands& commands,
     const RenderResource& resources,
@@ -80,11 +235,14 @@ static void render_spotlight_shadowmaps(const RenderScene_Commands& commands) {
       );
 
       for (const auto& mesh : material_instance.mesh_instances) {
-        RenderCommand_render_meshes(
+        render_mesh_instances(
             material_instance.material.uniforms,
-            mesh.mesh_command,
-            mesh.instance_commands.data(),
-            mesh.instance_commands.size()
+            mesh,
+            spotlight.view_matrix,
+            spotlight.proj_matrix,
+            spotlight.shadow_height,
+            commands.lod_error_pixels * commands.shadow_lod_bias,
+            false
         );
       }
     }
@@ -135,11 +293,14 @@ void RenderScene_render(
     );
 
     for (const auto& mesh : material_instance.mesh_instances) {
-      RenderCommand_render_meshes(
+      render_mesh_instances(
           material_instance.material.uniforms,
-          mesh.mesh_command,
-          mesh.instance_commands.data(),
-          mesh.instance_commands.size()
+          mesh,
+          view_matrix,
+          proj_matrix,
+          gbuffer_height,
+          commands.lod_error_pixels,
+          true
       );
     }
   }
@@ -305,13 +466,17 @@ void RenderScene_insert_static_mesh_commands(
     const Node* const node = nodes[i];
     const CStaticMesh* const static_mesh = static_meshes[i];
 
-    // Get the static mesh resource for this instance
-    const auto& mesh_resource =
-        RenderResource_get_static_mesh_resource(resources, static_mesh->mesh().c_str());
+    // Get the static mesh and material resources for this instance, or placeholders if they're still loading
+    const auto* mesh_ptr =
+        RenderResource_request_static_mesh_resource(resources, static_mesh->mesh().c_str());
+    const auto* material_ptr =
+        RenderResource_request_material_resource(resources, static_mesh->material().c_str());
+    if (!mesh_ptr || !material_ptr) {
+      commands.pending_static_mesh_nodes.push_back(node->get_id());
+    }
 
-    // Get the material resource for this instance
-    const auto& material_resource =
-        RenderResource_get_material_resource(resources, static_mesh->material().c_str());
+    const auto& mesh_resource = mesh_ptr ? *mesh_ptr : resources.missing_mesh;
+    const auto& material_resource = material_ptr ? *material_ptr : resources.missing_material;
 
     // Get the lightmap for this instance
     const auto lightmap = get_lightmap(commands, node->get_id());
@@ -358,6 +523,10 @@ void RenderScene_insert_static_mesh_commands(
       mesh_command_set.mesh_command.start_element_index = 0;
       mesh_command_set.mesh_command.num_element_indices = mesh_resource.num_total_elements;
       mesh_command_set.mesh_command.base_vertex = 0;
+      mesh_command_set.lods = mesh_resource.lods;
+      mesh_command_set.bounds_center = mesh_resource.bounds_center;
+      mesh_command_set.bounds_radius = mesh_resource.bounds_radius;
+      mesh_command_set.clusters = mesh_resource.clusters;
 
       // Create the mesh instance object
       RenderCommand_MeshInstance instance;
@@ -390,6 +559,10 @@ void RenderScene_insert_static_mesh_commands(
       mesh_command_set.mesh_command.start_element_index = 0;
       mesh_command_set.mesh_command.num_element_indices = mesh_resource.num_total_elements;
       mesh_command_set.mesh_command.base_vertex = 0;
+      mesh_command_set.lods = mesh_resource.lods;
+      mesh_command_set.bounds_center = mesh_resource.bounds_center;
+      mesh_command_set.bounds_radius = mesh_resource.bounds_radius;
+      mesh_command_set.clusters = mesh_resource.clusters;
 
       // Create the mesh instance object
       RenderCommand_MeshInstance instance;
@@ -418,30 +591,22 @@ void RenderScene_insert_static_mesh_commands(
 
     // Insert it into the command set
     material.mesh_instances[mesh_iter->second].instance_commands.push_back(instance);
+    material.mesh_instances[mesh_iter->second].node_ids.push_back(node->get_id());
   }
 }
 
-void RenderScene_remove_static_mesh_commands(
-    RenderScene_Commands& commands,
+static void remove_lightmask_objects(
+    std::vector<RenderScene_LightmaskObject>& objects,
     const NodeId* const target_node_ids,
     const size_t num_target_node_ids
 ) {
-  // Check standard path instances
-  for (auto& material_instance : commands.standard_path_material_instances) {
-    for (auto& mesh : material_instance.mesh_instances) {
-      remove_mesh_commands(mesh, target_node_ids, num_target_node_ids);
-    }
-  }
-
-  // Check lightmask receiver instances
-  size_t num_lightmask_receivers = commands.lightmask_receiver_mesh_instances.size();
-  auto* const lightmask_receivers = commands.lightmask_receiver_mesh_instances.data();
-  for (size_t i = 0; i < num_lightmask_receivers;) {
+  size_t num_objects = objects.size();
+  for (size_t i = 0; i < num_objects;) {
     int incr = 1;
     for (size_t search_i = 0; search_i < num_target_node_ids; ++search_i) {
-      if (target_node_ids[search_i] == lightmask_receivers[i].node_id) {
-        num_lightmask_receivers -= 1;
-        lightmask_receivers[search_i] = std::move(lightmask_receivers[num_lightmask_receivers]);
+      if (target_node_ids[search_i] == objects[i].node_id) {
+        num_objects -= 1;
+        objects[i] = std::move(objects[num_objects]);
         incr = 0;
         break;
       }
@@ -450,7 +615,38 @@ void RenderScene_remove_static_mesh_commands(
     i += incr;
   }
 
-  commands.lightmask_receiver_mesh_instances.resize(num_lightmask_receivers);
+  objects.resize(num_objects);
+}
+
+void RenderScene_remove_static_mesh_commands(
+    RenderScene_Commands& commands,
+    const NodeId* const target_node_ids,
+    const size_t num_target_node_ids
+) {
+  // Check standard path instances
+  for (auto& material_instance : commands.standard_path_material_instances) {
+    for (auto& mesh : material_instance.mesh_instances) {
+      remove_mesh_commands(mesh, target_node_ids, num_target_node_ids);
+    }
+  }
+
+  // Check lightmask receiver and occluder instances
+  remove_lightmask_objects(commands.lightmask_receiver_mesh_instances, target_node_ids, num_target_node_ids);
+  remove_lightmask_objects(commands.lightmask_occluder_mesh_instances, target_node_ids, num_target_node_ids);
+
+  // Stop waiting on resources for them
+  auto& pending = commands.pending_static_mesh_nodes;
+  pending.erase(
+      std::remove_if(
+          pending.begin(),
+          pending.end(),
+          [target_node_ids, num_target_node_ids](NodeId node_id) {
+            return std::find(target_node_ids, target_node_ids + num_target_node_ids, node_id) !=
+                   target_node_ids + num_target_node_ids;
+          }
+      ),
+      pending.end()
+  );
 }
 
 void RenderScene_insert_spotlight_commands(
@@ -709,6 +905,7 @@ void RenderScene_clear(RenderScene_Commands& commands) {
   }
 
   commands.node_lightmaps.clear();
+  commands.pending_static_mesh_nodes.clear();
 }
 }  // namespace gl_render
 }  // namespace sge
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "lib/engine/components/display/spot_light.h"
+#include "lib/gl_render/gl_static_mesh.h"
 #include "lib/gl_render/render_commands.h"
 
 namespace sge {
@@ -31,6 +32,20 @@ struct RenderScene_Mesh {
    * \brief Array symmetrical with 'instance_commands', stores the ids for each node.
    */
   std::vector<NodeId> node_ids;
+
+  /**
+   * \brief LODs of the mesh, if it has any, and the local bounds used to select between them for each
+   * instance.
+   */
+  std::shared_ptr<const std::vector<gl_static_mesh::LodSlice>> lods;
+
+  /**
+   * \brief Clusters of the full mesh, culled for each instance drawn at full detail.
+   */
+  std::shared_ptr<const gl_static_mesh::Clusters> clusters;
+
+  Vec3 bounds_center = Vec3::zero();
+  float bounds_radius = 0.f;
 };
 
 struct RenderScene_Material {
@@ -81,6 +96,11 @@ struct RenderScene_Commands {
 
   std::vector<RenderScene_LightmaskObject> lightmask_occluder_mesh_instances;
 
+  /**
+   * \brief Static mesh nodes that are rendered with placeholder resources while their own are loaded.
+   */
+  std::vector<NodeId> pending_static_mesh_nodes;
+
   /**
    * \brief Mapping between objects and their lightmaps.
    */
@@ -89,6 +109,10 @@ struct RenderScene_Commands {
   /* Lightmap data */
   Vec3 light_dir;
   color::RGBF32 light_intensity;
+
+  /* LOD selection, from the render system's config */
+  float lod_error_pixels = 1.f;
+  float shadow_lod_bias = 4.f;
 };
 
 void RenderScene_render(
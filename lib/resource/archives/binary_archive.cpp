@@ -1,11 +1,15 @@
-#include <sys/stat.h>
+#include <stdio.h>
+#include <memory>
+#include <utility>
 
 #include "lib/base/reflection/reflection_builder.h"
 #include "lib/base/util/string_utils.h"
 #include "lib/resource/archives/binary_archive.h"
+#include "lib/resource/archives/binary_archive_compression.h"
 #include "lib/resource/archives/binary_archive_reader.h"
 #include "lib/resource/archives/binary_archive_writer.h"
 #include "lib/resource/interfaces/from_file.h"
+#include "lib/resource/sources/resource_source.h"
 
 SGE_REFLECT_TYPE(sge::BinaryArchive).implements<IFromFile>();
 
@@ -33,33 +37,130 @@ bool BinaryArchive::to_file(const char* path) const {
   return fclose(file) == 0;
 }
 
-bool BinaryArchive::from_file(const char* path) {
+ArchiveReader* BinaryArchive::read_mapped_file(const char* path) {
+  // Make sure the file has the correct extension
+  if (!string_ends_with(path, ".sbin")) {
+    return nullptr;
+  }
+
+  // Open the resource, hinting that it will be read front-to-back
+  ResourceData resource;
+  if (!open_resource(path, true, resource)) {
+    return nullptr;
+  }
+
+  if (!is_compressed_binary_archive(resource.data, resource.size)) {
+    return new BinaryArchiveReader(std::move(resource.owner), resource.data);
+  }
+
+  // Compressed archives can't be read in place, so decompress it (the resource is released afterwards)
+  const auto size = decompressed_binary_archive_size(resource.data, resource.size);
+  if (size == 0) {
+    return nullptr;
+  }
+
+  std::shared_ptr<uint8_t[]> buffer{new uint8_t[size]};
+  if (!decompress_binary_archive(resource.data, resource.size, buffer.get())) {
+    return nullptr;
+  }
+
+  const auto* const data = buffer.get();
+  return new BinaryArchiveReader(std::move(buffer), data);
+}
+
+bool BinaryArchive::write_file(const char* path, FunctionView<void(ArchiveWriter& writer)> write_fn) {
   // Make sure the file has the correct extension
   if (!string_ends_with(path, ".sbin")) {
     return false;
   }
 
-  // Clear the buffer
-  _buffer.clear();
+  // Open the file
+  auto* file = fopen(path, "wb");
+  if (!file) {
+    return false;
+  }
+
+  // Stream the archive to it
+  bool succeeded = false;
+  auto* const writer = new BinaryArchiveWriter(file, succeeded);
+  write_fn(*writer);
+  writer->pop();
+
+  // Close it, and don't leave a partial archive behind
+  succeeded &= fclose(file) == 0;
+  if (!succeeded) {
+    remove(path);
+  }
+
+  return succeeded;
+}
 
-  // Get the size of the file
-  struct stat file_stats;
-  if (stat(path, &file_stats) < 0) {
+bool BinaryArchive::write_compressed_file(
+    const char* path,
+    FunctionView<void(ArchiveWriter& writer)> write_fn
+) {
+  BinaryArchive archive;
+  auto* const writer = archive.write_root();
+  write_fn(*writer);
+  writer->pop();
+
+  return archive.to_compressed_file(path);
+}
+
+bool BinaryArchive::to_compressed_file(const char* path) const {
+  // Make sure the file has the correct extension
+  if (!string_ends_with(path, ".sbin")) {
     return false;
   }
 
+  std::vector<uint8_t> compressed;
+  compress_binary_archive(_buffer.data(), _buffer.size(), compressed);
+
   // Open the file
-  auto* file = fopen(path, "rb");
+  auto* file = fopen(path, "wb");
   if (!file) {
     return false;
   }
 
-  // Read the contents of the file into the buffer
-  _buffer.assign(file_stats.st_size, 0);
-  fread(_buffer.data(), 1, _buffer.size(), file);
+  // Write the compressed contents to the file, and don't leave a partial archive behind
+  bool succeeded = fwrite(compressed.data(), 1, compressed.size(), file) == compressed.size();
+  succeeded &= fclose(file) == 0;
+  if (!succeeded) {
+    remove(path);
+  }
+
+  return succeeded;
+}
+
+bool BinaryArchive::from_file(const char* path) {
+  // Make sure the file has the correct extension
+  if (!string_ends_with(path, ".sbin")) {
+    return false;
+  }
+
+  // Clear the buffer
+  _buffer.clear();
+
+  // Copy the contents of the resource into the buffer
+  ResourceData resource;
+  if (!open_resource(path, true, resource)) {
+    return false;
+  }
+
+  _buffer.assign(resource.data, resource.data + resource.size);
+
+  // Decompress it, if it's compressed
+  if (is_compressed_binary_archive(_buffer.data(), _buffer.size())) {
+    std::vector<uint8_t> decompressed(decompressed_binary_archive_size(_buffer.data(), _buffer.size()));
+    if (decompressed.empty() ||
+        !decompress_binary_archive(_buffer.data(), _buffer.size(), decompressed.data())) {
+      _buffer.clear();
+      return false;
+    }
+
+    _buffer = std::move(decompressed);
+  }
 
-  // Close the file
-  fclose(file);
   return true;
 }
 }  // namespace sge
@@ -3,6 +3,7 @@
 #include <stdint.h>
 #include <vector>
 
+#include "lib/base/functional/function_view.h"
 #include "lib/base/io/archive.h"
 #include "lib/base/reflection/reflection.h"
 #include "lib/resource/build.h"
@@ -18,8 +19,42 @@ class SGE_RESOURCE_API BinaryArchive final : public Archive {
 
   bool to_file(const char* path) const override;
 
+  /**
+   * \brief Loads an archive from a file, decompressing it if it was written with 'to_compressed_file'.
+   */
   bool from_file(const char* path) override;
 
+  /**
+   * \brief Writes the archive to a file, split into independently compressed blocks that can be decompressed
+   * in parallel. Compressed archives may be read anywhere that uncompressed archives may be.
+   * \param path The path of the '.sbin' file to write.
+   * \return Whether the archive was written.
+   */
+  bool to_compressed_file(const char* path) const;
+
+  /**
+   * \brief Reads a binary archive directly out of a memory-mapped file, without copying it into a buffer.
+   * Compressed archives are decompressed into memory instead, in parallel on the global task pool.
+   * \param path The path of the '.sbin' file to read.
+   * \return A reader for the root node of the archive, or null if the file could not be mapped. The mapping
+   * is released when the root node is popped, unless it is kept alive through the reader's 'view_owner'.
+   */
+  static ArchiveReader* read_mapped_file(const char* path);
+
+  /**
+   * \brief Writes a binary archive directly to a file, without holding all of it in memory.
+   * \param path The path of the '.sbin' file to write.
+   * \param write_fn Function that writes the root node of the archive. The root node is popped afterwards.
+   * \return Whether the archive was written. If not, the file is removed.
+   */
+  static bool write_file(const char* path, FunctionView<void(ArchiveWriter& writer)> write_fn);
+
+  /**
+   * \brief Writes a binary archive to a file like 'write_file', but compressed like 'to_compressed_file'. The
+   * whole archive is held in memory, since it must be compressed before it can be written.
+   */
+  static bool write_compressed_file(const char* path, FunctionView<void(ArchiveWriter& writer)> write_fn);
+
   const std::vector<uint8_t>& buffer() const { return _buffer; }
 
  private:
@@ -0,0 +1,154 @@
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+
+#include <libdeflate.h>
+
+#include "lib/base/concurrency/task_pool.h"
+#include "lib/resource/archives/binary_archive_compression.h"
+
+namespace sge {
+static bool read_header(const uint8_t* data, size_t size, BinaryArchiveCompressedHeader& out_header) {
+  if (size < sizeof(BinaryArchiveCompressedHeader)) {
+    return false;
+  }
+
+  memcpy(&out_header, data, sizeof(BinaryArchiveCompressedHeader));
+  return memcmp(out_header.magic, BINARY_ARCHIVE_COMPRESSED_MAGIC, sizeof(out_header.magic)) == 0;
+}
+
+/* Whether the header's sizes are possible for an archive of the given size. As blocks are never bigger than
+ * 'BINARY_ARCHIVE_BLOCK_SIZE', this bounds the decompressed size before anything is allocated for it. */
+static bool is_valid_header(const BinaryArchiveCompressedHeader& header, size_t size) {
+  const auto max_blocks = (size - sizeof(BinaryArchiveCompressedHeader)) / sizeof(BinaryArchiveBlockEntry);
+  return header.num_blocks <= max_blocks &&
+         header.uncompressed_size <= (uint64_t)header.num_blocks * BINARY_ARCHIVE_BLOCK_SIZE;
+}
+
+bool is_compressed_binary_archive(const uint8_t* data, size_t size) {
+  BinaryArchiveCompressedHeader header;
+  return read_header(data, size, header);
+}
+
+size_t decompressed_binary_archive_size(const uint8_t* data, size_t size) {
+  BinaryArchiveCompressedHeader header;
+  if (!read_header(data, size, header) || !is_valid_header(header, size)) {
+    return 0;
+  }
+
+  return (size_t)header.uncompressed_size;
+}
+
+void compress_binary_archive(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+  const size_t num_blocks = (size + BINARY_ARCHIVE_BLOCK_SIZE - 1) / BINARY_ARCHIVE_BLOCK_SIZE;
+
+  // Compress each block into its own buffer
+  std::vector<std::vector<uint8_t>> blocks(num_blocks);
+  TaskPool::global().parallel_for(num_blocks, [data, size, &blocks](size_t i) {
+    const auto* const block = data + i * BINARY_ARCHIVE_BLOCK_SIZE;
+    const auto block_size = std::min(BINARY_ARCHIVE_BLOCK_SIZE, size - i * BINARY_ARCHIVE_BLOCK_SIZE);
+    auto& compressed = blocks[i];
+    compressed.resize(block_size);
+
+    // Only keep the compressed data if it's smaller, otherwise store the block as is
+    size_t compressed_size = 0;
+    auto* const compressor = libdeflate_alloc_compressor(BINARY_ARCHIVE_COMPRESSION_LEVEL);
+    if (compressor) {
+      compressed_size =
+          libdeflate_deflate_compress(compressor, block, block_size, compressed.data(), block_size - 1);
+      libdeflate_free_compressor(compressor);
+    }
+
+    if (compressed_size == 0) {
+      memcpy(compressed.data(), block, block_size);
+    } else {
+      compressed.resize(compressed_size);
+    }
+  });
+
+  // Write the header and block index
+  BinaryArchiveCompressedHeader header;
+  memcpy(header.magic, BINARY_ARCHIVE_COMPRESSED_MAGIC, sizeof(BINARY_ARCHIVE_COMPRESSED_MAGIC));
+  header.num_blocks = (uint32_t)num_blocks;
+  header.uncompressed_size = size;
+
+  out.clear();
+  out.insert(out.end(), (const uint8_t*)&header, (const uint8_t*)&header + sizeof(header));
+
+  uint64_t offset = sizeof(BinaryArchiveCompressedHeader) + num_blocks * sizeof(BinaryArchiveBlockEntry);
+  for (size_t i = 0; i < num_blocks; ++i) {
+    BinaryArchiveBlockEntry entry;
+    entry.offset = offset;
+    entry.compressed_size = (uint32_t)blocks[i].size();
+    entry.uncompressed_size =
+        (uint32_t)std::min(BINARY_ARCHIVE_BLOCK_SIZE, size - i * BINARY_ARCHIVE_BLOCK_SIZE);
+    out.insert(out.end(), (const uint8_t*)&entry, (const uint8_t*)&entry + sizeof(entry));
+    offset += entry.compressed_size;
+  }
+
+  // Write the blocks
+  out.reserve(offset);
+  for (const auto& block : blocks) {
+    out.insert(out.end(), block.begin(), block.end());
+  }
+}
+
+bool decompress_binary_archive(const uint8_t* data, size_t size, uint8_t* out) {
+  BinaryArchiveCompressedHeader header;
+  if (!read_header(data, size, header) || !is_valid_header(header, size)) {
+    return false;
+  }
+
+  // Read the block index, and make sure it covers the archive exactly
+  const auto* const index = data + sizeof(BinaryArchiveCompressedHeader);
+
+  std::vector<BinaryArchiveBlockEntry> entries(header.num_blocks);
+  std::vector<uint64_t> out_offsets(header.num_blocks);
+  memcpy(entries.data(), index, entries.size() * sizeof(BinaryArchiveBlockEntry));
+
+  uint64_t out_offset = 0;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const auto& entry = entries[i];
+    if (entry.offset > size || entry.compressed_size > size - entry.offset ||
+        entry.compressed_size > entry.uncompressed_size ||
+        entry.uncompressed_size > BINARY_ARCHIVE_BLOCK_SIZE) {
+      return false;
+    }
+
+    out_offsets[i] = out_offset;
+    out_offset += entry.uncompressed_size;
+  }
+
+  if (out_offset != header.uncompressed_size) {
+    return false;
+  }
+
+  // Decompress each block straight into its place in the output
+  std::atomic<bool> succeeded{true};
+  TaskPool::global().parallel_for(entries.size(), [&](size_t i) {
+    const auto& entry = entries[i];
+    auto* const block_out = out + out_offsets[i];
+    if (entry.compressed_size == entry.uncompressed_size) {
+      memcpy(block_out, data + entry.offset, entry.uncompressed_size);
+      return;
+    }
+
+    auto* const decompressor = libdeflate_alloc_decompressor();
+    if (!decompressor) {
+      succeeded.store(false, std::memory_order_relaxed);
+      return;
+    }
+
+    const auto result = libdeflate_deflate_decompress(
+        decompressor, data + entry.offset, entry.compressed_size, block_out, entry.uncompressed_size, nullptr
+    );
+    libdeflate_free_decompressor(decompressor);
+
+    if (result != LIBDEFLATE_SUCCESS) {
+      succeeded.store(false, std::memory_order_relaxed);
+    }
+  });
+
+  return succeeded.load(std::memory_order_relaxed);
+}
+}  // namespace sge
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace sge {
+/* Magic number at the start of block-compressed binary archives. Its first byte isn't a valid node indicator,
+ * so compressed archives can't be mistaken for uncompressed ones. */
+static constexpr uint8_t BINARY_ARCHIVE_COMPRESSED_MAGIC[4] = {'S', 'G', 'E', 'Z'};
+
+/* Uncompressed size of each block, besides the last. Blocks are compressed and decompressed independently,
+ * so this bounds how finely the work may be split across threads. */
+static constexpr size_t BINARY_ARCHIVE_BLOCK_SIZE = 1 << 18;
+
+/* libdeflate compression level used for blocks. Archives are compressed once and decompressed often, so this
+ * favors size over compression speed. */
+static constexpr int BINARY_ARCHIVE_COMPRESSION_LEVEL = 9;
+
+/* Header at the start of a block-compressed binary archive. This is followed by the block index, and then by
+ * the compressed data of each block. */
+struct BinaryArchiveCompressedHeader {
+  uint8_t magic[4];
+
+  /* Number of entries in the block index. */
+  uint32_t num_blocks;
+
+  /* Size of the whole archive once decompressed. */
+  uint64_t uncompressed_size;
+};
+static_assert(
+    sizeof(BinaryArchiveCompressedHeader) == 16,
+    "Compressed archive headers must not contain padding"
+);
+
+/* An entry in the block index of a block-compressed binary archive. Blocks decompress to consecutive ranges
+ * of the archive, in index order. */
+struct BinaryArchiveBlockEntry {
+  /* Offset of the block's compressed data from the start of the file. */
+  uint64_t offset;
+
+  /* Size of the block's compressed data. If this is equal to its uncompressed size, the block is stored as
+   * is. */
+  uint32_t compressed_size;
+
+  /* Size of the block once decompressed. */
+  uint32_t uncompressed_size;
+};
+static_assert(sizeof(BinaryArchiveBlockEntry) == 16, "Block index entries must not contain padding");
+
+/**
+ * \brief Returns whether the given data starts with a block-compressed binary archive header.
+ */
+bool is_compressed_binary_archive(const uint8_t* data, size_t size);
+
+/**
+ * \brief Returns the size that the given block-compressed binary archive decompresses to, or zero if its
+ * header isn't valid. The size is checked against the number of blocks in the archive, so it's safe to
+ * allocate.
+ */
+size_t decompressed_binary_archive_size(const uint8_t* data, size_t size);
+
+/**
+ * \brief Compresses a binary archive into blocks, which are compressed in parallel on the global task pool.
+ * \param data The uncompressed archive.
+ * \param size The size of the uncompressed archive.
+ * \param out The buffer to write the block-compressed archive to. Its existing contents are replaced.
+ */
+void compress_binary_archive(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+
+/**
+ * \brief Decompresses a block-compressed binary archive. Blocks are decompressed in parallel on the global
+ * task pool, straight into the output buffer.
+ * \param data The block-compressed archive.
+ * \param size The size of the block-compressed archive.
+ * \param out The buffer to decompress into, which must be 'decompressed_binary_archive_size' bytes.
+ * \return Whether the archive was valid, and decompressed successfully.
+ */
+bool decompress_binary_archive(const uint8_t* data, size_t size, uint8_t* out);
+}  // namespace sge
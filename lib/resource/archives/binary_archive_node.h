@@ -15,6 +15,37 @@ static constexpr BinaryArchiveBool_t BAN_TRUE = 1;
 /* Constant value used for 'false'. */
 static constexpr BinaryArchiveBool_t BAN_FALSE = 0;
 
+/* Objects with at least this many members are written with a member table, so that their members may be
+ * found without a linear search. */
+static constexpr BinaryArchiveSize_t BINARY_ARCHIVE_MIN_INDEXED_MEMBERS = 8;
+
+/* Type used to represent hashes of member names in the archive. */
+using BinaryArchiveHash_t = uint32_t;
+
+/* An entry in the member table of an indexed object. */
+struct BinaryArchiveMemberEntry {
+  /* Hash of the member's name. */
+  BinaryArchiveHash_t hash;
+
+  /* Offset of the member's name from the object's indicator. */
+  BinaryArchiveSize_t offset;
+};
+static_assert(
+    sizeof(BinaryArchiveMemberEntry) == sizeof(BinaryArchiveHash_t) + sizeof(BinaryArchiveSize_t),
+    "Member table entries must not contain padding"
+);
+
+/* Hashes a member name for an indexed object's member table (32-bit FNV-1a). */
+inline BinaryArchiveHash_t binary_archive_member_hash(const char* name) {
+  BinaryArchiveHash_t hash = 2166136261u;
+  for (; *name != 0; ++name) {
+    hash ^= static_cast<uint8_t>(*name);
+    hash *= 16777619u;
+  }
+
+  return hash;
+}
+
 /* Indicates which node type the cursor is pointed at. */
 enum BinaryArchiveNode : uint8_t {
   BAN_NULL,
@@ -43,5 +74,13 @@ enum BinaryArchiveNode : uint8_t {
   BAN_ARRAY_DOUBLE,
   BAN_ARRAY_GENERIC,
   BAN_OBJECT,
+
+  /* Not a node. May precede a node's indicator, followed by a byte with the number of zero bytes that come
+   * before the indicator. Used to align the elements of typed arrays. */
+  BAN_PADDING,
+
+  /* An object whose members are followed by a table of 'BinaryArchiveMemberEntry', one per member, sorted by
+   * hash. The table fills the end of the object's span. */
+  BAN_OBJECT_INDEXED,
 };
 }  // namespace sge
@@ -4,7 +4,9 @@
 #include <stdint.h>
 #include <string.h>
 #include <algorithm>
+#include <memory>
 #include <stack>
+#include <utility>
 #include <vector>
 
 #include "lib/base/io/archive_reader.h"
@@ -21,10 +23,16 @@ class BinaryArchiveReader final : public ArchiveReader {
   };
 
  public:
-  BinaryArchiveReader(const std::vector<uint8_t>& buffer) {
-    cursor.node_value = buffer.data() + 1;
-    cursor.node_type = static_cast<BinaryArchiveNode>(buffer.front());
-    cursor.in_enumeration = false;
+  BinaryArchiveReader(const std::vector<uint8_t>& buffer) : BinaryArchiveReader(buffer.data()) {}
+
+  /**
+   * \brief Constructs a reader over memory held by the given owner (such as a mapped file). The reader shares
+   * ownership of it, which is released when the root node is popped unless views into it have been adopted
+   * through 'view_owner'.
+   */
+  BinaryArchiveReader(std::shared_ptr<const void> buffer_owner, const uint8_t* buffer)
+      : BinaryArchiveReader(buffer) {
+    owner = std::move(buffer_owner);
   }
 
   void pop() override {
@@ -42,6 +50,12 @@ class BinaryArchiveReader final : public ArchiveReader {
     cursor_stack.pop();
   }
 
+  ArchiveReader* fork() const override {
+    auto* const forked = new BinaryArchiveReader(cursor.node_value - 1);
+    forked->owner = owner;
+    return forked;
+  }
+
   bool null() const override { return cursor.node_type == BAN_NULL; }
 
   bool is_boolean() const override { return cursor.node_type == BAN_BOOLEAN; }
@@ -102,7 +116,7 @@ class BinaryArchiveReader final : public ArchiveReader {
   }
 
   bool is_array() const override {
-    return (cursor.node_type >= BAN_ARRAY_INT8 && cursor.node_type <= BAN_ARRAY_FLOAT) ||
+    return (cursor.node_type >= BAN_ARRAY_BOOLEAN && cursor.node_type <= BAN_ARRAY_DOUBLE) ||
            cursor.node_type == BAN_ARRAY_GENERIC;
   }
 
@@ -176,6 +190,48 @@ class BinaryArchiveReader final : public ArchiveReader {
     return impl_typed_array(BAN_ARRAY_DOUBLE, out, size);
   }
 
+  bool typed_array_view(const int8_t*& out_array, size_t& out_size) const override {
+    return impl_typed_array_view(BAN_ARRAY_INT8, out_array, out_size);
+  }
+
+  bool typed_array_view(const uint8_t*& out_array, size_t& out_size) const override {
+    return impl_typed_array_view(BAN_ARRAY_UINT8, out_array, out_size);
+  }
+
+  bool typed_array_view(const int16_t*& out_array, size_t& out_size) const override {
+    return impl_typed_array_view(BAN_ARRAY_INT16, out_array, out_size);
+  }
+
+  bool typed_array_view(const uint16_t*& out_array, size_t& out_size) const override {
+    return impl_typed_array_view(BAN_ARRAY_UINT16, out_array, out_size);
+  }
+
+  bool typed_array_view(const int32_t*& out_array, size_t& out_size) const override {
+    return impl_typed_array_view(BAN_ARRAY_INT32, out_array, out_size);
+  }
+
+  bool typed_array_view(const uint32_t*& out_array, size_t& out_size) const override {
+    return impl_typed_array_view(BAN_ARRAY_UINT32, out_array, out_size);
+  }
+
+  bool typed_array_view(const int64_t*& out_array, size_t& out_size) const override {
+    return impl_typed_array_view(BAN_ARRAY_INT64, out_array, out_size);
+  }
+
+  bool typed_array_view(const uint64_t*& out_array, size_t& out_size) const override {
+    return impl_typed_array_view(BAN_ARRAY_UINT64, out_array, out_size);
+  }
+
+  bool typed_array_view(const float*& out_array, size_t& out_size) const override {
+    return impl_typed_array_view(BAN_ARRAY_FLOAT, out_array, out_size);
+  }
+
+  bool typed_array_view(const double*& out_array, size_t& out_size) const override {
+    return impl_typed_array_view(BAN_ARRAY_DOUBLE, out_array, out_size);
+  }
+
+  std::shared_ptr<const void> view_owner() const override { return owner; }
+
   void enumerate_array_elements(FunctionView<void(size_t i)> enumerator) override {
     // Get the size of the array
     size_t size = 0;
@@ -199,8 +255,7 @@ class BinaryArchiveReader final : public ArchiveReader {
     // Loop through elements
     for (size_t i = 0; i < size; ++i) {
       // Get the node type and advance the cursor past the indicator
-      cursor.node_type = static_cast<BinaryArchiveNode>(*cursor.node_value);
-      cursor.node_value += 1;
+      set_cursor_node(cursor.node_value);
 
       // Call the enumerator function
       enumerator(i);
@@ -315,15 +370,12 @@ class BinaryArchiveReader final : public ArchiveReader {
     // Handle generic array
     if (cursor.node_type == BAN_ARRAY_GENERIC) {
       // Move the cursor forward to the first element
-      cursor.node_type = static_cast<BinaryArchiveNode>(cursor.node_value[sizeof(BinaryArchiveSize_t) * 2]);
-      cursor.node_value += sizeof(BinaryArchiveSize_t) * 2 + 1;
+      set_cursor_node(cursor.node_value + sizeof(BinaryArchiveSize_t) * 2);
 
       // For each step until the index
       for (; i > 0; --i) {
         // Advance the cursor
-        const auto advance = get_cursor_advancement();
-        cursor.node_type = static_cast<BinaryArchiveNode>(cursor.node_value[advance]);
-        cursor.node_value += advance + 1;
+        set_cursor_node(cursor.node_value + get_cursor_advancement());
       }
 
       return true;
@@ -388,7 +440,9 @@ class BinaryArchiveReader final : public ArchiveReader {
     return true;
   }
 
-  bool is_object() const override { return cursor.node_type == BAN_OBJECT; }
+  bool is_object() const override {
+    return cursor.node_type == BAN_OBJECT || cursor.node_type == BAN_OBJECT_INDEXED;
+  }
 
   bool object_size(size_t& out) const override {
     if (!is_object()) {
@@ -421,8 +475,7 @@ class BinaryArchiveReader final : public ArchiveReader {
       cursor.node_value += strlen(name) + 1;
 
       // Get the type
-      cursor.node_type = static_cast<BinaryArchiveNode>(*cursor.node_value);
-      cursor.node_value += 1;
+      set_cursor_node(cursor.node_value);
 
       // Call the enumerator
       enumerator(name);
@@ -446,6 +499,17 @@ class BinaryArchiveReader final : public ArchiveReader {
     auto cursor_backup = cursor;
     cursor.in_enumeration = false;
 
+    // Look the member up in the member table, if there is one
+    if (cursor.node_type == BAN_OBJECT_INDEXED) {
+      if (!find_indexed_member(name, size)) {
+        cursor = cursor_backup;
+        return false;
+      }
+
+      cursor_stack.push(cursor_backup);
+      return true;
+    }
+
     // Advance the cursor to the first element
     cursor.node_value += sizeof(BinaryArchiveSize_t) * 2;
 
@@ -456,8 +520,7 @@ class BinaryArchiveReader final : public ArchiveReader {
       cursor.node_value += strlen(mem_name) + 1;
 
       // Get the type
-      cursor.node_type = static_cast<BinaryArchiveNode>(*cursor.node_value);
-      cursor.node_value += 1;
+      set_cursor_node(cursor.node_value);
 
       // See if this is the node we're looking for
       if (strcmp(name, mem_name) == 0) {
@@ -476,6 +539,66 @@ class BinaryArchiveReader final : public ArchiveReader {
   }
 
  private:
+  explicit BinaryArchiveReader(const uint8_t* buffer) {
+    set_cursor_node(buffer);
+    cursor.in_enumeration = false;
+  }
+
+  // Points the cursor at the node with the given indicator, skipping over any alignment padding before it
+  void set_cursor_node(const uint8_t* indicator) {
+    if (*indicator == BAN_PADDING) {
+      indicator += 2 + indicator[1];
+    }
+
+    cursor.node_type = static_cast<BinaryArchiveNode>(*indicator);
+    cursor.node_value = indicator + 1;
+  }
+
+  // Points the cursor at the member of the current indexed object with the given name, if it exists.
+  bool find_indexed_member(const char* name, size_t size) {
+    // The table fills the end of the object's span
+    const uint8_t* const node = cursor.node_value - 1;
+    const auto span =
+        static_cast<size_t>(buffer_read<BinaryArchiveSize_t>(node + 1 + sizeof(BinaryArchiveSize_t)));
+    const uint8_t* const table = node + span - size * sizeof(BinaryArchiveMemberEntry);
+
+    // Binary search for the first entry with the hash
+    const auto hash = binary_archive_member_hash(name);
+    size_t first = 0;
+    size_t count = size;
+    while (count > 0) {
+      const size_t step = count / 2;
+      if (read_member_entry(table, first + step).hash < hash) {
+        first += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+
+    // Compare the names of each entry with the hash, in case of collisions
+    for (; first < size; ++first) {
+      const auto entry = read_member_entry(table, first);
+      if (entry.hash != hash) {
+        break;
+      }
+
+      const char* const mem_name = reinterpret_cast<const char*>(node + entry.offset);
+      if (strcmp(name, mem_name) == 0) {
+        set_cursor_node(node + entry.offset + strlen(mem_name) + 1);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  static BinaryArchiveMemberEntry read_member_entry(const uint8_t* table, size_t i) {
+    BinaryArchiveMemberEntry entry;
+    memcpy(&entry, table + i * sizeof(BinaryArchiveMemberEntry), sizeof(BinaryArchiveMemberEntry));
+    return entry;
+  }
+
   template <typename T>
   bool impl_value(BinaryArchiveNode required_type, T& out) const {
     if (cursor.node_type == required_type) {
@@ -501,6 +624,23 @@ class BinaryArchiveReader final : public ArchiveReader {
     return read_size;
   }
 
+  template <typename T>
+  bool impl_typed_array_view(BinaryArchiveNode required_type, const T*& out_array, size_t& out_size) const {
+    if (cursor.node_type != required_type) {
+      return false;
+    }
+
+    // Archives written before typed arrays were aligned may not be viewable
+    const auto* const elements = cursor.node_value + sizeof(BinaryArchiveSize_t);
+    if (reinterpret_cast<uintptr_t>(elements) % alignof(T) != 0) {
+      return false;
+    }
+
+    out_array = reinterpret_cast<const T*>(elements);
+    out_size = static_cast<size_t>(buffer_read<BinaryArchiveSize_t>(cursor.node_value));
+    return true;
+  }
+
   template <typename T>
   static T buffer_read(const uint8_t* buffer) {
     return *reinterpret_cast<const T*>(buffer);
@@ -511,7 +651,7 @@ class BinaryArchiveReader final : public ArchiveReader {
   // indicator)
   size_t get_cursor_advancement() const {
     // If this node is a generic array or object
-    if (cursor.node_type == BAN_ARRAY_GENERIC || cursor.node_type == BAN_OBJECT) {
+    if (cursor.node_type == BAN_ARRAY_GENERIC || is_object()) {
       // Get the span (includes indicator byte, which we've passed)
       return static_cast<size_t>(
                  buffer_read<BinaryArchiveSize_t>(cursor.node_value + sizeof(BinaryArchiveSize_t))
@@ -614,5 +754,6 @@ class BinaryArchiveReader final : public ArchiveReader {
  private:
   Cursor cursor;
   std::stack<Cursor> cursor_stack;
+  std::shared_ptr<const void> owner;
 };
 }  // namespace sge
@@ -2,7 +2,9 @@
 
 #include <assert.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <string.h>
+#include <algorithm>
 #include <stack>
 #include <vector>
 
@@ -13,26 +15,54 @@ namespace sge {
 class BinaryArchiveWriter final : public ArchiveWriter {
   struct Cursor {
     BinaryArchiveNode node_type;
+
+    // Offset of the node's indicator from the start of the archive
     size_t offset;
+
+    // If this node is a generic array or object, the number of elements or members written so far
+    BinaryArchiveSize_t num_children;
+
+    // If this node is an object, the index of its first entry in 'member_entries'
+    size_t members_begin;
   };
 
+  /* Size at which a streaming writer flushes its buffer to the file. Values larger than this skip the
+   * buffer entirely. */
+  static constexpr size_t STREAM_BLOCK_SIZE = 1 << 20;
+
+  /* Alignment of the nodes that forked writers are joined at. Nodes within a forked writer are aligned
+   * relative to the start of its buffer, so this must be at least the alignment of any typed array
+   * element. */
+  static constexpr size_t FORK_ALIGNMENT = 8;
+
  public:
-  BinaryArchiveWriter(std::vector<uint8_t>& buffer) : buffer(&buffer) {
-    current_node.node_type = BAN_NULL;
-    current_node.offset = 0;
-    buffer.push_back(BAN_NULL);
+  /**
+   * \brief Constructs a writer which writes the whole archive into the given buffer.
+   */
+  BinaryArchiveWriter(std::vector<uint8_t>& buffer) : buffer(&buffer) { init_root(); }
+
+  /**
+   * \brief Constructs a writer which streams the archive to the given file in blocks, so that only a bounded
+   * amount of it is held in memory. The sizes and spans of nodes are patched in once they are popped, so the
+   * file must be seekable.
+   * \param file The file to write to. It is not closed by the writer.
+   * \param out_succeeded Assigned whether every write succeeded, once the root node has been popped.
+   */
+  BinaryArchiveWriter(FILE* file, bool& out_succeeded)
+      : buffer(&owned_buffer), file(file), out_succeeded(&out_succeeded) {
+    owned_buffer.reserve(STREAM_BLOCK_SIZE);
+    init_root();
   }
 
   void pop() override {
-    // If this node is a generic array or object, we need to set the span
-    if (current_node.node_type == BAN_ARRAY_GENERIC || current_node.node_type == BAN_OBJECT) {
-      const auto span = static_cast<BinaryArchiveSize_t>(buffer->size() - current_node.offset);
-      *reinterpret_cast<BinaryArchiveSize_t*>(
-          buffer->data() + current_node.offset + 1 + sizeof(BinaryArchiveSize_t)
-      ) = span;
-    }
+    finish_node();
 
     if (node_stack.empty()) {
+      if (file) {
+        flush(end_offset());
+        *out_succeeded = succeeded;
+      }
+
       delete this;
       return;
     }
@@ -40,6 +70,29 @@ class BinaryArchiveWriter final : public ArchiveWriter {
     // Get the parent from the stack
     current_node = node_stack.top();
     node_stack.pop();
+    maybe_flush();
+  }
+
+  ArchiveWriter* fork() const override { return new BinaryArchiveWriter(); }
+
+  void join(ArchiveWriter& fork) override {
+    auto& forked = static_cast<BinaryArchiveWriter&>(fork);
+    assert(current_node.node_type == BAN_NULL && forked.node_stack.empty() && !forked.file);
+    forked.finish_node();
+
+    // Replace this node's indicator with the forked buffer, at an offset that keeps its contents aligned
+    align_node(0, FORK_ALIGNMENT);
+    const size_t base_offset = current_node.offset;
+    buffer->pop_back();
+
+    // Take on the forked root, so that popping this node doesn't overwrite its header
+    current_node.node_type = forked.current_node.node_type;
+    current_node.offset = base_offset + forked.current_node.offset;
+    current_node.num_children = forked.current_node.num_children;
+    current_node.members_begin = member_entries.size();
+    write_bytes(forked.buffer->data(), forked.buffer->size());
+
+    delete &forked;
   }
 
   void null() override { node_set_type(BAN_NULL); }
@@ -102,9 +155,7 @@ class BinaryArchiveWriter final : public ArchiveWriter {
   void string(const char* str, size_t len) override {
     node_set_type(BAN_STRING);
     buffer_append(static_cast<BinaryArchiveSize_t>(len));
-    buffer->insert(
-        buffer->end(), reinterpret_cast<const uint8_t*>(str), reinterpret_cast<const uint8_t*>(str + len)
-    );
+    write_bytes(str, len);
   }
 
   void typed_array(const bool* arr, size_t size) override {
@@ -112,12 +163,8 @@ class BinaryArchiveWriter final : public ArchiveWriter {
     // typed arrays.
     assert(current_node.node_type == BAN_NULL);
 
-    // Reserve space for size, and data (on top of current size)
-    buffer->reserve(buffer->size() + sizeof(BinaryArchiveSize_t) + sizeof(BinaryArchiveBool_t) * size);
-
     // Set the node's type
-    (*buffer)[current_node.offset] = BAN_ARRAY_BOOLEAN;
-    current_node.node_type = BAN_ARRAY_BOOLEAN;
+    node_set_type(BAN_ARRAY_BOOLEAN);
 
     // Push the size into the buffer
     buffer_append(static_cast<BinaryArchiveSize_t>(size));
@@ -126,6 +173,7 @@ class BinaryArchiveWriter final : public ArchiveWriter {
     for (size_t i = 0; i < size; ++i) {
       buffer_append<BinaryArchiveBool_t>(arr[i] ? BinaryArchiveBool_t{1} : BinaryArchiveBool_t{0});
     }
+    maybe_flush();
   }
 
   void typed_array(const int8_t* arr, size_t size) override { impl_typed_array(BAN_ARRAY_INT8, arr, size); }
@@ -163,30 +211,29 @@ class BinaryArchiveWriter final : public ArchiveWriter {
 
     // Set the node as a generic array if it isn't already
     if (current_node.node_type == BAN_NULL) {
-      (*buffer)[current_node.offset] = BAN_ARRAY_GENERIC;
-      current_node.node_type = BAN_ARRAY_GENERIC;
+      node_set_type(BAN_ARRAY_GENERIC);
+      current_node.num_children = 0;
       buffer_append(BinaryArchiveSize_t{0});
       buffer_append(BinaryArchiveSize_t{0});
     }
 
     // Increment the element count
-    *reinterpret_cast<BinaryArchiveSize_t*>(buffer->data() + current_node.offset + 1) += 1;
+    current_node.num_children += 1;
 
     // Push the current node onto the node stack as a parent
     node_stack.push(current_node);
 
     // Set up the new node
-    current_node.node_type = BAN_NULL;
-    current_node.offset = buffer->size();
-    buffer->push_back(BAN_NULL);
+    push_null_node();
   }
 
   void as_object() override {
     assert(current_node.node_type == BAN_NULL || current_node.node_type == BAN_OBJECT);
 
     if (current_node.node_type == BAN_NULL) {
-      (*buffer)[current_node.offset] = BAN_OBJECT;
-      current_node.node_type = BAN_OBJECT;
+      node_set_type(BAN_OBJECT);
+      current_node.num_children = 0;
+      current_node.members_begin = member_entries.size();
       buffer_append(BinaryArchiveSize_t{0});
       buffer_append(BinaryArchiveSize_t{0});
     }
@@ -197,7 +244,13 @@ class BinaryArchiveWriter final : public ArchiveWriter {
     as_object();
 
     // Increment the member count
-    *reinterpret_cast<BinaryArchiveSize_t*>(buffer->data() + current_node.offset + 1) += 1;
+    current_node.num_children += 1;
+
+    // Record the member for the object's member table
+    BinaryArchiveMemberEntry entry;
+    entry.hash = binary_archive_member_hash(name);
+    entry.offset = static_cast<BinaryArchiveSize_t>(end_offset() - current_node.offset);
+    member_entries.push_back(entry);
 
     // Push the current node onto the stack as a parent
     node_stack.push(current_node);
@@ -211,9 +264,7 @@ class BinaryArchiveWriter final : public ArchiveWriter {
     buffer->push_back(0);
 
     // Set up the new node
-    current_node.node_type = BAN_NULL;
-    current_node.offset = buffer->size();
-    buffer->push_back(BAN_NULL);
+    push_null_node();
   }
 
   template <typename T>
@@ -222,20 +273,82 @@ class BinaryArchiveWriter final : public ArchiveWriter {
     // typed arrays.
     assert(current_node.node_type == BAN_NULL);
 
-    // Reserve space for size, and data (on top of current size)
-    buffer->reserve(buffer->size() + sizeof(BinaryArchiveSize_t) + sizeof(T) * size);
+    // Pad the node so that the elements are aligned, which allows readers to view them without copying
+    align_node(1 + sizeof(BinaryArchiveSize_t), alignof(T));
 
     // Set the node's type
-    (*buffer)[current_node.offset] = array_type;
-    current_node.node_type = array_type;
+    node_set_type(array_type);
 
     // Push the size into the buffer
     buffer_append(static_cast<BinaryArchiveSize_t>(size));
 
     // Push the array into the buffer
-    buffer->insert(
-        buffer->end(), reinterpret_cast<const uint8_t*>(arr), reinterpret_cast<const uint8_t*>(arr + size)
-    );
+    write_bytes(arr, sizeof(T) * size);
+  }
+
+  // Inserts padding before the current node's indicator, so that the given offset from the indicator is
+  // aligned.
+  void align_node(size_t indicator_offset, size_t alignment) {
+    // The node must not have been written yet, so its indicator is the last thing in the buffer
+    assert(current_node.offset + 1 == end_offset());
+
+    const size_t misalignment = (current_node.offset + indicator_offset) % alignment;
+    if (misalignment == 0) {
+      return;
+    }
+
+    // Padding is at least two bytes (the padding indicator and its length)
+    size_t pad_size = alignment - misalignment;
+    if (pad_size < 2) {
+      pad_size += alignment;
+    }
+
+    const size_t index = current_node.offset - flushed_size;
+    buffer->insert(buffer->begin() + index, pad_size, uint8_t{0});
+    (*buffer)[index] = BAN_PADDING;
+    (*buffer)[index + 1] = static_cast<uint8_t>(pad_size - 2);
+    current_node.offset += pad_size;
+  }
+
+  // Writes the member table, size, and span of the current node, if it has them.
+  void finish_node() {
+    // If this is an object with enough members, write its member table
+    if (current_node.node_type == BAN_OBJECT) {
+      write_member_table();
+    }
+
+    // If this node is a generic array or object, we need to set the size and span
+    if (current_node.node_type == BAN_ARRAY_GENERIC || current_node.node_type == BAN_OBJECT) {
+      const BinaryArchiveSize_t header[] = {
+          current_node.num_children, static_cast<BinaryArchiveSize_t>(end_offset() - current_node.offset)
+      };
+      patch(current_node.offset + 1, header, sizeof(header));
+    }
+  }
+
+  // Appends the current object's member table if it has enough members, and discards its entries.
+  void write_member_table() {
+    const auto begin = member_entries.begin() + current_node.members_begin;
+    const auto end = member_entries.end();
+
+    if (end - begin >= static_cast<ptrdiff_t>(BINARY_ARCHIVE_MIN_INDEXED_MEMBERS)) {
+      std::stable_sort(
+          begin,
+          end,
+          [](const BinaryArchiveMemberEntry& lhs, const BinaryArchiveMemberEntry& rhs) {
+            return lhs.hash < rhs.hash;
+          }
+      );
+
+      const BinaryArchiveNode indexed_type = BAN_OBJECT_INDEXED;
+      patch(current_node.offset, &indexed_type, sizeof(indexed_type));
+      for (auto iter = begin; iter != end; ++iter) {
+        buffer_append(iter->hash);
+        buffer_append(iter->offset);
+      }
+    }
+
+    member_entries.erase(begin, end);
   }
 
   template <typename T>
@@ -248,13 +361,97 @@ class BinaryArchiveWriter final : public ArchiveWriter {
     // Archive nodes may not may not have their value set twice.
     assert(current_node.node_type == BAN_NULL);
 
+    // The indicator of an unset node is never flushed
     current_node.node_type = type;
-    (*buffer)[current_node.offset] = type;
+    (*buffer)[current_node.offset - flushed_size] = type;
+  }
+
+  void init_root() {
+    current_node.node_type = BAN_NULL;
+    current_node.offset = 0;
+    current_node.num_children = 0;
+    current_node.members_begin = 0;
+    buffer->push_back(BAN_NULL);
+  }
+
+  void push_null_node() {
+    current_node.node_type = BAN_NULL;
+    current_node.offset = end_offset();
+    current_node.num_children = 0;
+    current_node.members_begin = 0;
+    buffer->push_back(BAN_NULL);
+    maybe_flush();
+  }
+
+  // Offset from the start of the archive of the next byte to be written
+  size_t end_offset() const { return flushed_size + buffer->size(); }
+
+  // Appends the given bytes to the archive. When streaming, large values are written to the file directly.
+  void write_bytes(const void* data, size_t size) {
+    const auto* const bytes = static_cast<const uint8_t*>(data);
+    if (file && size >= STREAM_BLOCK_SIZE) {
+      flush(end_offset());
+      succeeded &= fwrite(bytes, 1, size, file) == size;
+      flushed_size += size;
+      return;
+    }
+
+    buffer->insert(buffer->end(), bytes, bytes + size);
+    maybe_flush();
+  }
+
+  // Overwrites bytes that have already been written to the archive, which may have been flushed.
+  void patch(size_t offset, const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+
+    // Seek back to patch the part that was flushed
+    if (offset < flushed_size) {
+      const size_t flushed_part = std::min(size, flushed_size - offset);
+      succeeded &= fseek(file, static_cast<long>(offset), SEEK_SET) == 0;
+      succeeded &= fwrite(bytes, 1, flushed_part, file) == flushed_part;
+      succeeded &= fseek(file, 0, SEEK_END) == 0;
+      offset += flushed_part;
+      bytes += flushed_part;
+      size -= flushed_part;
+    }
+
+    memcpy(buffer->data() + (offset - flushed_size), bytes, size);
+  }
+
+  // Flushes the buffer if it has grown past the block size.
+  void maybe_flush() {
+    if (file && buffer->size() >= STREAM_BLOCK_SIZE) {
+      // Unset nodes may still be padded, so their indicator must stay in the buffer
+      flush(current_node.node_type == BAN_NULL ? current_node.offset : end_offset());
+    }
+  }
+
+  // Writes the buffer to the file, up to the given offset from the start of the archive.
+  void flush(size_t end) {
+    const size_t size = end - flushed_size;
+    succeeded &= fwrite(buffer->data(), 1, size, file) == size;
+    buffer->erase(buffer->begin(), buffer->begin() + size);
+    flushed_size = end;
   }
 
  private:
+  // Constructs a forked writer, which writes into its own buffer.
+  BinaryArchiveWriter() : buffer(&owned_buffer) { init_root(); }
+
   Cursor current_node;
   std::stack<Cursor> node_stack;
   std::vector<uint8_t>* buffer;
+
+  // Buffer used when not writing into a caller's buffer, because the writer is streaming or forked
+  std::vector<uint8_t> owned_buffer;
+
+  // State for streaming to a file. 'buffer' holds everything after the first 'flushed_size' bytes.
+  FILE* file = nullptr;
+  bool* out_succeeded = nullptr;
+  bool succeeded = true;
+  size_t flushed_size = 0;
+
+  // Member table entries of the objects on the node stack, with the innermost object's last
+  std::vector<BinaryArchiveMemberEntry> member_entries;
 };
 }  // namespace sge
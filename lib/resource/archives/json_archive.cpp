@@ -1,7 +1,9 @@
 #include <stdio.h>
+#include <string.h>
+#include <memory>
 
-#include "lib/third_party/rapidjson/filereadstream.h"
 #include "lib/third_party/rapidjson/filewritestream.h"
+#include "lib/third_party/rapidjson/memorystream.h"
 #include "lib/third_party/rapidjson/writer.h"
 
 #include "lib/base/interfaces/to_string.h"
@@ -10,7 +12,9 @@
 #include "lib/resource/archives/json_archive.h"
 #include "lib/resource/archives/json_archive_reader.h"
 #include "lib/resource/archives/json_archive_writer.h"
+#include "lib/resource/archives/json_stream_archive_reader.h"
 #include "lib/resource/interfaces/from_file.h"
+#include "lib/resource/sources/resource_source.h"
 
 SGE_REFLECT_TYPE(sge::JsonArchive).implements<IToString>().implements<IFromFile>();
 
@@ -19,6 +23,25 @@ struct JsonArchive::Data {
   rapidjson::Document doc;
 };
 
+/* Source for streaming readers over resources that are parsed as they're read. */
+struct JsonResourceSource {
+  explicit JsonResourceSource(ResourceData resource_data)
+      : resource(std::move(resource_data)),
+        stream(reinterpret_cast<const char*>(resource.data), resource.size) {}
+
+  ResourceData resource;
+  rapidjson::MemoryStream stream;
+};
+
+/* Source for streaming readers over text that is parsed in place. */
+struct JsonInsituSource {
+  explicit JsonInsituSource(char* str, std::unique_ptr<char[]> owned_str = nullptr)
+      : owned(std::move(owned_str)), stream(str) {}
+
+  std::unique_ptr<char[]> owned;
+  rapidjson::InsituStringStream stream;
+};
+
 JsonArchive::JsonArchive() {
   _data = std::make_unique<JsonArchive::Data>();
 }
@@ -52,19 +75,15 @@ bool JsonArchive::from_file(const char* path) {
     return false;
   }
 
-  // Open the file
-  FILE* file = fopen(path, "rb");
-  if (!file) {
+  // Open the resource
+  ResourceData resource;
+  if (!open_resource(path, true, resource)) {
     return false;
   }
 
   // Load it
-  char readBuffer[65536];
-  rapidjson::FileReadStream in(file, readBuffer, sizeof(readBuffer));
-
-  _data->doc.ParseStream<0, rapidjson::UTF8<>, rapidjson::FileReadStream>(in);
-
-  fclose(file);
+  rapidjson::MemoryStream in(reinterpret_cast<const char*>(resource.data), resource.size);
+  _data->doc.ParseStream<0, rapidjson::UTF8<>, rapidjson::MemoryStream>(in);
   return true;
 }
 
@@ -81,4 +100,39 @@ std::string JsonArchive::to_string() const {
 void JsonArchive::from_string(const char* str) {
   _data->doc.Parse(str);
 }
+
+ArchiveReader* JsonArchive::read_file_streaming(const char* path, bool in_situ) {
+  // Make sure the file has the correct extension
+  if (!string_ends_with(path, ".json")) {
+    return nullptr;
+  }
+
+  // Open the resource
+  ResourceData resource;
+  if (!open_resource(path, true, resource)) {
+    return nullptr;
+  }
+
+  if (!in_situ) {
+    return new JsonStreamArchiveReader<JsonResourceSource, 0>(
+        std::make_unique<JsonResourceSource>(std::move(resource))
+    );
+  }
+
+  // Copy the whole resource, so that it can be parsed in place
+  auto text = std::make_unique<char[]>(resource.size + 1);
+  memcpy(text.get(), resource.data, resource.size);
+  text[resource.size] = '\0';
+
+  auto* const str = text.get();
+  return new JsonStreamArchiveReader<JsonInsituSource, rapidjson::kParseInsituFlag>(
+      std::make_unique<JsonInsituSource>(str, std::move(text))
+  );
+}
+
+ArchiveReader* JsonArchive::read_string_streaming(char* str) {
+  return new JsonStreamArchiveReader<JsonInsituSource, rapidjson::kParseInsituFlag>(
+      std::make_unique<JsonInsituSource>(str)
+  );
+}
 }  // namespace sge
@@ -27,6 +27,24 @@ class SGE_RESOURCE_API JsonArchive final : public Archive {
 
   void from_string(const char* str);
 
+  /**
+   * \brief Opens a reader which parses the given file as it is read, rather than parsing it into a document
+   * first. Consumers which visit the archive through 'enumerate_object_members' and
+   * 'enumerate_array_elements' deserialize it in a single pass, without the whole document in memory.
+   * \param path The path of the '.json' file to read.
+   * \param in_situ Whether to load the file into memory and parse it in place, so that strings aren't copied.
+   * \return A reader for the root node, which is deleted when it is popped, or null if the file couldn't be
+   * read.
+   */
+  static ArchiveReader* read_file_streaming(const char* path, bool in_situ);
+
+  /**
+   * \brief Opens a reader which parses the given string in place as it is read.
+   * \param str The JSON text. This is modified by parsing, and must outlive the reader.
+   * \return A reader for the root node, which is deleted when it is popped.
+   */
+  static ArchiveReader* read_string_streaming(char* str);
+
  private:
   std::unique_ptr<Data> _data;
 };
@@ -10,10 +10,12 @@
 #include "lib/base/memory/functions.h"
 
 namespace sge {
-class JsonArchiveReader final : public ArchiveReader {
+class JsonArchiveReader : public ArchiveReader {
  public:
   JsonArchiveReader(const rapidjson::Value& node) : _head(&node) {}
 
+  virtual ~JsonArchiveReader() = default;
+
   void pop() override {
     // If we've reached the end of this stack
     if (_parents.empty()) {
@@ -25,6 +27,8 @@ class JsonArchiveReader final : public ArchiveReader {
     _parents.pop();
   }
 
+  ArchiveReader* fork() const override { return new JsonArchiveReader{*_head}; }
+
   bool null() const override { return _head->IsNull(); }
 
   bool is_boolean() const override { return _head->IsBool(); }
@@ -279,6 +283,7 @@ class JsonArchiveReader final : public ArchiveReader {
     return index;
   }
 
+ protected:
   const rapidjson::Value* _head;
   std::stack<const rapidjson::Value*> _parents;
 };
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <assert.h>
 #include <stdint.h>
+#include <memory>
 #include <stack>
 
 #include "lib/third_party/rapidjson/document.h"
@@ -26,6 +28,22 @@ class JsonArchiveWriter final : public ArchiveWriter {
     _parents.pop();
   }
 
+  ArchiveWriter* fork() const override {
+    auto doc = std::make_unique<rapidjson::Document>();
+    auto* const forked = new JsonArchiveWriter{*doc, doc->GetAllocator()};
+    forked->_owned_doc = std::move(doc);
+    return forked;
+  }
+
+  void join(ArchiveWriter& fork) override {
+    auto& forked = static_cast<JsonArchiveWriter&>(fork);
+    assert(forked._parents.empty() && forked._owned_doc);
+
+    // The forked node lives in its own document, so it must be copied into this one
+    _head->CopyFrom(*forked._head, *_allocator);
+    delete &forked;
+  }
+
   void null() override { _head->SetNull(); }
 
   void boolean(bool value) override { _head->SetBool(value); }
@@ -131,5 +149,8 @@ class JsonArchiveWriter final : public ArchiveWriter {
   rapidjson::Value* _head;
   std::stack<rapidjson::Value*> _parents;
   rapidjson::MemoryPoolAllocator<>* _allocator;
+
+  // The document that a forked writer writes into
+  std::unique_ptr<rapidjson::Document> _owned_doc;
 };
 }  // namespace sge
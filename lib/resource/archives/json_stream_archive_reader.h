@@ -0,0 +1,419 @@
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lib/third_party/rapidjson/document.h"
+#include "lib/third_party/rapidjson/reader.h"
+
+#include "lib/resource/archives/json_archive_reader.h"
+
+namespace sge {
+/**
+ * \brief A JsonArchiveReader which parses its source as it is read, rather than parsing it into a document up
+ * front. Enumerating an object or array parses its contents one member or element at a time. Anything else
+ * that needs the contents of an object or array (such as pulling a member by name) parses just that node into
+ * memory, where it stays until the enumeration that reached it moves on.
+ * NOTE: Since the source is only parsed once, an object or array which has been enumerated appears empty
+ * afterwards, and anything skipped by an enumerator can't be returned to.
+ * \tparam SourceT Owns the rapidjson input stream to parse, which it exposes as 'stream'.
+ * \tparam ParseFlags The rapidjson parse flags. If 'kParseInsituFlag' is set, strings are referenced directly
+ * out of the source rather than copied.
+ */
+template <typename SourceT, unsigned ParseFlags>
+class JsonStreamArchiveReader final : public JsonArchiveReader {
+  static constexpr bool IN_SITU = (ParseFlags & rapidjson::kParseInsituFlag) != 0;
+
+  /**
+   * \brief Handles parser events by recording the most recent one.
+   */
+  struct Token {
+    enum Kind { NONE, VALUE, STRING, KEY, START_OBJECT, END_OBJECT, START_ARRAY, END_ARRAY };
+
+    bool Null() {
+      kind = VALUE;
+      value.SetNull();
+      return true;
+    }
+
+    bool Bool(bool b) {
+      kind = VALUE;
+      value.SetBool(b);
+      return true;
+    }
+
+    bool Int(int i) {
+      kind = VALUE;
+      value.SetInt(i);
+      return true;
+    }
+
+    bool Uint(unsigned u) {
+      kind = VALUE;
+      value.SetUint(u);
+      return true;
+    }
+
+    bool Int64(int64_t i) {
+      kind = VALUE;
+      value.SetInt64(i);
+      return true;
+    }
+
+    bool Uint64(uint64_t u) {
+      kind = VALUE;
+      value.SetUint64(u);
+      return true;
+    }
+
+    bool Double(double d) {
+      kind = VALUE;
+      value.SetDouble(d);
+      return true;
+    }
+
+    bool RawNumber(const char* str, rapidjson::SizeType len, bool copy) { return String(str, len, copy); }
+
+    bool String(const char* str, rapidjson::SizeType len, bool copy) {
+      kind = STRING;
+      set_text(str, len, copy);
+      return true;
+    }
+
+    bool Key(const char* str, rapidjson::SizeType len, bool copy) {
+      kind = KEY;
+      set_text(str, len, copy);
+      return true;
+    }
+
+    bool StartObject() {
+      kind = START_OBJECT;
+      return true;
+    }
+
+    bool EndObject(rapidjson::SizeType member_count) {
+      kind = END_OBJECT;
+      size = member_count;
+      return true;
+    }
+
+    bool StartArray() {
+      kind = START_ARRAY;
+      return true;
+    }
+
+    bool EndArray(rapidjson::SizeType element_count) {
+      kind = END_ARRAY;
+      size = element_count;
+      return true;
+    }
+
+    void set_text(const char* str, rapidjson::SizeType len, bool copy) {
+      // Strings that aren't parsed in place only live until the parser moves on
+      if (copy) {
+        copied_text.assign(str, len);
+        str = copied_text.c_str();
+      }
+
+      text = str;
+      size = len;
+    }
+
+    Kind kind = NONE;
+    rapidjson::Value value;
+    const char* text = nullptr;
+    rapidjson::SizeType size = 0;
+    std::string copied_text;
+  };
+
+  /**
+   * \brief Holds the current node at one depth of enumeration.
+   */
+  struct Level {
+    std::string key;
+    std::string string;
+    rapidjson::Value scalar;
+    rapidjson::Document doc;
+  };
+
+ public:
+  explicit JsonStreamArchiveReader(std::unique_ptr<SourceT> source)
+      : JsonArchiveReader(PENDING_OBJECT), _source(std::move(source)), _depth(0) {
+    _levels.push_back(std::make_unique<Level>());
+    _reader.IterativeParseInit();
+
+    // If there's no root node, this reads as null
+    _head = &_levels[0]->scalar;
+    if (next_token()) {
+      load_node(*_levels[0]);
+    }
+  }
+
+  // Nodes are released as the parser moves past them, so they can't outlive this reader's position
+  ArchiveReader* fork() const override { return nullptr; }
+
+  bool array_size(size_t& out) const override {
+    materialize();
+    return JsonArchiveReader::array_size(out);
+  }
+
+  size_t typed_array(bool* out, size_t size) const override { return materialized_typed_array(out, size); }
+
+  size_t typed_array(int8_t* out, size_t size) const override { return materialized_typed_array(out, size); }
+
+  size_t typed_array(uint8_t* out, size_t size) const override { return materialized_typed_array(out, size); }
+
+  size_t typed_array(int16_t* out, size_t size) const override { return materialized_typed_array(out, size); }
+
+  size_t typed_array(uint16_t* out, size_t size) const override {
+    return materialized_typed_array(out, size);
+  }
+
+  size_t typed_array(int32_t* out, size_t size) const override { return materialized_typed_array(out, size); }
+
+  size_t typed_array(uint32_t* out, size_t size) const override {
+    return materialized_typed_array(out, size);
+  }
+
+  size_t typed_array(int64_t* out, size_t size) const override { return materialized_typed_array(out, size); }
+
+  size_t typed_array(uint64_t* out, size_t size) const override {
+    return materialized_typed_array(out, size);
+  }
+
+  size_t typed_array(float* out, size_t size) const override { return materialized_typed_array(out, size); }
+
+  size_t typed_array(double* out, size_t size) const override { return materialized_typed_array(out, size); }
+
+  bool object_size(size_t& out) const override {
+    materialize();
+    return JsonArchiveReader::object_size(out);
+  }
+
+  void enumerate_object_members(FunctionView<void(const char* name)> enumerator) override {
+    if (_head != &PENDING_OBJECT) {
+      JsonArchiveReader::enumerate_object_members(enumerator);
+      return;
+    }
+
+    // Push the head onto the stack, which will be empty once its members have been parsed
+    _head = &CONSUMED_OBJECT;
+    _parents.push(_head);
+    auto& level = push_level();
+
+    // For each member of the object, until the end of it (or a parse error)
+    while (next_token() && _token.kind == Token::KEY) {
+      level.key.assign(_token.text, _token.size);
+      if (!next_token() || !load_node(level)) {
+        break;
+      }
+
+      // Call the enumerator with the name of the member
+      enumerator(level.key.c_str());
+      release_node(level);
+    }
+
+    // Pop the head off the stack
+    _depth -= 1;
+    _head = _parents.top();
+    _parents.pop();
+  }
+
+  bool pull_object_member(const char* name) override {
+    materialize();
+    return JsonArchiveReader::pull_object_member(name);
+  }
+
+  void enumerate_array_elements(FunctionView<void(size_t i)> enumerator) override {
+    if (_head != &PENDING_ARRAY) {
+      JsonArchiveReader::enumerate_array_elements(enumerator);
+      return;
+    }
+
+    // Push the head onto the stack, which will be empty once its elements have been parsed
+    _head = &CONSUMED_ARRAY;
+    _parents.push(_head);
+    auto& level = push_level();
+
+    // For each element of the array, until the end of it (or a parse error)
+    size_t index = 0;
+    while (next_token() && _token.kind != Token::END_ARRAY) {
+      if (!load_node(level)) {
+        break;
+      }
+
+      // Call the enumerator with the index
+      enumerator(index);
+      release_node(level);
+      index += 1;
+    }
+
+    // Pop the head off the stack
+    _depth -= 1;
+    _head = _parents.top();
+    _parents.pop();
+  }
+
+  bool pull_array_element(size_t i) override {
+    materialize();
+    return JsonArchiveReader::pull_array_element(i);
+  }
+
+ private:
+  template <typename T>
+  size_t materialized_typed_array(T* out, size_t size) const {
+    materialize();
+    return JsonArchiveReader::typed_array(out, size);
+  }
+
+  /**
+   * \brief Parses the next token from the source.
+   * \return Whether there was a token to parse.
+   */
+  bool next_token() {
+    if (_reader.IterativeParseNext<ParseFlags>(_source->stream, _token)) {
+      return true;
+    }
+
+    _token.kind = Token::NONE;
+    return false;
+  }
+
+  /**
+   * \brief Makes the node at the current token the head. Objects and arrays are left unparsed.
+   * \return Whether the current token starts a node.
+   */
+  bool load_node(Level& level) {
+    switch (_token.kind) {
+      case Token::VALUE:
+        level.scalar = _token.value;
+        _head = &level.scalar;
+        return true;
+
+      case Token::STRING:
+        if (IN_SITU) {
+          level.scalar.SetString(rapidjson::StringRef(_token.text, _token.size));
+        } else {
+          level.string.assign(_token.text, _token.size);
+          level.scalar.SetString(rapidjson::StringRef(level.string.c_str(), level.string.size()));
+        }
+        _head = &level.scalar;
+        return true;
+
+      case Token::START_OBJECT:
+        _head = &PENDING_OBJECT;
+        return true;
+
+      case Token::START_ARRAY:
+        _head = &PENDING_ARRAY;
+        return true;
+
+      default:
+        return false;
+    }
+  }
+
+  /**
+   * \brief Skips the rest of the node that was just enumerated, and frees anything parsed out of it.
+   */
+  void release_node(Level& level) {
+    if (_head == &PENDING_OBJECT || _head == &PENDING_ARRAY) {
+      size_t depth = 1;
+      while (depth != 0 && next_token()) {
+        if (_token.kind == Token::START_OBJECT || _token.kind == Token::START_ARRAY) {
+          depth += 1;
+        } else if (_token.kind == Token::END_OBJECT || _token.kind == Token::END_ARRAY) {
+          depth -= 1;
+        }
+      }
+    }
+
+    if (!level.doc.IsNull()) {
+      level.doc.SetNull();
+      level.doc.GetAllocator().Clear();
+    }
+  }
+
+  Level& push_level() {
+    _depth += 1;
+    if (_levels.size() <= _depth) {
+      _levels.push_back(std::make_unique<Level>());
+    }
+
+    return *_levels[_depth];
+  }
+
+  /**
+   * \brief If the head is an object or array that hasn't been parsed, parses the whole of it into memory.
+   */
+  void materialize() const {
+    if (_head != &PENDING_OBJECT && _head != &PENDING_ARRAY) {
+      return;
+    }
+
+    // This changes how the head is stored, but not which node it refers to
+    auto* const self = const_cast<JsonStreamArchiveReader*>(this);
+    auto& doc = _levels[_depth]->doc;
+    auto replay = [self](rapidjson::Document& handler) {
+      // The token that started the node has already been parsed, so begin with that
+      size_t depth = 0;
+      do {
+        if (!self->forward_token(handler)) {
+          return false;
+        }
+
+        const auto kind = self->_token.kind;
+        if (kind == Token::START_OBJECT || kind == Token::START_ARRAY) {
+          depth += 1;
+        } else if (kind == Token::END_OBJECT || kind == Token::END_ARRAY) {
+          depth -= 1;
+        }
+
+        if (depth == 0) {
+          return true;
+        }
+      } while (self->next_token());
+
+      return false;
+    };
+    doc.Populate(replay);
+    self->_head = &doc;
+  }
+
+  template <typename HandlerT>
+  bool forward_token(HandlerT& handler) const {
+    switch (_token.kind) {
+      case Token::VALUE:
+        return _token.value.Accept(handler);
+      case Token::STRING:
+        return handler.String(_token.text, _token.size, !IN_SITU);
+      case Token::KEY:
+        return handler.Key(_token.text, _token.size, !IN_SITU);
+      case Token::START_OBJECT:
+        return handler.StartObject();
+      case Token::END_OBJECT:
+        return handler.EndObject(_token.size);
+      case Token::START_ARRAY:
+        return handler.StartArray();
+      case Token::END_ARRAY:
+        return handler.EndArray(_token.size);
+      default:
+        return false;
+    }
+  }
+
+  /* Stand-ins for the head when it is an object or array that hasn't been parsed, or has been enumerated. */
+  inline static const rapidjson::Value PENDING_OBJECT{rapidjson::kObjectType};
+  inline static const rapidjson::Value PENDING_ARRAY{rapidjson::kArrayType};
+  inline static const rapidjson::Value CONSUMED_OBJECT{rapidjson::kObjectType};
+  inline static const rapidjson::Value CONSUMED_ARRAY{rapidjson::kArrayType};
+
+  std::unique_ptr<SourceT> _source;
+  rapidjson::Reader _reader;
+  Token _token;
+  std::vector<std::unique_ptr<Level>> _levels;
+  size_t _depth;
+};
+}  // namespace sge
@@ -0,0 +1,160 @@
+#include "lib/resource/archives/mapped_file.h"
+
+#if defined SGE_OS_WINDOWS
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sge {
+#if defined SGE_OS_WINDOWS
+
+MappedFile::MappedFile() : _data(nullptr), _size(0), _file_handle(nullptr), _mapping_handle(nullptr) {}
+
+MappedFile::MappedFile(MappedFile&& move)
+    : _data(move._data),
+      _size(move._size),
+      _file_handle(move._file_handle),
+      _mapping_handle(move._mapping_handle) {
+  move._data = nullptr;
+  move._size = 0;
+  move._file_handle = nullptr;
+  move._mapping_handle = nullptr;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& move) {
+  if (this != &move) {
+    close();
+    _data = move._data;
+    _size = move._size;
+    _file_handle = move._file_handle;
+    _mapping_handle = move._mapping_handle;
+    move._data = nullptr;
+    move._size = 0;
+    move._file_handle = nullptr;
+    move._mapping_handle = nullptr;
+  }
+
+  return *this;
+}
+
+bool MappedFile::open(const char* path, bool sequential) {
+  close();
+
+  const DWORD flags = sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL;
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+    CloseHandle(file);
+    return false;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping) {
+    CloseHandle(file);
+    return false;
+  }
+
+  void* const data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!data) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+
+  _data = static_cast<const uint8_t*>(data);
+  _size = static_cast<size_t>(file_size.QuadPart);
+  _file_handle = file;
+  _mapping_handle = mapping;
+  return true;
+}
+
+void MappedFile::close() {
+  if (_data) {
+    UnmapViewOfFile(_data);
+    CloseHandle(_mapping_handle);
+    CloseHandle(_file_handle);
+  }
+
+  _data = nullptr;
+  _size = 0;
+  _file_handle = nullptr;
+  _mapping_handle = nullptr;
+}
+
+#else
+
+MappedFile::MappedFile() : _data(nullptr), _size(0) {}
+
+MappedFile::MappedFile(MappedFile&& move) : _data(move._data), _size(move._size) {
+  move._data = nullptr;
+  move._size = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& move) {
+  if (this != &move) {
+    close();
+    _data = move._data;
+    _size = move._size;
+    move._data = nullptr;
+    move._size = 0;
+  }
+
+  return *this;
+}
+
+bool MappedFile::open(const char* path, bool sequential) {
+  close();
+
+  const int fd = ::open(path, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat file_stats;
+  if (fstat(fd, &file_stats) < 0 || file_stats.st_size == 0) {
+    ::close(fd);
+    return false;
+  }
+
+  // The mapping keeps its own reference to the file, so the descriptor isn't needed after this
+  const auto size = static_cast<size_t>(file_stats.st_size);
+  void* const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+
+  // Advice values aren't flags, so they have to be given separately
+  if (sequential) {
+    madvise(data, size, MADV_SEQUENTIAL);
+    madvise(data, size, MADV_WILLNEED);
+  }
+
+  _data = static_cast<const uint8_t*>(data);
+  _size = size;
+  return true;
+}
+
+void MappedFile::close() {
+  if (_data) {
+    munmap(const_cast<uint8_t*>(_data), _size);
+  }
+
+  _data = nullptr;
+  _size = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+  close();
+}
+}  // namespace sge
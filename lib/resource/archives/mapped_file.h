@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "lib/resource/build.h"
+
+namespace sge {
+/**
+ * \brief A read-only memory mapping of an entire file.
+ */
+struct SGE_RESOURCE_API MappedFile {
+  MappedFile();
+  ~MappedFile();
+  MappedFile(const MappedFile& copy) = delete;
+  MappedFile& operator=(const MappedFile& copy) = delete;
+  MappedFile(MappedFile&& move);
+  MappedFile& operator=(MappedFile&& move);
+
+  /**
+   * \brief Maps the given file into memory, releasing any existing mapping.
+   * \param path The path of the file to map.
+   * \param sequential Whether to hint to the OS that the mapping will be read front-to-back.
+   * \return Whether the file was mapped. Empty files cannot be mapped.
+   */
+  bool open(const char* path, bool sequential);
+
+  /**
+   * \brief Releases the mapping, if there is one.
+   */
+  void close();
+
+  const uint8_t* data() const { return _data; }
+
+  size_t size() const { return _size; }
+
+ private:
+  const uint8_t* _data;
+  size_t _size;
+#if defined SGE_OS_WINDOWS
+  void* _file_handle;
+  void* _mapping_handle;
+#endif
+};
+}  // namespace sge
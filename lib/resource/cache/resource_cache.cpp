@@ -0,0 +1,182 @@
+#include <exception>
+
+#include "lib/base/reflection/reflection.h"
+#include "lib/resource/cache/resource_cache.h"
+#include "lib/resource/resources/hdr_image.h"
+#include "lib/resource/resources/image.h"
+#include "lib/resource/resources/material.h"
+#include "lib/resource/resources/static_mesh.h"
+
+namespace sge {
+/* The sizes below are approximate, as they only count the bulk of each resource's data. */
+static size_t resource_size(const StaticMesh& mesh) {
+  const size_t vert_size = sizeof(Vec3) + sizeof(HalfVec3) * 2 + sizeof(int8_t) + sizeof(UHalfVec2) * 2;
+  size_t num_elements = mesh.num_triangle_elements();
+  for (size_t i = 0; i < mesh.num_lods(); ++i) {
+    num_elements += mesh.lods()[i].triangle_elements.size;
+  }
+
+  const size_t cluster_size = sizeof(StaticMesh::ClusterRange) + sizeof(StaticMesh::ClusterBounds);
+  return mesh.num_verts() * vert_size + num_elements * sizeof(uint32_t) + mesh.num_clusters() * cluster_size;
+}
+
+static size_t resource_size(const Material& /*material*/) {
+  return sizeof(Material);
+}
+
+static size_t resource_size(const Image& image) {
+  return (size_t)image.get_width() * image.get_height() * sizeof(uint32_t);
+}
+
+static size_t resource_size(const HDRImage& image) {
+  return (size_t)image.get_width() * image.get_height() * image.get_num_channels() * sizeof(float);
+}
+
+template <typename T>
+static void load_resource(const char* path, std::shared_ptr<const void>& out_resource, size_t& out_size) {
+  auto resource = std::make_shared<T>();
+  if (!resource->from_file(path)) {
+    return;
+  }
+
+  out_size = resource_size(*resource);
+  out_resource = std::move(resource);
+}
+
+ResourceCache::ResourceCache(size_t budget) : _budget(budget), _size(0) {}
+
+ResourceCache::~ResourceCache() = default;
+
+ResourceCache& ResourceCache::global() {
+  static ResourceCache cache{RESOURCE_CACHE_DEFAULT_BUDGET};
+  return cache;
+}
+
+std::shared_ptr<const StaticMesh> ResourceCache::get_static_mesh(const std::string& path) {
+  return std::static_pointer_cast<const StaticMesh>(get(Kind::STATIC_MESH, path));
+}
+
+std::shared_ptr<const Material> ResourceCache::get_material(const std::string& path) {
+  return std::static_pointer_cast<const Material>(get(Kind::MATERIAL, path));
+}
+
+std::shared_ptr<const Image> ResourceCache::get_image(const std::string& path) {
+  return std::static_pointer_cast<const Image>(get(Kind::IMAGE, path));
+}
+
+std::shared_ptr<const HDRImage> ResourceCache::get_hdr_image(const std::string& path) {
+  return std::static_pointer_cast<const HDRImage>(get(Kind::HDR_IMAGE, path));
+}
+
+size_t ResourceCache::budget() const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _budget;
+}
+
+void ResourceCache::set_budget(size_t budget) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  _budget = budget;
+  trim(_budget);
+}
+
+size_t ResourceCache::size() const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _size;
+}
+
+void ResourceCache::evict_unused() {
+  std::lock_guard<std::mutex> lock{_mutex};
+  trim(0);
+}
+
+std::shared_ptr<const void> ResourceCache::get(Kind kind, const std::string& path) {
+  std::unique_lock<std::mutex> lock{_mutex};
+  auto& entries = _entries[(size_t)kind];
+  const auto iter = entries.find(path);
+  if (iter != entries.end()) {
+    auto& entry = iter->second;
+    if (entry.resource) {
+      // Mark it as the most recently used
+      _lru.splice(_lru.begin(), _lru, entry.lru_iter);
+      return entry.resource;
+    }
+
+    // Another thread is loading it, so wait for that
+    const auto pending = entry.pending;
+    lock.unlock();
+    return pending.get();
+  }
+
+  // Claim the load, so that other threads requesting this resource wait for it
+  std::promise<std::shared_ptr<const void>> promise;
+  auto& entry = entries[path];
+  entry.kind = kind;
+  entry.path = path;
+  entry.pending = promise.get_future().share();
+  lock.unlock();
+
+  std::shared_ptr<const void> resource;
+  size_t size = 0;
+  try {
+    switch (kind) {
+      case Kind::STATIC_MESH:
+        load_resource<StaticMesh>(path.c_str(), resource, size);
+        break;
+      case Kind::MATERIAL:
+        load_resource<Material>(path.c_str(), resource, size);
+        break;
+      case Kind::IMAGE:
+        load_resource<Image>(path.c_str(), resource, size);
+        break;
+      case Kind::HDR_IMAGE:
+        load_resource<HDRImage>(path.c_str(), resource, size);
+        break;
+      case Kind::COUNT:
+        break;
+    }
+  } catch (...) {
+    // Forget the failed load, so that waiting threads see the error and later requests try again
+    lock.lock();
+    entries.erase(path);
+    lock.unlock();
+    promise.set_exception(std::current_exception());
+    throw;
+  }
+
+  // Entries that are still loading are never evicted, so 'entry' remains valid
+  lock.lock();
+  if (resource) {
+    entry.resource = resource;
+    entry.size = size;
+    entry.pending = {};
+    _lru.push_front(&entry);
+    entry.lru_iter = _lru.begin();
+    _size += size;
+    trim(_budget);
+  } else {
+    entries.erase(path);
+  }
+  lock.unlock();
+
+  promise.set_value(resource);
+  return resource;
+}
+
+void ResourceCache::trim(size_t budget) {
+  auto iter = _lru.end();
+  while (_size > budget && iter != _lru.begin()) {
+    --iter;
+
+    // Resources that are referenced outside of the cache can't be evicted
+    auto* const entry = *iter;
+    if (entry->resource.use_count() > 1) {
+      continue;
+    }
+
+    _size -= entry->size;
+    iter = _lru.erase(iter);
+    auto& entries = _entries[(size_t)entry->kind];
+    entries.erase(entries.find(entry->path));
+  }
+}
+}  // namespace sge
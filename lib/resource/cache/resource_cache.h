@@ -0,0 +1,117 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "lib/resource/build.h"
+
+namespace sge {
+struct HDRImage;
+struct Image;
+struct Material;
+struct StaticMesh;
+
+/* Memory budget of the global resource cache. */
+static constexpr size_t RESOURCE_CACHE_DEFAULT_BUDGET = (size_t)512 << 20;
+
+/**
+ * \brief Loads resources from files, and shares them between everything that uses them, so that each file is
+ * only parsed and held in memory once. Resources are immutable once loaded, and stay cached for as long as
+ * they're referenced. Unreferenced resources stay cached as well, until the total size of cached resources
+ * exceeds the memory budget, at which point the least recently used are evicted. This may be used from any
+ * thread.
+ */
+struct SGE_RESOURCE_API ResourceCache {
+  /**
+   * \brief Creates an empty cache with the given memory budget, in bytes.
+   */
+  explicit ResourceCache(size_t budget);
+  ~ResourceCache();
+  ResourceCache(const ResourceCache& copy) = delete;
+  ResourceCache& operator=(const ResourceCache& copy) = delete;
+
+  /**
+   * \brief Returns the process-wide cache, which has a budget of 'RESOURCE_CACHE_DEFAULT_BUDGET'.
+   */
+  static ResourceCache& global();
+
+  /**
+   * \brief Returns the static mesh at the given path, loading it if it isn't cached. If another thread is
+   * already loading it, this waits for that load instead of starting another.
+   * \return The mesh, or null if it could not be loaded. Failed loads are not cached. If loading throws, the
+   * exception is rethrown to this and every waiting caller.
+   */
+  std::shared_ptr<const StaticMesh> get_static_mesh(const std::string& path);
+
+  /**
+   * \brief Returns the material at the given path, loading it if it isn't cached. This does not load the
+   * textures it uses.
+   */
+  std::shared_ptr<const Material> get_material(const std::string& path);
+
+  /**
+   * \brief Returns the image at the given path, loading it if it isn't cached.
+   */
+  std::shared_ptr<const Image> get_image(const std::string& path);
+
+  /**
+   * \brief Returns the HDR image at the given path, loading it if it isn't cached.
+   */
+  std::shared_ptr<const HDRImage> get_hdr_image(const std::string& path);
+
+  size_t budget() const;
+
+  /**
+   * \brief Sets the memory budget, in bytes, evicting unreferenced resources until the cache fits in it.
+   */
+  void set_budget(size_t budget);
+
+  /**
+   * \brief Returns the approximate memory used by all cached resources, including referenced ones, in bytes.
+   */
+  size_t size() const;
+
+  /**
+   * \brief Evicts every unreferenced resource, regardless of the budget.
+   */
+  void evict_unused();
+
+ private:
+  enum class Kind : uint8_t { STATIC_MESH, MATERIAL, IMAGE, HDR_IMAGE, COUNT };
+
+  struct Entry {
+    Kind kind;
+    std::string path;
+
+    /* The loaded resource, which is null while it's being loaded. */
+    std::shared_ptr<const void> resource;
+    size_t size = 0;
+
+    /* Set while the resource is being loaded, for other threads requesting it to wait on. */
+    std::shared_future<std::shared_ptr<const void>> pending;
+
+    /* Position in '_lru', once loaded. */
+    std::list<Entry*>::iterator lru_iter;
+  };
+
+  std::shared_ptr<const void> get(Kind kind, const std::string& path);
+
+  /* Evicts the least recently used unreferenced resources until the cache fits in the given budget. Must be
+   * called with '_mutex' held. */
+  void trim(size_t budget);
+
+  mutable std::mutex _mutex;
+  std::unordered_map<std::string, Entry> _entries[(size_t)Kind::COUNT];
+
+  /* Loaded entries, from most to least recently used. */
+  std::list<Entry*> _lru;
+  size_t _budget;
+  size_t _size;
+};
+}  // namespace sge
@@ -0,0 +1,304 @@
+#include <math.h>
+#include <algorithm>
+#include <utility>
+
+#include "lib/base/math/mat4.h"
+#include "lib/resource/misc/mesh_clusters.h"
+#include "lib/resource/misc/mesh_optimizer.h"
+
+namespace sge {
+namespace mesh_clusters {
+StaticMesh::ClusterBounds
+compute_cluster_bounds(const uint32_t* elements, size_t num_elements, const Vec3* positions) {
+  StaticMesh::ClusterBounds bounds;
+  bounds.center = Vec3::zero();
+  bounds.radius = 0.f;
+  bounds.cone_axis = Vec3::zero();
+  bounds.cone_cutoff = 1.f;
+  if (num_elements < 3) {
+    return bounds;
+  }
+
+  // Center the sphere on the bounding box
+  auto min = positions[elements[0]];
+  auto max = min;
+  for (size_t i = 1; i < num_elements; ++i) {
+    const auto& pos = positions[elements[i]];
+    min = Vec3{std::min(min.x(), pos.x()), std::min(min.y(), pos.y()), std::min(min.z(), pos.z())};
+    max = Vec3{std::max(max.x(), pos.x()), std::max(max.y(), pos.y()), std::max(max.z(), pos.z())};
+  }
+
+  bounds.center = (min + max) / 2.f;
+  for (size_t i = 0; i < num_elements; ++i) {
+    bounds.radius = std::max(bounds.radius, (positions[elements[i]] - bounds.center).length());
+  }
+
+  // Point the cone along the average normal, and widen it to cover every other normal
+  std::vector<Vec3> normals;
+  normals.reserve(num_elements / 3);
+  auto axis = Vec3::zero();
+  for (size_t i = 0; i + 2 < num_elements; i += 3) {
+    const auto& a = positions[elements[i]];
+    const auto normal = Vec3::cross(positions[elements[i + 1]] - a, positions[elements[i + 2]] - a);
+    const auto length = normal.length();
+    if (length > 0.f) {
+      normals.push_back(normal / length);
+      axis += normals.back();
+    }
+  }
+
+  const auto axis_length = axis.length();
+  if (axis_length <= 0.f) {
+    return bounds;
+  }
+
+  axis /= axis_length;
+  float min_dot = 1.f;
+  for (const auto& normal : normals) {
+    min_dot = std::min(min_dot, Vec3::dot(axis, normal));
+  }
+
+  bounds.cone_axis = axis;
+  if (min_dot > MIN_CONE_DOT) {
+    bounds.cone_cutoff = sqrtf(1.f - min_dot * min_dot);
+  }
+
+  return bounds;
+}
+
+void build_clusters(
+    uint32_t* elements,
+    size_t num_elements,
+    const Vec3* positions,
+    size_t num_verts,
+    uint32_t base_elem_index,
+    std::vector<StaticMesh::ClusterRange>& out_ranges,
+    std::vector<StaticMesh::ClusterBounds>& out_bounds
+) {
+  const auto num_triangles = num_elements / 3;
+  if (num_triangles == 0) {
+    return;
+  }
+
+  // Find the triangles using each vertex
+  std::vector<uint32_t> adjacency_offsets(num_verts + 1, 0);
+  for (size_t i = 0; i < num_triangles * 3; ++i) {
+    adjacency_offsets[elements[i] + 1] += 1;
+  }
+  for (size_t i = 0; i < num_verts; ++i) {
+    adjacency_offsets[i + 1] += adjacency_offsets[i];
+  }
+
+  std::vector<uint32_t> adjacency(num_triangles * 3);
+  auto fill_offsets = adjacency_offsets;
+  for (size_t i = 0; i < num_triangles * 3; ++i) {
+    adjacency[fill_offsets[elements[i]]++] = (uint32_t)(i / 3);
+  }
+
+  // Vertices and candidates are stamped with the cluster they're in, so they needn't be cleared between them
+  std::vector<uint32_t> vertex_cluster(num_verts, 0);
+  std::vector<uint32_t> candidate_cluster(num_triangles, 0);
+  std::vector<bool> emitted(num_triangles, false);
+  std::vector<uint32_t> candidates;
+  std::vector<uint32_t> result;
+  result.reserve(num_triangles * 3);
+
+  uint32_t cluster_stamp = 0;
+  size_t cluster_verts = 0;
+  const auto num_new_verts = [&](uint32_t tri) {
+    size_t count = 0;
+    for (size_t v = 0; v < 3; ++v) {
+      count += vertex_cluster[elements[tri * 3 + v]] != cluster_stamp;
+    }
+    return count;
+  };
+  const auto add_triangle = [&](uint32_t tri) {
+    emitted[tri] = true;
+    for (size_t v = 0; v < 3; ++v) {
+      const auto vert = elements[tri * 3 + v];
+      result.push_back(vert);
+      if (vertex_cluster[vert] == cluster_stamp) {
+        continue;
+      }
+
+      // Triangles around a new vertex may be added next
+      vertex_cluster[vert] = cluster_stamp;
+      cluster_verts += 1;
+      for (auto t = adjacency_offsets[vert]; t < adjacency_offsets[vert + 1]; ++t) {
+        if (!emitted[adjacency[t]] && candidate_cluster[adjacency[t]] != cluster_stamp) {
+          candidate_cluster[adjacency[t]] = cluster_stamp;
+          candidates.push_back(adjacency[t]);
+        }
+      }
+    }
+  };
+
+  for (uint32_t seed = 0; seed < num_triangles; ++seed) {
+    if (emitted[seed]) {
+      continue;
+    }
+
+    cluster_stamp += 1;
+    cluster_verts = 0;
+    candidates.clear();
+    const auto cluster_start = result.size();
+    add_triangle(seed);
+
+    // Grow the cluster with whichever neighbour adds the fewest vertices, preferring earlier triangles
+    while ((result.size() - cluster_start) / 3 < MAX_CLUSTER_TRIANGLES) {
+      size_t best = candidates.size();
+      size_t best_new_verts = 4;
+      for (size_t c = 0; c < candidates.size();) {
+        if (emitted[candidates[c]]) {
+          candidates[c] = candidates.back();
+          candidates.pop_back();
+          continue;
+        }
+
+        const auto new_verts = num_new_verts(candidates[c]);
+        const bool better = new_verts < best_new_verts ||
+                            (new_verts == best_new_verts && candidates[c] < candidates[best]);
+        if (cluster_verts + new_verts <= MAX_CLUSTER_VERTICES && better) {
+          best = c;
+          best_new_verts = new_verts;
+        }
+        ++c;
+      }
+
+      if (best == candidates.size()) {
+        break;
+      }
+
+      const auto tri = candidates[best];
+      candidates[best] = candidates.back();
+      candidates.pop_back();
+      add_triangle(tri);
+    }
+
+    auto* const cluster_elements = result.data() + cluster_start;
+    const auto num_cluster_elements = result.size() - cluster_start;
+    mesh_optimizer::optimize_vertex_cache(
+        cluster_elements, num_cluster_elements, num_verts, mesh_optimizer::VERTEX_CACHE_SIZE, nullptr
+    );
+
+    StaticMesh::ClusterRange range;
+    range.start_elem_index = base_elem_index + (uint32_t)cluster_start;
+    range.num_elem_indices = (uint32_t)num_cluster_elements;
+    out_ranges.push_back(range);
+    out_bounds.push_back(compute_cluster_bounds(cluster_elements, num_cluster_elements, positions));
+  }
+
+  std::copy(result.begin(), result.end(), elements);
+}
+
+bool build_static_mesh_clusters(StaticMesh& mesh) {
+  const auto num_verts = mesh.num_verts();
+  const auto num_elements = mesh.num_triangle_elements();
+  std::vector<uint32_t> elements(mesh.triangle_elements(), mesh.triangle_elements() + num_elements);
+  const auto out_of_range = [num_verts](uint32_t elem) { return elem >= num_verts; };
+  if (std::any_of(elements.begin(), elements.end(), out_of_range)) {
+    return false;
+  }
+
+  // Clusters can't span materials, as they're drawn separately
+  std::vector<std::pair<size_t, size_t>> ranges;
+  for (size_t i = 0; i < mesh.num_materials(); ++i) {
+    const auto& mat = mesh.materials()[i];
+    ranges.emplace_back(mat.start_elem_index(), mat.num_elem_indices());
+  }
+  if (ranges.empty()) {
+    ranges.emplace_back(0, num_elements);
+  }
+
+  std::sort(ranges.begin(), ranges.end());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    const auto end = ranges[i].first + ranges[i].second;
+    const bool overlaps_next = i + 1 < ranges.size() && end > ranges[i + 1].first;
+    if (ranges[i].first % 3 != 0 || ranges[i].second % 3 != 0 || end > num_elements || overlaps_next) {
+      return false;
+    }
+  }
+
+  std::vector<StaticMesh::ClusterRange> cluster_ranges;
+  std::vector<StaticMesh::ClusterBounds> cluster_bounds;
+  if (mesh.num_triangles() >= MIN_CLUSTERED_MESH_TRIANGLES) {
+    for (const auto& range : ranges) {
+      build_clusters(
+          elements.data() + range.first,
+          range.second,
+          mesh.vertex_positions(),
+          num_verts,
+          (uint32_t)range.first,
+          cluster_ranges,
+          cluster_bounds
+      );
+    }
+
+    mesh.set_triangle_elements(std::move(elements));
+  }
+
+  mesh.set_clusters(std::move(cluster_ranges), std::move(cluster_bounds));
+  return true;
+}
+
+size_t cull_clusters(
+    const StaticMesh::ClusterRange* ranges,
+    const StaticMesh::ClusterBounds* bounds,
+    size_t num_clusters,
+    const Mat4& local_to_clip,
+    const Vec3& local_camera_pos,
+    bool cull_backfacing,
+    std::vector<StaticMesh::ClusterRange>& out_ranges
+) {
+  // Extract the frustum planes in local space, each normalized so the distance to them may be compared
+  float planes[6][4];
+  for (uint32_t i = 0; i < 6; ++i) {
+    const auto row = i / 2;
+    const float sign = i % 2 == 0 ? 1.f : -1.f;
+    for (uint32_t column = 0; column < 4; ++column) {
+      planes[i][column] = local_to_clip.get(column, 3) + sign * local_to_clip.get(column, row);
+    }
+
+    const auto length = Vec3{planes[i][0], planes[i][1], planes[i][2]}.length();
+    for (auto& value : planes[i]) {
+      value /= length > 0.f ? length : 1.f;
+    }
+  }
+
+  size_t num_visible = 0;
+  for (size_t i = 0; i < num_clusters; ++i) {
+    const auto& cluster = bounds[i];
+    bool visible = true;
+    for (const auto& plane : planes) {
+      const auto dist = plane[0] * cluster.center.x() + plane[1] * cluster.center.y() +
+                        plane[2] * cluster.center.z() + plane[3];
+      if (dist < -cluster.radius) {
+        visible = false;
+        break;
+      }
+    }
+
+    if (visible && cull_backfacing && cluster.cone_cutoff < 1.f) {
+      const auto to_center = cluster.center - local_camera_pos;
+      const auto cutoff_dist = cluster.cone_cutoff * to_center.length() + cluster.radius;
+      visible = Vec3::dot(to_center, cluster.cone_axis) < cutoff_dist;
+    }
+
+    if (!visible) {
+      continue;
+    }
+
+    // Extend the previous range if this cluster follows it
+    num_visible += 1;
+    auto* const prev = out_ranges.empty() ? nullptr : &out_ranges.back();
+    if (prev && prev->start_elem_index + prev->num_elem_indices == ranges[i].start_elem_index) {
+      prev->num_elem_indices += ranges[i].num_elem_indices;
+    } else {
+      out_ranges.push_back(ranges[i]);
+    }
+  }
+
+  return num_visible;
+}
+}  // namespace mesh_clusters
+}  // namespace sge
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "lib/resource/resources/static_mesh.h"
+
+namespace sge {
+struct Mat4;
+
+namespace mesh_clusters {
+/* Most vertices and triangles in a cluster. */
+static constexpr size_t MAX_CLUSTER_VERTICES = 64;
+static constexpr size_t MAX_CLUSTER_TRIANGLES = 124;
+
+/* Meshes with fewer triangles than this aren't split into clusters, as culling them wouldn't save much. */
+static constexpr size_t MIN_CLUSTERED_MESH_TRIANGLES = 4096;
+
+/* Normal cones narrower than this (as the cosine of the widest angle from their axis) may be culled. */
+static constexpr float MIN_CONE_DOT = 0.1f;
+
+/**
+ * \brief Computes the bounding sphere and normal cone of the given triangles.
+ */
+SGE_RESOURCE_API StaticMesh::ClusterBounds
+compute_cluster_bounds(const uint32_t* elements, size_t num_elements, const Vec3* positions);
+
+/**
+ * \brief Splits triangles into clusters of neighbours, by growing each cluster from the first triangle not
+ * yet in one, preferring the triangles that add the fewest new vertices. The triangles of each cluster are
+ * then optimized for the vertex cache.
+ * \param elements The triangle elements to reorder in place, so each cluster's triangles are contiguous.
+ * \param num_elements The number of triangle elements.
+ * \param positions The vertex positions.
+ * \param num_verts The number of vertices.
+ * \param base_elem_index Offset of 'elements' within the mesh, added to the range of each cluster.
+ * \param out_ranges Appended with the elements of each cluster.
+ * \param out_bounds Appended with the bounds of each cluster.
+ */
+SGE_RESOURCE_API void build_clusters(
+    uint32_t* elements,
+    size_t num_elements,
+    const Vec3* positions,
+    size_t num_verts,
+    uint32_t base_elem_index,
+    std::vector<StaticMesh::ClusterRange>& out_ranges,
+    std::vector<StaticMesh::ClusterBounds>& out_bounds
+);
+
+/**
+ * \brief Replaces the clusters of the mesh with clusters built from each of its material ranges, reordering
+ * the triangles of each range so that its clusters are contiguous. Meshes with fewer than
+ * 'MIN_CLUSTERED_MESH_TRIANGLES' triangles are left without clusters.
+ * \return Whether clusters could be built, which requires the mesh's material ranges to be made up of whole
+ * triangles within its elements, without overlapping, and its elements to be within its vertices.
+ */
+SGE_RESOURCE_API bool build_static_mesh_clusters(StaticMesh& mesh);
+
+/**
+ * \brief Finds the clusters that may be visible, and appends the element ranges to draw them with. Clusters
+ * that are adjacent in the element buffer are drawn as one range.
+ * \param ranges The elements of each cluster.
+ * \param bounds The bounds of each cluster.
+ * \param num_clusters The number of clusters.
+ * \param local_to_clip Matrix transforming from the mesh's local space to clip space.
+ * \param local_camera_pos Position of the camera in the mesh's local space.
+ * \param cull_backfacing Whether clusters facing away from the camera are culled, in addition to those
+ * outside of its frustum.
+ * \param out_ranges Appended with the element ranges to draw.
+ * \return The number of clusters that may be visible.
+ */
+SGE_RESOURCE_API size_t cull_clusters(
+    const StaticMesh::ClusterRange* ranges,
+    const StaticMesh::ClusterBounds* bounds,
+    size_t num_clusters,
+    const Mat4& local_to_clip,
+    const Vec3& local_camera_pos,
+    bool cull_backfacing,
+    std::vector<StaticMesh::ClusterRange>& out_ranges
+);
+}  // namespace mesh_clusters
+}  // namespace sge
@@ -0,0 +1,356 @@
+#include <string.h>
+#include <algorithm>
+#include <utility>
+
+#include "lib/base/math/vec3.h"
+#include "lib/resource/misc/mesh_optimizer.h"
+#include "lib/resource/resources/static_mesh.h"
+
+namespace sge {
+namespace mesh_optimizer {
+/**
+ * \brief A FIFO vertex cache, simulated with timestamps: a vertex is cached if it was added within the last
+ * 'cache_size' additions.
+ */
+struct VertexCache {
+  VertexCache(size_t num_verts, size_t cache_size)
+      : timestamps(num_verts, 0), time((uint32_t)cache_size + 1), cache_size((uint32_t)cache_size) {}
+
+  bool contains(uint32_t vert) const { return time - timestamps[vert] <= cache_size; }
+
+  /* Adds the vertex if it isn't cached, returning whether it had to be transformed. */
+  bool add(uint32_t vert) {
+    if (contains(vert)) {
+      return false;
+    }
+
+    timestamps[vert] = time++;
+    return true;
+  }
+
+  /* Evicts every vertex. */
+  void flush() { time += cache_size + 1; }
+
+  std::vector<uint32_t> timestamps;
+  uint32_t time;
+  uint32_t cache_size;
+};
+
+float compute_acmr(const uint32_t* elements, size_t num_elements, size_t num_verts, size_t cache_size) {
+  if (num_elements < 3) {
+    return 0.f;
+  }
+
+  VertexCache cache{num_verts, cache_size};
+  size_t num_misses = 0;
+  for (size_t i = 0; i < num_elements; ++i) {
+    num_misses += cache.add(elements[i]);
+  }
+
+  return (float)num_misses / (float)(num_elements / 3);
+}
+
+void optimize_vertex_cache(
+    uint32_t* elements,
+    size_t num_elements,
+    size_t num_verts,
+    size_t cache_size,
+    std::vector<uint32_t>* out_clusters
+) {
+  if (out_clusters) {
+    out_clusters->clear();
+  }
+
+  const auto num_triangles = num_elements / 3;
+  if (num_triangles == 0) {
+    return;
+  }
+
+  // Find the triangles using each vertex, and how many of them are yet to be emitted
+  std::vector<uint32_t> live_triangles(num_verts, 0);
+  for (size_t i = 0; i < num_triangles * 3; ++i) {
+    live_triangles[elements[i]] += 1;
+  }
+
+  std::vector<uint32_t> adjacency_offsets(num_verts + 1, 0);
+  for (size_t i = 0; i < num_verts; ++i) {
+    adjacency_offsets[i + 1] = adjacency_offsets[i] + live_triangles[i];
+  }
+
+  std::vector<uint32_t> adjacency(num_triangles * 3);
+  std::vector<uint32_t> adjacency_ends(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+  for (size_t i = 0; i < num_triangles * 3; ++i) {
+    adjacency[adjacency_ends[elements[i]]++] = (uint32_t)(i / 3);
+  }
+
+  VertexCache cache{num_verts, cache_size};
+  std::vector<bool> emitted(num_triangles, false);
+  std::vector<uint32_t> dead_end_stack;
+  std::vector<uint32_t> candidates;
+  std::vector<uint32_t> result;
+  result.reserve(num_triangles * 3);
+  size_t cursor = 0;
+  int64_t fan_vert = elements[0];
+  bool starts_cluster = true;
+
+  while (fan_vert >= 0) {
+    if (starts_cluster && out_clusters) {
+      out_clusters->push_back((uint32_t)(result.size() / 3));
+    }
+
+    // Emit every remaining triangle around the fanning vertex
+    candidates.clear();
+    for (auto i = adjacency_offsets[fan_vert]; i < adjacency_offsets[fan_vert + 1]; ++i) {
+      const auto triangle = adjacency[i];
+      if (emitted[triangle]) {
+        continue;
+      }
+
+      emitted[triangle] = true;
+      for (size_t j = 0; j < 3; ++j) {
+        const auto vert = elements[triangle * 3 + j];
+        result.push_back(vert);
+        dead_end_stack.push_back(vert);
+        candidates.push_back(vert);
+        live_triangles[vert] -= 1;
+        cache.add(vert);
+      }
+    }
+
+    // Fan around the candidate that will stay cached the longest after emitting its remaining triangles, or
+    // otherwise any candidate with triangles remaining
+    int64_t next_vert = -1;
+    int64_t best_priority = -1;
+    for (const auto vert : candidates) {
+      if (live_triangles[vert] == 0) {
+        continue;
+      }
+
+      int64_t priority = 0;
+      const auto age = cache.time - cache.timestamps[vert];
+      if (age + 2 * live_triangles[vert] <= cache.cache_size) {
+        priority = age;
+      }
+
+      if (priority > best_priority) {
+        best_priority = priority;
+        next_vert = vert;
+      }
+    }
+
+    // At a dead end, so fall back to the most recently used vertex with triangles remaining, and then to the
+    // next vertex in input order
+    starts_cluster = next_vert < 0;
+    while (next_vert < 0 && !dead_end_stack.empty()) {
+      const auto vert = dead_end_stack.back();
+      dead_end_stack.pop_back();
+      if (live_triangles[vert] != 0) {
+        next_vert = vert;
+      }
+    }
+
+    for (; next_vert < 0 && cursor < num_verts; ++cursor) {
+      if (live_triangles[cursor] != 0) {
+        next_vert = (int64_t)cursor;
+      }
+    }
+
+    fan_vert = next_vert;
+  }
+
+  memcpy(elements, result.data(), result.size() * sizeof(uint32_t));
+}
+
+/* Splits each cluster into the smallest clusters whose ACMR is within the threshold of the original's. */
+static std::vector<uint32_t> split_clusters(
+    const uint32_t* elements,
+    size_t num_triangles,
+    size_t num_verts,
+    const std::vector<uint32_t>& clusters,
+    size_t cache_size,
+    float threshold
+) {
+  std::vector<uint32_t> result;
+  VertexCache cache{num_verts, cache_size};
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    const size_t start = clusters[i];
+    const size_t end = i + 1 < clusters.size() ? clusters[i + 1] : num_triangles;
+    // Find the ACMR of the whole cluster
+    cache.flush();
+    size_t num_misses = 0;
+    for (size_t j = start * 3; j < end * 3; ++j) {
+      num_misses += cache.add(elements[j]);
+    }
+
+    const auto max_acmr = (float)num_misses / (float)(end - start) * threshold;
+    cache.flush();
+    result.push_back((uint32_t)start);
+    num_misses = 0;
+    size_t cluster_start = start;
+    for (size_t triangle = start; triangle < end; ++triangle) {
+      for (size_t j = 0; j < 3; ++j) {
+        num_misses += cache.add(elements[triangle * 3 + j]);
+      }
+
+      // Drawing each split cluster from a cold cache must cost about as much as drawing the original did
+      const auto num_cluster_triangles = triangle + 1 - cluster_start;
+      if (triangle + 1 < end && (float)num_misses <= max_acmr * (float)num_cluster_triangles) {
+        cache.flush();
+        result.push_back((uint32_t)(triangle + 1));
+        num_misses = 0;
+        cluster_start = triangle + 1;
+      }
+    }
+  }
+
+  return result;
+}
+
+void optimize_overdraw(
+    uint32_t* elements,
+    size_t num_elements,
+    const Vec3* positions,
+    size_t num_verts,
+    const std::vector<uint32_t>& clusters,
+    size_t cache_size,
+    float threshold
+) {
+  const auto num_triangles = num_elements / 3;
+  if (num_triangles == 0 || clusters.empty()) {
+    return;
+  }
+
+  const auto split = split_clusters(elements, num_triangles, num_verts, clusters, cache_size, threshold);
+
+  // Find the area-weighted centroid and normal of each cluster, and the centroid of the whole mesh
+  std::vector<Vec3> centroids(split.size());
+  std::vector<Vec3> normals(split.size());
+  Vec3 mesh_centroid = Vec3::zero();
+  float mesh_area = 0.f;
+  for (size_t i = 0; i < split.size(); ++i) {
+    const size_t end = i + 1 < split.size() ? split[i + 1] : num_triangles;
+    Vec3 centroid = Vec3::zero();
+    Vec3 normal = Vec3::zero();
+    float area = 0.f;
+    for (size_t triangle = split[i]; triangle < end; ++triangle) {
+      const auto& a = positions[elements[triangle * 3]];
+      const auto& b = positions[elements[triangle * 3 + 1]];
+      const auto& c = positions[elements[triangle * 3 + 2]];
+      const auto cross = Vec3::cross(b - a, c - a);
+      const auto triangle_area = cross.length();
+      centroid += (a + b + c) * (triangle_area / 3.f);
+      normal += cross;
+      area += triangle_area;
+    }
+
+    mesh_centroid += centroid;
+    mesh_area += area;
+    centroids[i] = area > 0.f ? centroid / area : centroid;
+    normals[i] = normal.normalized();
+  }
+
+  if (mesh_area > 0.f) {
+    mesh_centroid /= mesh_area;
+  }
+
+  // Draw the clusters facing furthest outwards first
+  std::vector<std::pair<float, uint32_t>> order(split.size());
+  for (size_t i = 0; i < split.size(); ++i) {
+    order[i] = std::make_pair(Vec3::dot(centroids[i] - mesh_centroid, normals[i]), (uint32_t)i);
+  }
+
+  std::stable_sort(order.begin(), order.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first > rhs.first;
+  });
+
+  std::vector<uint32_t> result;
+  result.reserve(num_triangles * 3);
+  for (const auto& cluster : order) {
+    const size_t start = split[cluster.second];
+    const size_t end = cluster.second + 1 < split.size() ? split[cluster.second + 1] : num_triangles;
+    result.insert(result.end(), elements + start * 3, elements + end * 3);
+  }
+
+  memcpy(elements, result.data(), result.size() * sizeof(uint32_t));
+}
+
+void optimize_vertex_fetch_remap(
+    uint32_t* out_remap,
+    const uint32_t* elements,
+    size_t num_elements,
+    size_t num_verts
+) {
+  constexpr uint32_t UNASSIGNED = UINT32_MAX;
+  std::fill(out_remap, out_remap + num_verts, UNASSIGNED);
+
+  uint32_t next_index = 0;
+  for (size_t i = 0; i < num_elements; ++i) {
+    if (out_remap[elements[i]] == UNASSIGNED) {
+      out_remap[elements[i]] = next_index++;
+    }
+  }
+
+  for (size_t i = 0; i < num_verts; ++i) {
+    if (out_remap[i] == UNASSIGNED) {
+      out_remap[i] = next_index++;
+    }
+  }
+}
+
+bool optimize_static_mesh(StaticMesh& mesh, Stats& out_stats) {
+  const auto num_verts = mesh.num_verts();
+  const auto num_elements = mesh.num_triangle_elements();
+  std::vector<uint32_t> elements(mesh.triangle_elements(), mesh.triangle_elements() + num_elements);
+  const auto out_of_range = [num_verts](uint32_t elem) { return elem >= num_verts; };
+  if (std::any_of(elements.begin(), elements.end(), out_of_range)) {
+    return false;
+  }
+
+  // Each material range is drawn separately, so they're optimized separately
+  std::vector<std::pair<size_t, size_t>> ranges;
+  for (size_t i = 0; i < mesh.num_materials(); ++i) {
+    const auto& mat = mesh.materials()[i];
+    ranges.emplace_back(mat.start_elem_index(), mat.num_elem_indices());
+  }
+  if (ranges.empty()) {
+    ranges.emplace_back(0, num_elements);
+  }
+
+  std::sort(ranges.begin(), ranges.end());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    const auto end = ranges[i].first + ranges[i].second;
+    const bool overlaps_next = i + 1 < ranges.size() && end > ranges[i + 1].first;
+    if (ranges[i].first % 3 != 0 || ranges[i].second % 3 != 0 || end > num_elements || overlaps_next) {
+      return false;
+    }
+  }
+
+  out_stats.num_triangles = num_elements / 3;
+  out_stats.acmr_before = compute_acmr(elements.data(), num_elements, num_verts, VERTEX_CACHE_SIZE);
+
+  std::vector<uint32_t> clusters;
+  for (const auto& range : ranges) {
+    auto* const range_elements = elements.data() + range.first;
+    optimize_vertex_cache(range_elements, range.second, num_verts, VERTEX_CACHE_SIZE, &clusters);
+    optimize_overdraw(
+        range_elements,
+        range.second,
+        mesh.vertex_positions(),
+        num_verts,
+        clusters,
+        VERTEX_CACHE_SIZE,
+        OVERDRAW_THRESHOLD
+    );
+  }
+
+  std::vector<uint32_t> remap(num_verts);
+  optimize_vertex_fetch_remap(remap.data(), elements.data(), num_elements, num_verts);
+  mesh.set_triangle_elements(std::move(elements));
+  mesh.remap_vertices(remap.data());
+
+  out_stats.acmr_after =
+      compute_acmr(mesh.triangle_elements(), num_elements, num_verts, VERTEX_CACHE_SIZE);
+  return true;
+}
+}  // namespace mesh_optimizer
+}  // namespace sge
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "lib/resource/build.h"
+
+namespace sge {
+struct StaticMesh;
+struct Vec3;
+
+namespace mesh_optimizer {
+/* Size of the FIFO post-transform vertex cache that meshes are optimized for, and measured against. */
+static constexpr size_t VERTEX_CACHE_SIZE = 16;
+
+/* How far above the ACMR of a vertex cache optimized cluster the ACMR of the smaller clusters it's split into
+ * for overdraw ordering may be. */
+static constexpr float OVERDRAW_THRESHOLD = 1.05f;
+
+struct Stats {
+  size_t num_triangles = 0;
+
+  /* Average cache miss ratio (vertices transformed per triangle, from 0.5 to 3) before and after. */
+  float acmr_before = 0.f;
+  float acmr_after = 0.f;
+};
+
+/**
+ * \brief Simulates drawing the given triangles through a FIFO post-transform vertex cache.
+ * \return The average number of vertices transformed per triangle.
+ */
+SGE_RESOURCE_API float
+compute_acmr(const uint32_t* elements, size_t num_elements, size_t num_verts, size_t cache_size);
+
+/**
+ * \brief Reorders triangles so that they reuse vertices from the post-transform vertex cache, by fanning
+ * around each vertex while it's still cached (Tipsify).
+ * \param elements The triangle elements to reorder in place.
+ * \param num_elements The number of triangle elements.
+ * \param num_verts The number of vertices referenced by the elements.
+ * \param cache_size The size of the vertex cache.
+ * \param out_clusters If not null, set to the index of the first triangle of each cluster, which is wherever
+ * the order had to jump somewhere that isn't cached.
+ */
+SGE_RESOURCE_API void optimize_vertex_cache(
+    uint32_t* elements,
+    size_t num_elements,
+    size_t num_verts,
+    size_t cache_size,
+    std::vector<uint32_t>* out_clusters
+);
+
+/**
+ * \brief Reorders the clusters of vertex cache optimized triangles, so that those facing outwards from the
+ * center of the mesh (which are likely to occlude the rest) are drawn first. Clusters are split further where
+ * that keeps them within 'threshold' of their ACMR.
+ * \param elements The triangle elements to reorder in place, which must be vertex cache optimized.
+ * \param num_elements The number of triangle elements.
+ * \param positions The vertex positions.
+ * \param num_verts The number of vertices.
+ * \param clusters The first triangle of each cluster, from 'optimize_vertex_cache'.
+ * \param cache_size The size of the vertex cache.
+ * \param threshold How much worse ACMR may get, as a ratio.
+ */
+SGE_RESOURCE_API void optimize_overdraw(
+    uint32_t* elements,
+    size_t num_elements,
+    const Vec3* positions,
+    size_t num_verts,
+    const std::vector<uint32_t>& clusters,
+    size_t cache_size,
+    float threshold
+);
+
+/**
+ * \brief Computes a new order for vertices matching the order they're first used in by the given elements,
+ * so that vertex fetches are sequential. Unused vertices are placed at the end.
+ * \param out_remap Array of 'num_verts' new vertex indices to fill in.
+ */
+SGE_RESOURCE_API void optimize_vertex_fetch_remap(
+    uint32_t* out_remap,
+    const uint32_t* elements,
+    size_t num_elements,
+    size_t num_verts
+);
+
+/**
+ * \brief Optimizes the triangle order of each of the mesh's material ranges for the vertex cache and
+ * overdraw, and then reorders its vertices for fetching.
+ * \param mesh The mesh to optimize.
+ * \param out_stats Set to the ACMR of the mesh before and after.
+ * \return Whether the mesh could be optimized, which requires its material ranges to be made up of whole
+ * triangles within its elements, and its elements to be within its vertices.
+ */
+SGE_RESOURCE_API bool optimize_static_mesh(StaticMesh& mesh, Stats& out_stats);
+}  // namespace mesh_optimizer
+}  // namespace sge
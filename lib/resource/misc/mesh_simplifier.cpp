@@ -0,0 +1,394 @@
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "lib/base/math/vec3.h"
+#include "lib/resource/misc/mesh_optimizer.h"
+#include "lib/resource/misc/mesh_simplifier.h"
+#include "lib/resource/resources/static_mesh.h"
+
+namespace sge {
+namespace mesh_simplifier {
+/* Smallest cosine of the angle that a collapse may rotate a triangle by. Rejecting large rotations, rather
+ * than only outright flips, keeps triangles from turning over bit by bit across several collapses. */
+static constexpr float FLIP_THRESHOLD = 0.25f;
+
+/**
+ * \brief The sum of the squared distances to a set of weighted planes, as a symmetric 4x4 matrix.
+ */
+struct Quadric {
+  void add_plane(const Vec3& normal, float dist, double plane_weight) {
+    const double a = normal.x(), b = normal.y(), c = normal.z(), d = dist;
+    a2 += plane_weight * a * a;
+    ab += plane_weight * a * b;
+    ac += plane_weight * a * c;
+    ad += plane_weight * a * d;
+    b2 += plane_weight * b * b;
+    bc += plane_weight * b * c;
+    bd += plane_weight * b * d;
+    c2 += plane_weight * c * c;
+    cd += plane_weight * c * d;
+    d2 += plane_weight * d * d;
+    weight += plane_weight;
+  }
+
+  Quadric& operator+=(const Quadric& rhs) {
+    a2 += rhs.a2;
+    ab += rhs.ab;
+    ac += rhs.ac;
+    ad += rhs.ad;
+    b2 += rhs.b2;
+    bc += rhs.bc;
+    bd += rhs.bd;
+    c2 += rhs.c2;
+    cd += rhs.cd;
+    d2 += rhs.d2;
+    weight += rhs.weight;
+    return *this;
+  }
+
+  /* Returns the weighted average squared distance from the point to the planes. */
+  double error(const Vec3& point) const {
+    if (weight <= 0.0) {
+      return 0.0;
+    }
+
+    const double x = point.x(), y = point.y(), z = point.z();
+    const double result = a2 * x * x + b2 * y * y + c2 * z * z +
+                          2.0 * (ab * x * y + ac * x * z + bc * y * z + ad * x + bd * y + cd * z) + d2;
+    return fabs(result) / weight;
+  }
+
+  double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+  double b2 = 0.0, bc = 0.0, bd = 0.0;
+  double c2 = 0.0, cd = 0.0;
+  double d2 = 0.0;
+  double weight = 0.0;
+};
+
+/* Moving a vertex onto another, as the collapse of the edge between them. */
+struct Collapse {
+  uint32_t from;
+  uint32_t to;
+  double cost;
+};
+
+static Vec3 triangle_normal(const Vec3& a, const Vec3& b, const Vec3& c) {
+  return Vec3::cross(b - a, c - a);
+}
+
+/**
+ * \brief Finds the vertices that may not be collapsed: those on an edge used by anything other than two
+ * triangles (which includes the borders of the mesh), and those sharing their position with another vertex.
+ */
+static std::vector<bool> find_locked_vertices(
+    const uint32_t* elements,
+    size_t num_elements,
+    const Vec3* positions,
+    size_t num_verts
+) {
+  std::vector<bool> locked(num_verts, false);
+
+  // Edges used by both of two triangles appear twice, once in each direction
+  std::vector<uint64_t> edges;
+  edges.reserve(num_elements);
+  for (size_t i = 0; i + 2 < num_elements; i += 3) {
+    for (size_t e = 0; e < 3; ++e) {
+      const auto a = elements[i + e];
+      const auto b = elements[i + (e + 1) % 3];
+      edges.push_back((uint64_t)std::min(a, b) << 32 | std::max(a, b));
+    }
+  }
+
+  std::sort(edges.begin(), edges.end());
+  for (size_t i = 0; i < edges.size();) {
+    size_t end = i + 1;
+    while (end < edges.size() && edges[end] == edges[i]) {
+      ++end;
+    }
+
+    if (end - i != 2) {
+      locked[edges[i] >> 32] = true;
+      locked[edges[i] & UINT32_MAX] = true;
+    }
+    i = end;
+  }
+
+  // Vertices at the same position are split along a seam in their other attributes
+  std::vector<uint32_t> used;
+  used.reserve(num_elements);
+  std::vector<bool> is_used(num_verts, false);
+  for (size_t i = 0; i < num_elements; ++i) {
+    if (!is_used[elements[i]]) {
+      is_used[elements[i]] = true;
+      used.push_back(elements[i]);
+    }
+  }
+
+  const auto position_less = [positions](uint32_t lhs, uint32_t rhs) {
+    const auto& a = positions[lhs];
+    const auto& b = positions[rhs];
+    return a.x() != b.x() ? a.x() < b.x() : a.y() != b.y() ? a.y() < b.y() : a.z() < b.z();
+  };
+  std::sort(used.begin(), used.end(), position_less);
+  for (size_t i = 1; i < used.size(); ++i) {
+    if (positions[used[i - 1]] == positions[used[i]]) {
+      locked[used[i - 1]] = true;
+      locked[used[i]] = true;
+    }
+  }
+
+  return locked;
+}
+
+size_t simplify(
+    uint32_t* out_elements,
+    const uint32_t* elements,
+    size_t num_elements,
+    const Vec3* positions,
+    size_t num_verts,
+    size_t target_num_elements,
+    float max_error,
+    float& out_error
+) {
+  std::vector<uint32_t> indices(elements, elements + num_elements - num_elements % 3);
+  out_error = 0.f;
+
+  // Each vertex starts out with the planes of the triangles around it, weighted by their area
+  std::vector<Quadric> quadrics(num_verts);
+  for (size_t i = 0; i < indices.size(); i += 3) {
+    const auto& p0 = positions[indices[i]];
+    const auto normal = triangle_normal(p0, positions[indices[i + 1]], positions[indices[i + 2]]);
+    const auto area = normal.length();
+    if (area <= 0.f) {
+      continue;
+    }
+
+    const auto unit_normal = normal / area;
+    const auto dist = -Vec3::dot(unit_normal, p0);
+    for (size_t v = 0; v < 3; ++v) {
+      quadrics[indices[i + v]].add_plane(unit_normal, dist, area * 0.5);
+    }
+  }
+
+  const auto locked = find_locked_vertices(indices.data(), indices.size(), positions, num_verts);
+  const double max_cost = (double)max_error * max_error;
+  double cost_so_far = 0.0;
+
+  std::vector<uint32_t> adjacency_offsets(num_verts + 1);
+  std::vector<uint32_t> adjacency;
+  std::vector<Collapse> collapses;
+  std::vector<bool> frozen(num_verts);
+  std::vector<uint32_t> remap(num_verts);
+  std::iota(remap.begin(), remap.end(), 0);
+
+  // Each pass collapses as many edges as it can without them touching, cheapest first
+  while (indices.size() > target_num_elements) {
+    const auto num_triangles = indices.size() / 3;
+
+    // Find the triangles around each vertex
+    std::fill(adjacency_offsets.begin(), adjacency_offsets.end(), 0);
+    for (const auto index : indices) {
+      adjacency_offsets[index + 1] += 1;
+    }
+    std::partial_sum(adjacency_offsets.begin(), adjacency_offsets.end(), adjacency_offsets.begin());
+
+    adjacency.resize(indices.size());
+    auto fill_offsets = adjacency_offsets;
+    for (size_t i = 0; i < indices.size(); ++i) {
+      adjacency[fill_offsets[indices[i]]++] = (uint32_t)(i / 3);
+    }
+
+    // Collapses may go either way along an edge
+    collapses.clear();
+    for (size_t i = 0; i < indices.size(); i += 3) {
+      for (size_t e = 0; e < 3; ++e) {
+        const auto a = indices[i + e];
+        const auto b = indices[i + (e + 1) % 3];
+        for (const auto& [from, to] : {std::make_pair(a, b), std::make_pair(b, a)}) {
+          if (locked[from]) {
+            continue;
+          }
+
+          auto combined = quadrics[from];
+          combined += quadrics[to];
+          collapses.push_back(Collapse{from, to, combined.error(positions[to])});
+        }
+      }
+    }
+
+    std::sort(collapses.begin(), collapses.end(), [](const Collapse& lhs, const Collapse& rhs) {
+      return lhs.cost < rhs.cost;
+    });
+
+    // Moving a vertex only changes the triangles around it, so their vertices are frozen for the rest of the
+    // pass to keep the triangles that later collapses check up to date
+    std::fill(frozen.begin(), frozen.end(), false);
+    size_t num_removed = 0;
+    size_t num_collapsed = 0;
+    for (const auto& collapse : collapses) {
+      if (collapse.cost > max_cost || (num_triangles - num_removed) * 3 <= target_num_elements) {
+        break;
+      }
+      if (frozen[collapse.from] || frozen[collapse.to]) {
+        continue;
+      }
+
+      // The triangles that remain must not flip over, or come close to it
+      bool flips = false;
+      size_t num_shared = 0;
+      for (auto t = adjacency_offsets[collapse.from]; t < adjacency_offsets[collapse.from + 1]; ++t) {
+        const auto* const tri = indices.data() + adjacency[t] * 3;
+        if (tri[0] == collapse.to || tri[1] == collapse.to || tri[2] == collapse.to) {
+          num_shared += 1;
+          continue;
+        }
+
+        Vec3 moved[3];
+        for (size_t v = 0; v < 3; ++v) {
+          moved[v] = positions[tri[v] == collapse.from ? collapse.to : tri[v]];
+        }
+
+        const auto old_normal = triangle_normal(positions[tri[0]], positions[tri[1]], positions[tri[2]]);
+        const auto new_normal = triangle_normal(moved[0], moved[1], moved[2]);
+        const auto min_dot = FLIP_THRESHOLD * old_normal.length() * new_normal.length();
+        if (Vec3::dot(old_normal, new_normal) <= min_dot) {
+          flips = true;
+          break;
+        }
+      }
+      if (flips) {
+        continue;
+      }
+
+      remap[collapse.from] = collapse.to;
+      quadrics[collapse.to] += quadrics[collapse.from];
+      cost_so_far = std::max(cost_so_far, collapse.cost);
+      for (auto t = adjacency_offsets[collapse.from]; t < adjacency_offsets[collapse.from + 1]; ++t) {
+        for (size_t v = 0; v < 3; ++v) {
+          frozen[indices[adjacency[t] * 3 + v]] = true;
+        }
+      }
+
+      num_removed += num_shared;
+      num_collapsed += 1;
+    }
+
+    if (num_collapsed == 0) {
+      break;
+    }
+
+    // Move the collapsed vertices, and drop the triangles that collapsed with them
+    size_t write = 0;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+      const auto a = remap[indices[i]];
+      const auto b = remap[indices[i + 1]];
+      const auto c = remap[indices[i + 2]];
+      if (a != b && b != c && c != a) {
+        indices[write++] = a;
+        indices[write++] = b;
+        indices[write++] = c;
+      }
+    }
+    indices.resize(write);
+  }
+
+  out_error = (float)sqrt(cost_so_far);
+  if (!indices.empty()) {
+    memcpy(out_elements, indices.data(), indices.size() * sizeof(uint32_t));
+  }
+
+  return indices.size();
+}
+
+bool generate_static_mesh_lods(StaticMesh& mesh) {
+  const auto num_verts = mesh.num_verts();
+  const auto num_elements = mesh.num_triangle_elements();
+  const auto* const elements = mesh.triangle_elements();
+  const auto out_of_range = [num_verts](uint32_t elem) { return elem >= num_verts; };
+  if (std::any_of(elements, elements + num_elements, out_of_range)) {
+    return false;
+  }
+
+  // Each material's range is simplified separately, and keeps its place in the material order
+  std::vector<std::pair<size_t, size_t>> ranges;
+  for (size_t i = 0; i < mesh.num_materials(); ++i) {
+    const auto& mat = mesh.materials()[i];
+    ranges.emplace_back(mat.start_elem_index(), mat.num_elem_indices());
+  }
+  if (ranges.empty()) {
+    ranges.emplace_back(0, num_elements);
+  }
+
+  for (const auto& range : ranges) {
+    if (range.first % 3 != 0 || range.second % 3 != 0 || range.first + range.second > num_elements) {
+      return false;
+    }
+  }
+
+  Vec3 center;
+  float radius;
+  mesh.bounding_sphere(center, radius);
+
+  std::vector<StaticMesh::Lod> lods;
+  size_t prev_num_triangles = mesh.num_triangles();
+  float prev_error = 0.f;
+  float ratio = 1.f;
+  std::vector<uint32_t> range_elements(num_elements);
+  while (radius > 0.f && lods.size() < MAX_LODS && prev_num_triangles >= MIN_LOD_TRIANGLES) {
+    // Simplifying each LOD from the full mesh keeps their errors from compounding
+    ratio *= LOD_TRIANGLE_RATIO;
+    std::vector<uint32_t> lod_elements;
+    std::vector<uint32_t> lod_ranges;
+    float error = prev_error;
+    for (const auto& range : ranges) {
+      const auto target = (size_t)(range.second / 3 * ratio) * 3;
+      float range_error;
+      const auto num_range_elements = simplify(
+          range_elements.data(),
+          elements + range.first,
+          range.second,
+          mesh.vertex_positions(),
+          num_verts,
+          target,
+          MAX_LOD_ERROR * radius,
+          range_error
+      );
+      mesh_optimizer::optimize_vertex_cache(
+          range_elements.data(),
+          num_range_elements,
+          num_verts,
+          mesh_optimizer::VERTEX_CACHE_SIZE,
+          nullptr
+      );
+
+      lod_ranges.push_back((uint32_t)lod_elements.size());
+      lod_ranges.push_back((uint32_t)num_range_elements);
+      lod_elements.insert(
+          lod_elements.end(), range_elements.begin(), range_elements.begin() + num_range_elements
+      );
+      error = std::max(error, range_error / radius);
+    }
+
+    const auto num_triangles = lod_elements.size() / 3;
+    if (num_triangles == 0 || num_triangles > prev_num_triangles * MIN_LOD_REDUCTION) {
+      break;
+    }
+
+    StaticMesh::Lod lod;
+    lod.error = error;
+    lod.triangle_elements = StaticMesh::Array<uint32_t>::from_vector(std::move(lod_elements));
+    lod.material_ranges = StaticMesh::Array<uint32_t>::from_vector(std::move(lod_ranges));
+    lods.push_back(std::move(lod));
+    prev_num_triangles = num_triangles;
+    prev_error = error;
+  }
+
+  mesh.set_lods(std::move(lods));
+  return true;
+}
+}  // namespace mesh_simplifier
+}  // namespace sge
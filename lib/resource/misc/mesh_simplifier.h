@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lib/resource/build.h"
+
+namespace sge {
+struct StaticMesh;
+struct Vec3;
+
+namespace mesh_simplifier {
+/* Most LODs generated for a mesh, not including the full mesh. */
+static constexpr size_t MAX_LODS = 4;
+
+/* Ratio of the full mesh's triangles that each successive LOD aims to keep. */
+static constexpr float LOD_TRIANGLE_RATIO = 0.5f;
+
+/* LODs stop being generated once they'd have fewer triangles than this. */
+static constexpr size_t MIN_LOD_TRIANGLES = 32;
+
+/* LODs stop being generated once they'd keep more than this ratio of the previous LOD's triangles, as they
+ * would cost more memory than they save in drawing. */
+static constexpr float MIN_LOD_REDUCTION = 0.75f;
+
+/* Largest error any LOD may have, relative to the bounding radius of the mesh. */
+static constexpr float MAX_LOD_ERROR = 0.1f;
+
+/**
+ * \brief Simplifies triangles by collapsing their edges onto existing vertices, in order of how far each
+ * collapse would move the surface (as measured by the quadric error metric), so the result references a
+ * subset of the same vertices. Vertices on borders, and those sharing their position with other vertices
+ * (such as along UV seams), are never collapsed, so that separately simplified parts still meet.
+ * \param out_elements Array of at least 'num_elements' elements to write the simplified triangles to.
+ * \param elements The triangle elements to simplify.
+ * \param num_elements The number of triangle elements.
+ * \param positions The vertex positions.
+ * \param num_verts The number of vertices.
+ * \param target_num_elements The number of elements to simplify down to, if possible.
+ * \param max_error The furthest that the surface may move.
+ * \param out_error Set to how far the surface may have moved.
+ * \return The number of elements written to 'out_elements'.
+ */
+SGE_RESOURCE_API size_t simplify(
+    uint32_t* out_elements,
+    const uint32_t* elements,
+    size_t num_elements,
+    const Vec3* positions,
+    size_t num_verts,
+    size_t target_num_elements,
+    float max_error,
+    float& out_error
+);
+
+/**
+ * \brief Replaces the LODs of the mesh with a chain of successively simplified versions of it. Each of the
+ * mesh's material ranges is simplified separately, and each LOD is optimized for the vertex cache.
+ * \return Whether LODs could be generated, which requires the mesh's material ranges to be made up of whole
+ * triangles within its elements, and its elements to be within its vertices. A mesh that can't be simplified
+ * enough to be worth it is left without LODs.
+ */
+SGE_RESOURCE_API bool generate_static_mesh_lods(StaticMesh& mesh);
+}  // namespace mesh_simplifier
+}  // namespace sge
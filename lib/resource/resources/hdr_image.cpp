@@ -5,6 +5,7 @@
 #include "lib/base/reflection/reflection_builder.h"
 #include "lib/resource/interfaces/from_file.h"
 #include "lib/resource/resources/hdr_image.h"
+#include "lib/resource/sources/resource_source.h"
 
 SGE_REFLECT_TYPE(sge::HDRImage).implements<IFromFile>();
 
@@ -64,14 +65,21 @@ HDRImage& HDRImage::operator=(HDRImage&& move) {
 }
 
 bool HDRImage::from_file(const char* path) {
+  ResourceData resource;
+  if (!open_resource(path, true, resource) || resource.size > UINT32_MAX) {
+    return false;
+  }
+
   // Get the FreeImage file type
-  auto format = FreeImage_GetFileType(path);
+  auto* const memory = FreeImage_OpenMemory(const_cast<BYTE*>(resource.data), (DWORD)resource.size);
+  auto format = FreeImage_GetFileTypeFromMemory(memory);
   if (format == FIF_UNKNOWN) {
     format = FreeImage_GetFIFFromFilename(path);
   }
 
   // Load the image
-  auto image = FreeImage_Load(format, path);
+  auto image = FreeImage_LoadFromMemory(format, memory);
+  FreeImage_CloseMemory(memory);
   if (!image) {
     return false;
   }
@@ -8,6 +8,7 @@
 #include "lib/base/reflection/reflection_builder.h"
 #include "lib/resource/interfaces/from_file.h"
 #include "lib/resource/resources/image.h"
+#include "lib/resource/sources/resource_source.h"
 
 SGE_REFLECT_TYPE(sge::Image).implements<IFromFile>();
 
@@ -41,8 +42,13 @@ Image::~Image() {
 }
 
 bool Image::from_file(const char* path) {
+  ResourceData resource;
+  if (!open_resource(path, true, resource) || resource.size > INT32_MAX) {
+    return false;
+  }
+
   qoi_desc desc;
-  void* result = qoi_read(path, &desc, 4);
+  void* result = qoi_decode(resource.data, (int)resource.size, &desc, 4);
   if (!result) {
     return false;
   }
@@ -1,4 +1,8 @@
+#include <assert.h>
+#include <math.h>
 #include <stdint.h>
+#include <string.h>
+#include <algorithm>
 #include <fstream>
 
 #include "lib/base/reflection/reflection_builder.h"
@@ -47,44 +51,175 @@ uint32_t StaticMesh::Material::num_elem_indices() const {
   return _num_elem_indices;
 }
 
+/**
+ * \brief Reads a typed array of 'ElemT' from the archive as an array of 'T', each made up of 'ElemsPerItem'
+ * elements. If the reader can keep its memory alive the array references it directly, otherwise it is copied
+ * once into uninitialized storage.
+ * \return Whether the node contained an array.
+ */
+template <size_t ElemsPerItem, typename ElemT, typename T>
+static bool read_array(ArchiveReader& reader, StaticMesh::Array<T>& out) {
+  static_assert(sizeof(T) == sizeof(ElemT) * ElemsPerItem, "Array item must be made up of its elements");
+  out = StaticMesh::Array<T>{};
+
+  size_t num_elems = 0;
+  if (!reader.array_size(num_elems)) {
+    return false;
+  }
+
+  const size_t size = num_elems / ElemsPerItem;
+  if (size == 0) {
+    return true;
+  }
+
+  // Adopt the archive's memory if possible
+  const ElemT* view = nullptr;
+  size_t view_size = 0;
+  const bool has_view = reader.typed_array_view(view, view_size) && view_size == num_elems;
+  if (has_view) {
+    auto owner = reader.view_owner();
+    if (owner) {
+      out.data = std::shared_ptr<const T>(std::move(owner), reinterpret_cast<const T*>(view));
+      out.size = size;
+      return true;
+    }
+  }
+
+  // Otherwise copy it
+  std::shared_ptr<uint8_t[]> storage{new uint8_t[size * sizeof(T)]};
+  auto* const elems = reinterpret_cast<ElemT*>(storage.get());
+  if (has_view) {
+    memcpy(elems, view, size * sizeof(T));
+  } else {
+    const auto read_size = reader.typed_array(elems, size * ElemsPerItem);
+    assert(read_size == size * ElemsPerItem);
+    (void)read_size;
+  }
+
+  out.data = std::shared_ptr<const T>(std::move(storage), reinterpret_cast<const T*>(elems));
+  out.size = size;
+  return true;
+}
+
+void StaticMesh::Lod::to_archive(ArchiveWriter& writer) const {
+  writer.object_member("err", error);
+
+  writer.push_object_member("elem");
+  writer.typed_array(triangle_elements.data.get(), triangle_elements.size);
+  writer.pop();
+
+  writer.push_object_member("rngs");
+  writer.typed_array(material_ranges.data.get(), material_ranges.size);
+  writer.pop();
+}
+
+void StaticMesh::Lod::from_archive(ArchiveReader& reader) {
+  error = 0.f;
+  triangle_elements = {};
+  material_ranges = {};
+
+  reader.enumerate_object_members([this, &reader](const char* mem_name) {
+    if (strcmp(mem_name, "err") == 0) {
+      reader.number(this->error);
+    } else if (strcmp(mem_name, "elem") == 0) {
+      const auto got_array = read_array<1, uint32_t>(reader, this->triangle_elements);
+      assert(got_array);
+      (void)got_array;
+    } else if (strcmp(mem_name, "rngs") == 0) {
+      const auto got_array = read_array<1, uint32_t>(reader, this->material_ranges);
+      assert(got_array);
+      (void)got_array;
+    }
+  });
+}
+
+static_assert(sizeof(StaticMesh::ClusterBounds) == sizeof(float) * 8, "Cluster bounds must be 8 floats");
+
+static_assert(sizeof(StaticMesh::InterleavedVertex) == 32, "Interleaved vertices must be 32 bytes");
+
+/* Converts a normalized 16-bit vector to a signed normalized 10:10:10:2 integer. */
+static uint32_t pack_snorm_10_10_10(const HalfVec3& vec) {
+  uint32_t result = 0;
+  for (int i = 0; i < 3; ++i) {
+    const auto value = (int32_t)lround(vec.vec()[i] * 511.0 / INT16_MAX);
+    result |= ((uint32_t)std::clamp(value, -511, 511) & 0x3FF) << (i * 10);
+  }
+
+  return result;
+}
+
+/* Creates a copy of the given per-vertex array with its items moved to their new indices. Arrays that
+ * aren't per-vertex (such as missing lightmap UVs) are left as they are. */
+template <typename T>
+static StaticMesh::Array<T>
+remap_array(const StaticMesh::Array<T>& array, const uint32_t* remap, size_t num_verts) {
+  if (array.size != num_verts) {
+    return array;
+  }
+
+  std::vector<T> items(num_verts);
+  for (size_t i = 0; i < num_verts; ++i) {
+    items[remap[i]] = array.data.get()[i];
+  }
+
+  return StaticMesh::Array<T>::from_vector(std::move(items));
+}
+
+/* Returns a copy of the given elements, referencing the new indices of their vertices. */
+static std::vector<uint32_t>
+remap_elements(const StaticMesh::Array<uint32_t>& elements, const uint32_t* remap) {
+  std::vector<uint32_t> result(elements.size);
+  for (size_t i = 0; i < result.size(); ++i) {
+    result[i] = remap[elements.data.get()[i]];
+  }
+
+  return result;
+}
+
 StaticMesh::StaticMesh() = default;
 
 void StaticMesh::to_archive(ArchiveWriter& writer) const {
   // Write vertex positions
   writer.push_object_member("vpos");
-  writer.typed_array(_vertex_positions.data()->vec(), _vertex_positions.size() * 3);
+  writer.typed_array(
+      reinterpret_cast<const float*>(_vertex_positions.data.get()),
+      _vertex_positions.size * 3
+  );
   writer.pop();
 
   // Write vertex normals
   writer.push_object_member("vnor");
-  writer.typed_array(_vertex_normals.data()->vec(), _vertex_normals.size() * 3);
+  writer.typed_array(reinterpret_cast<const int16_t*>(_vertex_normals.data.get()), _vertex_normals.size * 3);
   writer.pop();
 
   // Write vertex tangents
   writer.push_object_member("vtan");
-  writer.typed_array(_vertex_tangents.data()->vec(), _vertex_tangents.size() * 3);
+  writer.typed_array(
+      reinterpret_cast<const int16_t*>(_vertex_tangents.data.get()),
+      _vertex_tangents.size * 3
+  );
   writer.pop();
 
   // Write bitangent signs
   writer.push_object_member("vbts");
-  writer.typed_array(_bitangent_signs.data(), _bitangent_signs.size());
+  writer.typed_array(_bitangent_signs.data.get(), _bitangent_signs.size);
   writer.pop();
 
   // Write the material UV layer
   writer.push_object_member("mtuv");
-  writer.typed_array(_material_uv.data()->vec(), _material_uv.size() * 2);
+  writer.typed_array(reinterpret_cast<const uint16_t*>(_material_uv.data.get()), _material_uv.size * 2);
   writer.pop();
 
   // Write lightmap UV layer
-  if (!_lightmap_uv.empty()) {
+  if (_lightmap_uv.size != 0) {
     writer.push_object_member("lmuv");
-    writer.typed_array(_lightmap_uv.data()->vec(), _lightmap_uv.size() * 2);
+    writer.typed_array(reinterpret_cast<const uint16_t*>(_lightmap_uv.data.get()), _lightmap_uv.size * 2);
     writer.pop();
   }
 
   // Write triangle elements
   writer.push_object_member("elem");
-  writer.typed_array(_triangle_elements.data(), _triangle_elements.size());
+  writer.typed_array(_triangle_elements.data.get(), _triangle_elements.size);
   writer.pop();
 
   // Write materials
@@ -95,96 +230,82 @@ void StaticMesh::to_archive(ArchiveWriter& writer) const {
     writer.pop();
   }
   writer.pop();
+
+  // Write clusters
+  if (_cluster_ranges.size != 0) {
+    writer.push_object_member("clrg");
+    writer.typed_array(
+        reinterpret_cast<const uint32_t*>(_cluster_ranges.data.get()),
+        _cluster_ranges.size * 2
+    );
+    writer.pop();
+
+    writer.push_object_member("clbd");
+    writer.typed_array(reinterpret_cast<const float*>(_cluster_bounds.data.get()), _cluster_bounds.size * 8);
+    writer.pop();
+  }
+
+  // Write LODs
+  if (!_lods.empty()) {
+    writer.push_object_member("lods");
+    for (const auto& lod : _lods) {
+      writer.push_array_element();
+      lod.to_archive(writer);
+      writer.pop();
+    }
+    writer.pop();
+  }
 }
 
 void StaticMesh::from_archive(ArchiveReader& reader) {
-  _vertex_positions.clear();
-  _vertex_normals.clear();
-  _vertex_tangents.clear();
-  _bitangent_signs.clear();
-  _material_uv.clear();
-  _lightmap_uv.clear();
-  _triangle_elements.clear();
+  _vertex_positions = {};
+  _vertex_normals = {};
+  _vertex_tangents = {};
+  _bitangent_signs = {};
+  _material_uv = {};
+  _lightmap_uv = {};
+  _triangle_elements = {};
   _materials.clear();
+  _lods.clear();
+  _cluster_ranges = {};
+  _cluster_bounds = {};
 
   size_t num_verts = 0;
   reader.enumerate_object_members([this, &reader, &num_verts](const char* mem_name) {
     if (strcmp(mem_name, "vpos") == 0) {
-      // Get vertex positions array size
-      size_t size = 0;
-      const auto got_size = reader.array_size(size);
-      assert((got_size && num_verts == 0) || num_verts == size / 3);
-      num_verts = size / 3;
-
-      // Get vertex positions array
-      this->_vertex_positions.assign(size / 3, Vec3::zero());
-      const auto read_size = reader.typed_array(this->_vertex_positions.data()->vec(), size);
-      assert(read_size == size);
+      // Get vertex positions
+      const auto got_array = read_array<3, float>(reader, this->_vertex_positions);
+      assert(got_array && (num_verts == 0 || num_verts == this->_vertex_positions.size));
+      num_verts = this->_vertex_positions.size;
     } else if (strcmp(mem_name, "vnor") == 0) {
-      // Get vertex normals array size
-      size_t size = 0;
-      const auto got_size = reader.array_size(size);
-      assert((got_size && num_verts == 0) || num_verts == size / 3);
-      num_verts = size / 3;
-
-      // Get vertex normals array
-      this->_vertex_normals.assign(size / 3, HalfVec3::zero());
-      const auto read_size = reader.typed_array(this->_vertex_normals.data()->vec(), size);
-      assert(read_size == size);
+      // Get vertex normals
+      const auto got_array = read_array<3, int16_t>(reader, this->_vertex_normals);
+      assert(got_array && (num_verts == 0 || num_verts == this->_vertex_normals.size));
+      num_verts = this->_vertex_normals.size;
     } else if (strcmp(mem_name, "vtan") == 0) {
-      // Get vertex tangents array size
-      size_t size = 0;
-      const auto got_size = reader.array_size(size);
-      assert((got_size && num_verts == 0) || size == num_verts * 3);
-      num_verts = size / 3;
-
       // Get vertex tangents
-      this->_vertex_tangents.assign(size / 3, HalfVec3::zero());
-      const auto read_size = reader.typed_array(this->_vertex_tangents.data()->vec(), size);
-      assert(read_size == size);
+      const auto got_array = read_array<3, int16_t>(reader, this->_vertex_tangents);
+      assert(got_array && (num_verts == 0 || num_verts == this->_vertex_tangents.size));
+      num_verts = this->_vertex_tangents.size;
     } else if (strcmp(mem_name, "vbts") == 0) {
-      // Get vertex bitangent signs array size
-      size_t size = 0;
-      const bool got_size = reader.array_size(size);
-      assert((got_size && num_verts == 0) || size == num_verts);
-      num_verts = size;
-
       // Get vertex bitangent signs
-      this->_bitangent_signs.assign(size, 0);
-      const auto read_size = reader.typed_array(this->_bitangent_signs.data(), size);
-      assert(read_size == size);
+      const auto got_array = read_array<1, int8_t>(reader, this->_bitangent_signs);
+      assert(got_array && (num_verts == 0 || num_verts == this->_bitangent_signs.size));
+      num_verts = this->_bitangent_signs.size;
     } else if (strcmp(mem_name, "mtuv") == 0) {
-      // Get uv array size
-      size_t size = 0;
-      const auto got_size = reader.array_size(size);
-      assert((got_size && num_verts == 0) || size == num_verts * 2);
-      num_verts = size / 2;
-
       // Get uvs
-      this->_material_uv.assign(size / 2, UHalfVec2::zero());
-      const auto read_size = reader.typed_array(this->_material_uv.data()->vec(), size);
-      assert(read_size == size);
+      const auto got_array = read_array<2, uint16_t>(reader, this->_material_uv);
+      assert(got_array && (num_verts == 0 || num_verts == this->_material_uv.size));
+      num_verts = this->_material_uv.size;
     } else if (strcmp(mem_name, "lmuv") == 0) {
-      // Get uv array size
-      size_t size = 0;
-      const auto got_size = reader.array_size(size);
-      assert((got_size && num_verts == 0) || size == num_verts * 2);
-      num_verts = size / 2;
-
       // Get uvs
-      this->_lightmap_uv.assign(size / 2, UHalfVec2::zero());
-      const auto read_size = reader.typed_array(this->_lightmap_uv.data()->vec(), size);
-      assert(read_size == size);
+      const auto got_array = read_array<2, uint16_t>(reader, this->_lightmap_uv);
+      assert(got_array && (num_verts == 0 || num_verts == this->_lightmap_uv.size));
+      num_verts = this->_lightmap_uv.size;
     } else if (strcmp(mem_name, "elem") == 0) {
-      // Get element array size
-      size_t size = 0;
-      const auto got_size = reader.array_size(size);
-      assert(got_size);
-
       // Get elements
-      this->_triangle_elements.assign(size, 0);
-      const auto read_size = reader.typed_array(this->_triangle_elements.data(), size);
-      assert(read_size == size);
+      const auto got_array = read_array<1, uint32_t>(reader, this->_triangle_elements);
+      assert(got_array);
     } else if (strcmp(mem_name, "mats") == 0) {
       // Get array size
       size_t size = 0;
@@ -200,88 +321,79 @@ void StaticMesh::from_archive(ArchiveReader& reader) {
         mat.from_archive(reader);
         this->_materials.push_back(std::move(mat));
       });
+    } else if (strcmp(mem_name, "clrg") == 0) {
+      // Get cluster ranges
+      const auto got_array = read_array<2, uint32_t>(reader, this->_cluster_ranges);
+      assert(got_array);
+    } else if (strcmp(mem_name, "clbd") == 0) {
+      // Get cluster bounds
+      const auto got_array = read_array<8, float>(reader, this->_cluster_bounds);
+      assert(got_array);
+    } else if (strcmp(mem_name, "lods") == 0) {
+      // Deserialize LODs
+      reader.enumerate_array_elements([this, &reader](size_t /*i*/) {
+        Lod lod;
+        lod.from_archive(reader);
+        this->_lods.push_back(std::move(lod));
+      });
     }
   });
 }
 
 bool StaticMesh::from_file(const char* path) {
-  BinaryArchive bin;
-  if (!bin.from_file(path)) {
+  // Read straight out of the mapped file, so large meshes aren't held in memory twice while loading
+  auto* reader = BinaryArchive::read_mapped_file(path);
+  if (!reader) {
     return false;
   }
 
-  auto* reader = bin.read_root();
   from_archive(*reader);
   reader->pop();
   return true;
 }
 
 size_t StaticMesh::num_verts() const {
-  return _vertex_positions.size();
+  return _vertex_positions.size;
 }
 
 const Vec3* StaticMesh::vertex_positions() const {
-  if (_vertex_positions.empty()) {
-    return nullptr;
-  }
-
-  return _vertex_positions.data();
+  return _vertex_positions.data.get();
 }
 
 const HalfVec3* StaticMesh::vertex_normals() const {
-  if (_vertex_normals.empty()) {
-    return nullptr;
-  }
-
-  return _vertex_normals.data();
+  return _vertex_normals.data.get();
 }
 
 const HalfVec3* StaticMesh::vertex_tangents() const {
-  if (_vertex_tangents.empty()) {
-    return nullptr;
-  }
-
-  return _vertex_tangents.data();
+  return _vertex_tangents.data.get();
 }
 
 const int8_t* StaticMesh::bitangent_signs() const {
-  if (_bitangent_signs.empty()) {
-    return nullptr;
-  }
-
-  return _bitangent_signs.data();
+  return _bitangent_signs.data.get();
 }
 
 const UHalfVec2* StaticMesh::material_uv() const {
-  if (_material_uv.empty()) {
-    return nullptr;
-  }
-
-  return _material_uv.data();
+  return _material_uv.data.get();
 }
 
 const UHalfVec2* StaticMesh::lightmap_uv() const {
-  if (_lightmap_uv.empty()) {
+  if (!_lightmap_uv.data) {
     return material_uv();
   }
 
-  return _lightmap_uv.data();
+  return _lightmap_uv.data.get();
 }
 
 size_t StaticMesh::num_triangles() const {
-  return _triangle_elements.size() / 3;
+  return _triangle_elements.size / 3;
 }
 
 size_t StaticMesh::num_triangle_elements() const {
-  return _triangle_elements.size();
+  return _triangle_elements.size;
 }
 
 const uint32_t* StaticMesh::triangle_elements() const {
-  if (_triangle_elements.empty()) {
-    return nullptr;
-  }
-
-  return _triangle_elements.data();
+  return _triangle_elements.data.get();
 }
 
 size_t StaticMesh::num_materials() const {
@@ -291,4 +403,107 @@ size_t StaticMesh::num_materials() const {
 const StaticMesh::Material* StaticMesh::materials() const {
   return _materials.data();
 }
+
+size_t StaticMesh::num_lods() const {
+  return _lods.size();
+}
+
+const StaticMesh::Lod* StaticMesh::lods() const {
+  return _lods.data();
+}
+
+size_t StaticMesh::num_clusters() const {
+  return std::min(_cluster_ranges.size, _cluster_bounds.size);
+}
+
+const StaticMesh::ClusterRange* StaticMesh::cluster_ranges() const {
+  return _cluster_ranges.data.get();
+}
+
+const StaticMesh::ClusterBounds* StaticMesh::cluster_bounds() const {
+  return _cluster_bounds.data.get();
+}
+
+void StaticMesh::bounding_sphere(Vec3& out_center, float& out_radius) const {
+  out_center = Vec3::zero();
+  out_radius = 0.f;
+  const auto* const positions = vertex_positions();
+  if (num_verts() == 0) {
+    return;
+  }
+
+  auto min = positions[0];
+  auto max = positions[0];
+  for (size_t i = 1; i < num_verts(); ++i) {
+    const auto& pos = positions[i];
+    min = Vec3{std::min(min.x(), pos.x()), std::min(min.y(), pos.y()), std::min(min.z(), pos.z())};
+    max = Vec3{std::max(max.x(), pos.x()), std::max(max.y(), pos.y()), std::max(max.z(), pos.z())};
+  }
+
+  out_center = (min + max) / 2.f;
+  for (size_t i = 0; i < num_verts(); ++i) {
+    out_radius = std::max(out_radius, (positions[i] - out_center).length());
+  }
+}
+
+void StaticMesh::set_triangle_elements(std::vector<uint32_t> elements) {
+  _triangle_elements = Array<uint32_t>::from_vector(std::move(elements));
+  _cluster_ranges = {};
+  _cluster_bounds = {};
+}
+
+void StaticMesh::remap_vertices(const uint32_t* remap) {
+  const auto num_verts = this->num_verts();
+  _vertex_positions = remap_array(_vertex_positions, remap, num_verts);
+  _vertex_normals = remap_array(_vertex_normals, remap, num_verts);
+  _vertex_tangents = remap_array(_vertex_tangents, remap, num_verts);
+  _bitangent_signs = remap_array(_bitangent_signs, remap, num_verts);
+  _material_uv = remap_array(_material_uv, remap, num_verts);
+  _lightmap_uv = remap_array(_lightmap_uv, remap, num_verts);
+
+  // Clusters keep the same triangles, so they're still valid
+  _triangle_elements = Array<uint32_t>::from_vector(remap_elements(_triangle_elements, remap));
+  for (auto& lod : _lods) {
+    lod.triangle_elements = Array<uint32_t>::from_vector(remap_elements(lod.triangle_elements, remap));
+  }
+}
+
+void StaticMesh::set_lods(std::vector<Lod> lods) {
+  _lods = std::move(lods);
+}
+
+void StaticMesh::set_clusters(std::vector<ClusterRange> ranges, std::vector<ClusterBounds> bounds) {
+  assert(ranges.size() == bounds.size());
+  _cluster_ranges = Array<ClusterRange>::from_vector(std::move(ranges));
+  _cluster_bounds = Array<ClusterBounds>::from_vector(std::move(bounds));
+}
+
+void StaticMesh::interleave_vertices(InterleavedVertex* out_vertices) const {
+  const auto* const normals = vertex_normals();
+  const auto* const tangents = vertex_tangents();
+  const auto* const signs = bitangent_signs();
+  const auto* const mat_uv = material_uv();
+  const auto* const lm_uv = lightmap_uv();
+  for (size_t i = 0; i < num_verts(); ++i) {
+    // Attributes missing from the mesh are left zeroed
+    auto& vertex = out_vertices[i];
+    vertex = InterleavedVertex{};
+    vertex.position = _vertex_positions.data.get()[i];
+    if (normals) {
+      vertex.normal = pack_snorm_10_10_10(normals[i]);
+    }
+    if (tangents) {
+      vertex.tangent = pack_snorm_10_10_10(tangents[i]);
+    }
+    if (signs) {
+      vertex.bitangent_sign = signs[i];
+    }
+    if (mat_uv) {
+      vertex.material_uv = mat_uv[i];
+    }
+    if (lm_uv) {
+      vertex.lightmap_uv = lm_uv[i];
+    }
+  }
+}
 }  // namespace sge
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <memory>
 #include <vector>
 
 #include "lib/base/containers/fixed_string.h"
@@ -29,6 +30,80 @@ struct SGE_RESOURCE_API StaticMesh {
     uint32_t _num_elem_indices = 0;
   };
 
+  /* Mesh data arrays may reference the memory of the archive they were loaded from (kept alive through the
+   * archive reader's 'view_owner'), or their own copy of it. Either way, the data is immutable, and is only
+   * ever replaced as a whole. */
+  template <typename T>
+  struct Array {
+    /* Creates an array that owns the given items. */
+    static Array from_vector(std::vector<T> items) {
+      auto storage = std::make_shared<std::vector<T>>(std::move(items));
+      Array result;
+      result.size = storage->size();
+      result.data = std::shared_ptr<const T>(storage, storage->data());
+      return result;
+    }
+
+    std::shared_ptr<const T> data;
+    size_t size = 0;
+  };
+
+  /**
+   * \brief A simplified version of the mesh's triangles, drawn in place of them further away. LODs reference
+   * the same vertices as the full mesh, and have the same materials.
+   */
+  struct SGE_RESOURCE_API Lod {
+    void to_archive(ArchiveWriter& writer) const;
+
+    void from_archive(ArchiveReader& reader);
+
+    /* How far the surface of the LOD may be from that of the full mesh, relative to the mesh's bounding
+     * radius. */
+    float error = 0.f;
+
+    Array<uint32_t> triangle_elements;
+
+    /* The start and number of elements of each material, in the same order as the mesh's materials. */
+    Array<uint32_t> material_ranges;
+  };
+
+  /**
+   * \brief A range of the mesh's elements making up a small cluster of neighbouring triangles, within a
+   * single material range.
+   */
+  struct ClusterRange {
+    uint32_t start_elem_index;
+    uint32_t num_elem_indices;
+  };
+
+  /**
+   * \brief Bounds of a cluster that it may be culled against. The normals of its triangles are all within the
+   * cone around 'cone_axis', such that the whole cluster faces away from any point 'p' where
+   * 'dot(center - p, cone_axis) >= cone_cutoff * length(center - p) + radius'. A cutoff of one means the
+   * cluster may never be culled this way.
+   */
+  struct ClusterBounds {
+    Vec3 center;
+    float radius;
+    Vec3 cone_axis;
+    float cone_cutoff;
+  };
+
+  /**
+   * \brief Every attribute of a vertex packed into a single 32-byte struct, so that a mesh's vertices may be
+   * uploaded to the GPU as one interleaved buffer. The normal and tangent are signed normalized 10:10:10:2
+   * integers (with the 2-bit component unused), as consumed by 'GL_INT_2_10_10_10_REV'.
+   */
+  struct InterleavedVertex {
+    Vec3 position;
+    uint32_t normal;
+    uint32_t tangent;
+    UHalfVec2 material_uv;
+    UHalfVec2 lightmap_uv;
+    int8_t bitangent_sign;
+    uint8_t padding[3];
+  };
+
   StaticMesh();
 
   void to_archive(ArchiveWriter& writer) const;
@@ -61,14 +136,65 @@ struct SGE_RESOURCE_API StaticMesh {
 
   const Material* materials() const;
 
+  /* LODs of the mesh, from most to least detailed, not including the full mesh. */
+  size_t num_lods() const;
+
+  const Lod* lods() const;
+
+  /* Clusters of the full mesh's triangles, in the order of their elements. Most meshes have none. */
+  size_t num_clusters() const;
+
+  const ClusterRange* cluster_ranges() const;
+
+  const ClusterBounds* cluster_bounds() const;
+
+  /**
+   * \brief Computes a sphere enclosing every vertex, centered on their bounding box.
+   */
+  void bounding_sphere(Vec3& out_center, float& out_radius) const;
+
+  /**
+   * \brief Packs the attributes of every vertex into the interleaved format.
+   * \param out_vertices Array of 'num_verts()' vertices to fill in.
+   */
+  void interleave_vertices(InterleavedVertex* out_vertices) const;
+
+  /**
+   * \brief Replaces the triangle elements. Material ranges are left as they are, so each range must still
+   * cover the same triangles, in any order. Clusters are removed, as they may not.
+   */
+  void set_triangle_elements(std::vector<uint32_t> elements);
+
+  /**
+   * \brief Reorders the vertices, moving each attribute of vertex 'i' to 'remap[i]', and updates the triangle
+   * elements (and those of each LOD) to match.
+   * \param remap Array of 'num_verts()' new vertex indices, which must be a permutation.
+   */
+  void remap_vertices(const uint32_t* remap);
+
+  /**
+   * \brief Replaces the LODs of the mesh.
+   */
+  void set_lods(std::vector<Lod> lods);
+
+  /**
+   * \brief Replaces the clusters of the mesh.
+   * \param ranges The elements of each cluster.
+   * \param bounds The bounds of each cluster, symmetrical with 'ranges'.
+   */
+  void set_clusters(std::vector<ClusterRange> ranges, std::vector<ClusterBounds> bounds);
+
  private:
-  std::vector<Vec3> _vertex_positions;
-  std::vector<HalfVec3> _vertex_normals;
-  std::vector<HalfVec3> _vertex_tangents;
-  std::vector<int8_t> _bitangent_signs;
-  std::vector<UHalfVec2> _material_uv;
-  std::vector<UHalfVec2> _lightmap_uv;
-  std::vector<uint32_t> _triangle_elements;
+  Array<Vec3> _vertex_positions;
+  Array<HalfVec3> _vertex_normals;
+  Array<HalfVec3> _vertex_tangents;
+  Array<int8_t> _bitangent_signs;
+  Array<UHalfVec2> _material_uv;
+  Array<UHalfVec2> _lightmap_uv;
+  Array<uint32_t> _triangle_elements;
   std::vector<Material> _materials;
+  std::vector<Lod> _lods;
+  Array<ClusterRange> _cluster_ranges;
+  Array<ClusterBounds> _cluster_bounds;
 };
 }  // namespace sge
@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#include "lib/base/util/hash_utils.h"
+#include "lib/resource/archives/mapped_file.h"
+#include "lib/resource/sources/pak_file.h"
+
+namespace sge {
+std::shared_ptr<const PakSource> PakSource::open_file(const char* path) {
+  auto file = std::make_shared<MappedFile>();
+  if (!file->open(path, false)) {
+    return nullptr;
+  }
+
+  // Make sure the index and path table lie within the file
+  PakHeader header;
+  if (file->size() < sizeof(PakHeader)) {
+    return nullptr;
+  }
+
+  memcpy(&header, file->data(), sizeof(PakHeader));
+  if (memcmp(header.magic, PAK_MAGIC, sizeof(header.magic)) != 0 || header.version != PAK_VERSION ||
+      header.index_offset % alignof(PakEntry) != 0 || header.index_offset > file->size() ||
+      header.num_entries > (file->size() - header.index_offset) / sizeof(PakEntry) ||
+      header.paths_offset > file->size()) {
+    return nullptr;
+  }
+
+  auto source = std::make_shared<PakSource>();
+  source->_entries = reinterpret_cast<const PakEntry*>(file->data() + header.index_offset);
+  source->_num_entries = header.num_entries;
+  source->_paths = reinterpret_cast<const char*>(file->data() + header.paths_offset);
+  source->_paths_size = file->size() - header.paths_offset;
+  source->_file = std::move(file);
+  return source;
+}
+
+bool PakSource::open(const char* path, bool /*sequential*/, ResourceData& out_data) const {
+  const auto path_size = strlen(path);
+  const auto path_hash = hash_bytes(HASH_BYTES_SEED, path, path_size);
+
+  // Find the entries with the same hash, and then the one with the same path
+  const auto* const end = _entries + _num_entries;
+  const auto* iter = std::lower_bound(_entries, end, path_hash, [](const PakEntry& entry, uint64_t hash) {
+    return entry.path_hash < hash;
+  });
+  for (; iter != end && iter->path_hash == path_hash; ++iter) {
+    if (iter->path_size != path_size || path_size > _paths_size ||
+        iter->path_offset > _paths_size - path_size ||
+        memcmp(_paths + iter->path_offset, path, path_size) != 0) {
+      continue;
+    }
+
+    if (iter->offset > _file->size() || iter->size > _file->size() - iter->offset) {
+      return false;
+    }
+
+    out_data.data = _file->data() + iter->offset;
+    out_data.size = (size_t)iter->size;
+    out_data.owner = _file;
+    return true;
+  }
+
+  return false;
+}
+
+bool write_pak_file(
+    const char* pak_path,
+    const std::vector<std::string>& resource_paths,
+    const std::vector<std::string>& source_dirs
+) {
+  // Sort the resources the way the index is searched, without duplicates
+  std::vector<std::pair<uint64_t, const std::string*>> resources;
+  resources.reserve(resource_paths.size());
+  for (const auto& path : resource_paths) {
+    if (path.size() > UINT16_MAX) {
+      return false;
+    }
+
+    resources.emplace_back(hash_bytes(HASH_BYTES_SEED, path.data(), path.size()), &path);
+  }
+
+  std::sort(resources.begin(), resources.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first < rhs.first || (lhs.first == rhs.first && *lhs.second < *rhs.second);
+  });
+  resources.erase(
+      std::unique(
+          resources.begin(),
+          resources.end(),
+          [](const auto& lhs, const auto& rhs) { return *lhs.second == *rhs.second; }
+      ),
+      resources.end()
+  );
+
+  auto* const file = fopen(pak_path, "wb");
+  if (!file) {
+    return false;
+  }
+
+  // Leave room for the header, which is written once the offsets are known
+  PakHeader header;
+  memset(&header, 0, sizeof(PakHeader));
+  bool succeeded = fwrite(&header, sizeof(PakHeader), 1, file) == 1;
+  uint64_t offset = sizeof(PakHeader);
+
+  const uint8_t padding[PAK_ALIGNMENT] = {};
+  const auto write_padding = [file, &padding, &offset, &succeeded]() {
+    const auto padding_size = (PAK_ALIGNMENT - offset % PAK_ALIGNMENT) % PAK_ALIGNMENT;
+    succeeded &= fwrite(padding, 1, padding_size, file) == padding_size;
+    offset += padding_size;
+  };
+
+  // Write the contents of each resource
+  std::vector<PakEntry> entries(resources.size());
+  std::string paths;
+  const LooseFileSource loose_files;
+  for (size_t i = 0; i < resources.size() && succeeded; ++i) {
+    const auto& path = *resources[i].second;
+    ResourceData data;
+    bool found = source_dirs.empty() && loose_files.open(path.c_str(), true, data);
+    for (size_t d = 0; d < source_dirs.size() && !found; ++d) {
+      found = loose_files.open((source_dirs[d] + "/" + path).c_str(), true, data);
+    }
+    if (!found) {
+      succeeded = false;
+      break;
+    }
+
+    write_padding();
+    auto& entry = entries[i];
+    entry.path_hash = resources[i].first;
+    entry.offset = offset;
+    entry.size = data.size;
+    entry.path_offset = (uint32_t)paths.size();
+    entry.path_size = (uint16_t)path.size();
+    entry.flags = 0;
+    paths += path;
+
+    succeeded &= fwrite(data.data, 1, data.size, file) == data.size;
+    offset += data.size;
+  }
+
+  // Write the index and the path table
+  write_padding();
+  header.index_offset = offset;
+  succeeded &= fwrite(entries.data(), sizeof(PakEntry), entries.size(), file) == entries.size();
+  offset += entries.size() * sizeof(PakEntry);
+
+  header.paths_offset = offset;
+  succeeded &= fwrite(paths.data(), 1, paths.size(), file) == paths.size();
+
+  // Fill in the header
+  memcpy(header.magic, PAK_MAGIC, sizeof(header.magic));
+  header.version = PAK_VERSION;
+  header.num_entries = (uint32_t)entries.size();
+  succeeded &= fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(PakHeader), 1, file) == 1;
+
+  // Don't leave a partial pak behind
+  succeeded &= fclose(file) == 0;
+  if (!succeeded) {
+    remove(pak_path);
+  }
+
+  return succeeded;
+}
+}  // namespace sge
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lib/resource/sources/resource_source.h"
+
+namespace sge {
+struct MappedFile;
+
+static constexpr uint8_t PAK_MAGIC[4] = {'S', 'G', 'E', 'P'};
+
+/* Incremented whenever the layout of pak files changes. */
+static constexpr uint32_t PAK_VERSION = 1;
+
+/* Alignment of each resource's contents within a pak, so that they may be used in place. Binary archives need
+ * 8 bytes, and precooked BVHs need 16, but resources are aligned to cache lines to be safe. */
+static constexpr size_t PAK_ALIGNMENT = 64;
+
+/* Header at the start of a pak file. The contents of each resource follow, and then the index and the paths
+ * of the resources it refers to. */
+struct PakHeader {
+  uint8_t magic[4];
+  uint32_t version;
+  uint32_t num_entries;
+  uint32_t reserved;
+
+  /* Offset of the index from the start of the file. */
+  uint64_t index_offset;
+
+  /* Offset of the path table from the start of the file. */
+  uint64_t paths_offset;
+};
+static_assert(sizeof(PakHeader) == 32, "Pak headers must not contain padding");
+
+/* An entry in the index of a pak file. Entries are sorted by path hash, and then by path. */
+struct PakEntry {
+  /* Hash of the resource's path, with 'hash_bytes'. */
+  uint64_t path_hash;
+
+  /* Offset and size of the resource's contents, from the start of the file. */
+  uint64_t offset;
+  uint64_t size;
+
+  /* Offset and size of the resource's path within the path table. */
+  uint32_t path_offset;
+  uint16_t path_size;
+
+  /* Reserved for describing how the contents are stored. Currently always zero, meaning they're stored as
+   * is. */
+  uint16_t flags;
+};
+static_assert(sizeof(PakEntry) == 32, "Pak index entries must not contain padding");
+
+/**
+ * \brief Reads resources out of a memory-mapped pak file. Resources opened from it share the mapping, which
+ * stays open for as long as any of them do.
+ */
+struct SGE_RESOURCE_API PakSource final : ResourceSource {
+  /**
+   * \brief Maps the given pak file.
+   * \return The source, or null if the file could not be mapped or isn't a valid pak.
+   */
+  static std::shared_ptr<const PakSource> open_file(const char* path);
+
+  bool open(const char* path, bool sequential, ResourceData& out_data) const override;
+
+  size_t num_entries() const { return _num_entries; }
+
+ private:
+  std::shared_ptr<const MappedFile> _file;
+  const PakEntry* _entries = nullptr;
+  size_t _num_entries = 0;
+  const char* _paths = nullptr;
+  size_t _paths_size = 0;
+};
+
+/**
+ * \brief Writes a pak file containing the given resources, reading each from its loose file.
+ * \param pak_path The path of the pak file to write.
+ * \param resource_paths The paths of the resources to write. Each is stored under the same path.
+ * \param source_dirs Directories to read each resource from, by its path relative to them, with earlier
+ * directories taking priority. This allows cooked output to be packed in place of the original. If empty,
+ * each resource is read from its path as is.
+ * \return Whether every resource was read and the pak was written.
+ */
+SGE_RESOURCE_API bool write_pak_file(
+    const char* pak_path,
+    const std::vector<std::string>& resource_paths,
+    const std::vector<std::string>& source_dirs = {}
+);
+}  // namespace sge
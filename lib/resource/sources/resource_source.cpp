@@ -0,0 +1,53 @@
+#include <mutex>
+#include <vector>
+
+#include "lib/resource/archives/mapped_file.h"
+#include "lib/resource/sources/resource_source.h"
+
+namespace sge {
+static std::mutex mounted_sources_mutex;
+
+/* Mounted sources, from the most to the least recently mounted. */
+static std::vector<std::shared_ptr<const ResourceSource>> mounted_sources;
+
+ResourceSource::~ResourceSource() = default;
+
+bool LooseFileSource::open(const char* path, bool sequential, ResourceData& out_data) const {
+  auto mapping = std::make_shared<MappedFile>();
+  if (!mapping->open(path, sequential)) {
+    return false;
+  }
+
+  out_data.data = mapping->data();
+  out_data.size = mapping->size();
+  out_data.owner = std::move(mapping);
+  return true;
+}
+
+void mount_resource_source(std::shared_ptr<const ResourceSource> source) {
+  std::lock_guard<std::mutex> lock{mounted_sources_mutex};
+  mounted_sources.insert(mounted_sources.begin(), std::move(source));
+}
+
+void unmount_resource_sources() {
+  std::lock_guard<std::mutex> lock{mounted_sources_mutex};
+  mounted_sources.clear();
+}
+
+bool open_resource(const char* path, bool sequential, ResourceData& out_data) {
+  // Copy the sources, so that nothing is opened while holding the lock
+  std::vector<std::shared_ptr<const ResourceSource>> sources;
+  {
+    std::lock_guard<std::mutex> lock{mounted_sources_mutex};
+    sources = mounted_sources;
+  }
+
+  for (const auto& source : sources) {
+    if (source->open(path, sequential, out_data)) {
+      return true;
+    }
+  }
+
+  return LooseFileSource{}.open(path, sequential, out_data);
+}
+}  // namespace sge
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+
+#include "lib/resource/build.h"
+
+namespace sge {
+/**
+ * \brief The contents of a resource, which remain valid for as long as 'owner' is kept alive.
+ */
+struct ResourceData {
+  const uint8_t* data = nullptr;
+  size_t size = 0;
+  std::shared_ptr<const void> owner;
+};
+
+/**
+ * \brief Somewhere resources may be read from, by path.
+ */
+struct SGE_RESOURCE_API ResourceSource {
+  virtual ~ResourceSource();
+
+  /**
+   * \brief Opens the resource at the given path. This may be called from any thread.
+   * \param path The path of the resource, as it is referenced by other resources.
+   * \param sequential Whether the resource will be read front-to-back, as a hint to the OS.
+   * \param out_data Set to the contents of the resource.
+   * \return Whether this source has the resource.
+   */
+  virtual bool open(const char* path, bool sequential, ResourceData& out_data) const = 0;
+};
+
+/**
+ * \brief Reads each resource by memory-mapping the file at its path.
+ */
+struct SGE_RESOURCE_API LooseFileSource final : ResourceSource {
+  bool open(const char* path, bool sequential, ResourceData& out_data) const override;
+};
+
+/**
+ * \brief Mounts a source, to be searched before any that were mounted earlier. Loose files are searched after
+ * every mounted source.
+ */
+SGE_RESOURCE_API void mount_resource_source(std::shared_ptr<const ResourceSource> source);
+
+/**
+ * \brief Unmounts every mounted source, leaving only loose files. Resources that are still open stay valid.
+ */
+SGE_RESOURCE_API void unmount_resource_sources();
+
+/**
+ * \brief Opens the resource at the given path from the first mounted source that has it, falling back to
+ * loose files. This may be called from any thread.
+ * \param path The path of the resource.
+ * \param sequential Whether the resource will be read front-to-back, as a hint to the OS.
+ * \param out_data Set to the contents of the resource.
+ * \return Whether the resource was found.
+ */
+SGE_RESOURCE_API bool open_resource(const char* path, bool sequential, ResourceData& out_data);
+}  // namespace sge
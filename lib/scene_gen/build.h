@@ -0,0 +1,9 @@
+#pragma once
+
+#include "lib/base/env.h"
+
+#if defined SGE_SCENE_GEN_BUILD
+#define SGE_SCENE_GEN_API SGE_EXPORT
+#else
+#define SGE_SCENE_GEN_API SGE_IMPORT
+#endif
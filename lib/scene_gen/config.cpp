@@ -0,0 +1,58 @@
+#include "lib/scene_gen/config.h"
+#include "lib/base/interfaces/from_archive.h"
+#include "lib/base/io/archive_reader.h"
+#include "lib/base/reflection/reflection_builder.h"
+
+SGE_REFLECT_TYPE(sge::scene_gen::Config).implements<IFromArchive>();
+
+namespace sge {
+namespace scene_gen {
+Config::Config()
+    : num_nodes(1000),
+      hierarchy_depth(1),
+      fan_out(4),
+      seed(1),
+      spacing(4.f),
+      ground(true),
+      static_mesh_ratio(1.f),
+      rigid_body_ratio(0.5f),
+      collider_ratio(0.5f),
+      animation_ratio(0.1f),
+      spot_light_ratio(0.01f),
+      mesh("Content/Meshes/Primitives/cube.smesh"),
+      material("Content/Materials/Misc/checkerboard.json"),
+      spawns_per_frame(0),
+      despawns_per_frame(0) {}
+
+bool Config::validate() const {
+  const float ratios[] = {
+      static_mesh_ratio, rigid_body_ratio, collider_ratio, animation_ratio, spot_light_ratio
+  };
+  for (const auto ratio : ratios) {
+    if (ratio < 0.f || ratio > 1.f) {
+      return false;
+    }
+  }
+
+  return hierarchy_depth != 0 && fan_out != 0 && spacing > 0.f;
+}
+
+void Config::from_archive(ArchiveReader& reader) {
+  reader.object_member("num_nodes", num_nodes);
+  reader.object_member("hierarchy_depth", hierarchy_depth);
+  reader.object_member("fan_out", fan_out);
+  reader.object_member("seed", seed);
+  reader.object_member("spacing", spacing);
+  reader.object_member("ground", ground);
+  reader.object_member("static_mesh_ratio", static_mesh_ratio);
+  reader.object_member("rigid_body_ratio", rigid_body_ratio);
+  reader.object_member("collider_ratio", collider_ratio);
+  reader.object_member("animation_ratio", animation_ratio);
+  reader.object_member("spot_light_ratio", spot_light_ratio);
+  reader.object_member("mesh", mesh);
+  reader.object_member("material", material);
+  reader.object_member("spawns_per_frame", spawns_per_frame);
+  reader.object_member("despawns_per_frame", despawns_per_frame);
+}
+}  // namespace scene_gen
+}  // namespace sge
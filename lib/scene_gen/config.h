@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include "lib/base/reflection/reflection.h"
+#include "lib/scene_gen/build.h"
+
+namespace sge {
+class ArchiveReader;
+
+namespace scene_gen {
+struct SGE_SCENE_GEN_API Config {
+  SGE_REFLECTED_TYPE;
+
+  Config();
+
+  bool validate() const;
+
+  void from_archive(ArchiveReader& reader);
+
+  /* Total number of nodes to generate (not including the ground). */
+  uint32_t num_nodes;
+
+  /* Number of levels in each generated hierarchy. A depth of 1 generates only root nodes. */
+  uint32_t hierarchy_depth;
+
+  /* Number of children each non-leaf node has. */
+  uint32_t fan_out;
+
+  /* Seed for the random number generator, so that generated scenes are reproducible. */
+  uint32_t seed;
+
+  /* Distance between hierarchy roots on the grid they're laid out on. */
+  float spacing;
+
+  /* Whether to generate a static ground collider under the scene. */
+  bool ground;
+
+  /* Fraction of nodes (in the range [0, 1]) which receive each component type.
+   * Rigid bodies are only placed on root nodes, and always come with a box collider. */
+  float static_mesh_ratio;
+  float rigid_body_ratio;
+  float collider_ratio;
+  float animation_ratio;
+  float spot_light_ratio;
+
+  /* Mesh and material used for generated static meshes. */
+  std::string mesh;
+  std::string material;
+
+  /* Number of root nodes spawned and despawned each frame by the churn system. */
+  uint32_t spawns_per_frame;
+  uint32_t despawns_per_frame;
+};
+}  // namespace scene_gen
+}  // namespace sge
@@ -0,0 +1,211 @@
+#include <math.h>
+#include <algorithm>
+
+#include "lib/engine/components/display/spot_light.h"
+#include "lib/engine/components/display/static_mesh.h"
+#include "lib/engine/components/gameplay/animation.h"
+#include "lib/engine/components/physics/box_collider.h"
+#include "lib/engine/components/physics/rigid_body.h"
+#include "lib/engine/scene.h"
+#include "lib/engine/update_pipeline.h"
+#include "lib/scene_gen/scene_gen.h"
+
+namespace sge {
+namespace scene_gen {
+/* Returns a random float in the range [0, 1). Unlike std::uniform_real_distribution, this produces the same
+ * sequence on every standard library, so generated scenes are identical across platforms. */
+static float random_unit(std::mt19937& rng) {
+  return (float)(rng() >> 8) * (1.f / 16777216.f);
+}
+
+/* Returns the number of nodes in a full hierarchy with the given depth and fan-out, saturating at 'max'. */
+static size_t hierarchy_size(uint32_t depth, uint32_t fan_out, size_t max) {
+  size_t total = 0;
+  size_t level_size = 1;
+  for (uint32_t i = 0; i < depth && total < max; ++i) {
+    total += level_size;
+    level_size *= fan_out;
+  }
+
+  return std::min(total, max);
+}
+
+/* Returns the position of the given root on the grid that hierarchy roots are laid out on. */
+static Vec3 grid_position(size_t index, size_t grid_size, float spacing) {
+  return Vec3{(float)(index % grid_size) * spacing, spacing, (float)(index / grid_size) * spacing};
+}
+
+static void add_components(
+    Scene& scene,
+    Node* const* nodes,
+    size_t num_nodes,
+    bool roots,
+    const Config& config,
+    std::mt19937& rng
+) {
+  auto* const static_mesh_component = scene.get_component_container(CStaticMesh::type_info);
+  auto* const rigid_body_component = scene.get_component_container(CRigidBody::type_info);
+  auto* const box_collider_component = scene.get_component_container(CBoxCollider::type_info);
+  auto* const animation_component = scene.get_component_container(CAnimation::type_info);
+  auto* const spot_light_component = scene.get_component_container(CSpotlight::type_info);
+
+  for (size_t i = 0; i < num_nodes; ++i) {
+    Node* const node = nodes[i];
+
+    // Roll for every component type, so that the sequence doesn't depend on which ones are present
+    const bool has_static_mesh = random_unit(rng) < config.static_mesh_ratio;
+    const bool has_rigid_body = random_unit(rng) < config.rigid_body_ratio && roots;
+    const bool has_collider = random_unit(rng) < config.collider_ratio || has_rigid_body;
+    const bool has_animation = random_unit(rng) < config.animation_ratio && !has_rigid_body;
+    const bool has_spot_light = random_unit(rng) < config.spot_light_ratio;
+
+    if (has_static_mesh) {
+      CStaticMesh* static_mesh;
+      static_mesh_component->create_instances(&node, 1, (void**)&static_mesh);
+      static_mesh->mesh(config.mesh);
+      static_mesh->material(config.material);
+    }
+
+    if (has_rigid_body) {
+      void* rigid_body;
+      rigid_body_component->create_instances(&node, 1, &rigid_body);
+    }
+
+    if (has_collider) {
+      void* collider;
+      box_collider_component->create_instances(&node, 1, &collider);
+    }
+
+    if (has_animation) {
+      const auto pos = node->get_pending_local_position();
+      CAnimation* animation;
+      animation_component->create_instances(&node, 1, (void**)&animation);
+      animation->duration(1.f + random_unit(rng) * 2.f);
+      animation->init_position(pos);
+      animation->target_position(pos + Vec3{0.f, config.spacing * 0.5f, 0.f});
+    }
+
+    if (has_spot_light) {
+      void* spot_light;
+      spot_light_component->create_instances(&node, 1, &spot_light);
+    }
+  }
+}
+
+void generate_scene(Scene& scene, const Config& config) {
+  std::mt19937 rng{config.seed};
+
+  if (config.ground) {
+    Node* ground;
+    scene.create_nodes(1, &ground);
+    ground->set_name("ground");
+
+    CBoxCollider* ground_collider;
+    auto* const box_collider_component = scene.get_component_container(CBoxCollider::type_info);
+    box_collider_component->create_instances(&ground, 1, (void**)&ground_collider);
+    ground_collider->shape(Vec3{10000.f, 1.f, 10000.f});
+  }
+
+  if (config.num_nodes == 0) {
+    return;
+  }
+
+  std::vector<Node*> nodes(config.num_nodes, nullptr);
+  scene.create_nodes(nodes.size(), nodes.data());
+
+  // Lay out hierarchy roots on a square grid
+  const auto tree_size = hierarchy_size(config.hierarchy_depth, config.fan_out, nodes.size());
+  const auto num_trees = (nodes.size() + tree_size - 1) / tree_size;
+  const auto grid_size = (size_t)ceilf(sqrtf((float)num_trees));
+
+  std::vector<Node*> roots;
+  std::vector<Node*> children;
+  std::vector<Node*> level;
+  std::vector<Node*> next_level;
+  roots.reserve(num_trees);
+  children.reserve(nodes.size() - num_trees);
+
+  size_t next = 0;
+  while (next < nodes.size()) {
+    Node* const root = nodes[next];
+    root->set_local_position(grid_position(roots.size(), grid_size, config.spacing));
+    roots.push_back(root);
+    next += 1;
+
+    // Fill in each level of the hierarchy breadth-first, until we run out of nodes
+    level.assign(1, root);
+    for (uint32_t depth = 1; depth < config.hierarchy_depth && next < nodes.size(); ++depth) {
+      next_level.clear();
+      for (Node* const parent : level) {
+        for (uint32_t child_i = 0; child_i < config.fan_out && next < nodes.size(); ++child_i) {
+          // Arrange children in a ring around their parent, shrinking with depth
+          Node* const child = nodes[next];
+          const float angle = 6.2831853f * (float)child_i / (float)config.fan_out;
+          const float radius = config.spacing * 0.5f / (float)depth;
+          parent->add_child(*child);
+          child->set_local_position(Vec3{cosf(angle) * radius, 0.f, sinf(angle) * radius});
+          next_level.push_back(child);
+          children.push_back(child);
+          next += 1;
+        }
+      }
+
+      level.swap(next_level);
+    }
+  }
+
+  add_components(scene, roots.data(), roots.size(), true, config, rng);
+  add_components(scene, children.data(), children.size(), false, config, rng);
+}
+
+ChurnSystem::ChurnSystem(const Config& config) : _config(config), _rng(config.seed) {}
+
+void ChurnSystem::register_pipeline(UpdatePipeline& pipeline) {
+  pipeline.register_system_fn("scene_gen_churn", this, &ChurnSystem::churn);
+}
+
+void ChurnSystem::churn(Scene& scene, SystemFrame& /*frame*/) {
+  // The first time through, every existing root node (other than the ground) may be despawned
+  if (!_initialized_candidates) {
+    for (const auto& node : scene.get_raw_scene_data().nodes) {
+      if (node.second->get_root().is_null() && node.second->get_name() != "ground") {
+        _despawn_candidates.push_back(node.first);
+      }
+    }
+    _initialized_candidates = true;
+  }
+
+  // Despawn random root nodes (along with their hierarchies)
+  for (uint32_t i = 0; i < _config.despawns_per_frame && !_despawn_candidates.empty(); ++i) {
+    const auto index = _rng() % _despawn_candidates.size();
+    const auto node_id = _despawn_candidates[index];
+    _despawn_candidates[index] = _despawn_candidates.back();
+    _despawn_candidates.pop_back();
+
+    Node* node;
+    scene.get_nodes(&node_id, 1, &node);
+    if (node) {
+      scene.destroy_nodes(1, &node);
+    }
+  }
+
+  // Spawn new root nodes at random positions within the grid
+  if (_config.spawns_per_frame == 0) {
+    return;
+  }
+
+  _spawned_nodes.assign(_config.spawns_per_frame, nullptr);
+  scene.create_nodes(_spawned_nodes.size(), _spawned_nodes.data());
+
+  const float extent = sqrtf((float)_config.num_nodes) * _config.spacing;
+  for (Node* const node : _spawned_nodes) {
+    node->set_local_position(Vec3{random_unit(_rng) * extent, _config.spacing, random_unit(_rng) * extent});
+  }
+
+  add_components(scene, _spawned_nodes.data(), _spawned_nodes.size(), true, _config, _rng);
+  for (const Node* const node : _spawned_nodes) {
+    _despawn_candidates.push_back(node->get_id());
+  }
+}
+}  // namespace scene_gen
+}  // namespace sge
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <random>
+#include <vector>
+
+#include "lib/engine/node.h"
+#include "lib/scene_gen/config.h"
+
+namespace sge {
+struct Scene;
+struct SystemFrame;
+struct UpdatePipeline;
+
+namespace scene_gen {
+/**
+ * \brief Populates the given scene with synthetic nodes and components, as described by the config.
+ * Nodes are created through the regular scene interface, so their state becomes current after the next
+ * system frame, at which point the scene may be serialized like any other.
+ * \param scene The scene to populate. Builtin components must already be registered.
+ * \param config The parameters for the generated scene.
+ */
+SGE_SCENE_GEN_API void generate_scene(Scene& scene, const Config& config);
+
+/**
+ * \brief System that spawns and despawns root nodes every frame, to exercise node creation and destruction.
+ */
+struct SGE_SCENE_GEN_API ChurnSystem {
+  explicit ChurnSystem(const Config& config);
+
+  void register_pipeline(UpdatePipeline& pipeline);
+
+ private:
+  void churn(Scene& scene, SystemFrame& frame);
+
+  Config _config;
+  std::mt19937 _rng;
+  bool _initialized_candidates = false;
+  std::vector<NodeId> _despawn_candidates;
+  std::vector<Node*> _spawned_nodes;
+};
+}  // namespace scene_gen
+}  // namespace sge